@@ -40,6 +40,13 @@ set(VKB_SYMLINKS OFF CACHE BOOL "Enable create symlink folders for every applica
 set(VKB_VALIDATION_LAYERS OFF CACHE BOOL "Enable validation layers for every application.")
 set(VKB_BUILD_SAMPLES ON CACHE BOOL "Enable generation and building of Vulkan best practice samples.")
 set(VKB_BUILD_TESTS OFF CACHE BOOL "Enable generation and building of Vulkan best practice tests.")
+set(VKB_BUILD_TOOLS ON CACHE BOOL "Enable generation and building of the desktop tools processing the output of the samples.")
+set(VKB_SYSTEM_TEST_ICD "" CACHE FILEPATH "Vulkan ICD manifest used by the system tests, such as the one of a software implementation, empty for the system default.")
+set(VKB_SYSTEM_TEST_FRAMES 60 CACHE STRING "Number of frames rendered by each system test before its screenshot is taken.")
+set(VKB_SYSTEM_TEST_BASELINES "${CMAKE_BINARY_DIR}/system_test_baselines" CACHE PATH "Directory of the performance baselines of the system tests.")
+set(VKB_SYSTEM_TEST_RECORD_BASELINES OFF CACHE BOOL "Record the performance baselines of the system tests instead of checking them.")
+set(VKB_ASYNC_LOGGING ON CACHE BOOL "Enable writing log messages from a background thread.")
+set(VKB_LOG_LEVEL "" CACHE STRING "Lowest log level compiled in (DEBUG, INFO, WARN, ERROR or OFF), empty for the default of the build type.")
 
 set(CMAKE_RUNTIME_OUTPUT_DIRECTORY "bin/${CMAKE_BUILD_TYPE}/${TARGET_ARCH}")
 set(CMAKE_LIBRARY_OUTPUT_DIRECTORY "lib/${CMAKE_BUILD_TYPE}/${TARGET_ARCH}")
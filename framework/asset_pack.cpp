@@ -0,0 +1,230 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "asset_pack.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+#include "common/logging.h"
+
+namespace vkb
+{
+AssetPack::AssetPack(const std::string &path) :
+    path{path}
+{
+#if defined(_WIN32)
+	file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file_handle == INVALID_HANDLE_VALUE)
+	{
+		file_handle = nullptr;
+		throw std::runtime_error("Failed to open asset pack: " + path);
+	}
+
+	LARGE_INTEGER file_size;
+	GetFileSizeEx(file_handle, &file_size);
+	size = static_cast<uint64_t>(file_size.QuadPart);
+
+	if (size != 0)
+	{
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping_handle)
+		{
+			data = static_cast<const uint8_t *>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+		}
+	}
+#else
+	auto file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		throw std::runtime_error("Failed to open asset pack: " + path);
+	}
+
+	struct stat info;
+	if (fstat(file, &info) == 0 && info.st_size > 0)
+	{
+		size = static_cast<uint64_t>(info.st_size);
+
+		auto mapping = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_PRIVATE, file, 0);
+		if (mapping != MAP_FAILED)
+		{
+			data = static_cast<const uint8_t *>(mapping);
+		}
+	}
+
+	// The mapping keeps a reference to the file
+	close(file);
+#endif
+
+	if (!data)
+	{
+		unmap();
+		throw std::runtime_error("Failed to map asset pack: " + path);
+	}
+
+	// The index is validated once, so that reads only need to check the data they decompress
+	if (size < sizeof(pack::PackHeader))
+	{
+		unmap();
+		throw std::runtime_error("Invalid asset pack: " + path);
+	}
+
+	const auto &header = *reinterpret_cast<const pack::PackHeader *>(data);
+
+	auto index_size = sizeof(pack::PackHeader) + uint64_t{header.entry_count} * sizeof(pack::PackEntry);
+
+	bool valid = header.magic == pack::MAGIC &&
+	             header.version == pack::VERSION &&
+	             index_size + header.names_size <= size;
+
+	if (valid)
+	{
+		entries     = reinterpret_cast<const pack::PackEntry *>(data + sizeof(pack::PackHeader));
+		entry_count = header.entry_count;
+		names       = reinterpret_cast<const char *>(data + index_size);
+
+		for (uint32_t i = 0; i < entry_count && valid; ++i)
+		{
+			const auto &entry = entries[i];
+
+			valid = (i == 0 || entries[i - 1].hash < entry.hash) &&
+			        uint64_t{entry.name_offset} + entry.name_size <= header.names_size &&
+			        entry.offset <= size && entry.stored_size <= size - entry.offset &&
+			        (entry.compression == pack::LZ || (entry.compression == pack::None && entry.stored_size == entry.size));
+		}
+	}
+
+	if (!valid)
+	{
+		unmap();
+		throw std::runtime_error("Invalid asset pack: " + path);
+	}
+
+	LOGI("Mounted asset pack {} ({} files)", path, entry_count);
+}
+
+AssetPack::~AssetPack()
+{
+	unmap();
+}
+
+void AssetPack::unmap()
+{
+#if defined(_WIN32)
+	if (data)
+	{
+		UnmapViewOfFile(data);
+	}
+
+	if (mapping_handle)
+	{
+		CloseHandle(mapping_handle);
+	}
+
+	if (file_handle)
+	{
+		CloseHandle(file_handle);
+	}
+
+	mapping_handle = nullptr;
+	file_handle    = nullptr;
+#else
+	if (data)
+	{
+		munmap(const_cast<uint8_t *>(data), static_cast<size_t>(size));
+	}
+#endif
+
+	data = nullptr;
+}
+
+bool AssetPack::contains(const std::string &name) const
+{
+	return find(name) != nullptr;
+}
+
+bool AssetPack::read(const std::string &name, std::vector<uint8_t> &file_data, uint32_t count) const
+{
+	auto entry = find(name);
+
+	if (!entry)
+	{
+		return false;
+	}
+
+	auto read_count = count == 0 ? entry->size : std::min<uint64_t>(count, entry->size);
+
+	auto stored_data = data + entry->offset;
+
+	if (entry->compression == pack::None)
+	{
+		file_data.assign(stored_data, stored_data + read_count);
+
+		return true;
+	}
+
+	// Entries are compressed as a single block, partial reads decompress the whole file
+	file_data.resize(static_cast<size_t>(entry->size));
+
+	if (!pack::lz::decompress(stored_data, static_cast<size_t>(entry->stored_size), file_data.data(), file_data.size()))
+	{
+		throw std::runtime_error("Corrupt file " + name + " in asset pack: " + path);
+	}
+
+	file_data.resize(static_cast<size_t>(read_count));
+
+	return true;
+}
+
+const std::string &AssetPack::get_path() const
+{
+	return path;
+}
+
+size_t AssetPack::get_entry_count() const
+{
+	return entry_count;
+}
+
+const pack::PackEntry *AssetPack::find(const std::string &name) const
+{
+	auto hash = pack::hash_name(name);
+
+	auto end   = entries + entry_count;
+	auto entry = std::lower_bound(entries, end, hash, [](const pack::PackEntry &entry, uint64_t hash) { return entry.hash < hash; });
+
+	// Names are compared to reject files that are not in the pack but have the hash of one that is
+	if (entry == end || entry->hash != hash || name.compare(0, std::string::npos, names + entry->name_offset, entry->name_size) != 0)
+	{
+		return nullptr;
+	}
+
+	return entry;
+}
+}        // namespace vkb
@@ -0,0 +1,103 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "asset_pack_format.h"
+
+namespace vkb
+{
+/**
+ * @brief A read-only pack of files mapped in memory, see asset_pack_format.h
+ *
+ * Opening a pack costs one file open and one mapping, whatever the number of files it
+ * contains. Files are found by a binary search of the hashes of their names, and only
+ * the pages of the files that are read are loaded by the operating system.
+ *
+ * The pack is immutable once opened, so it can be read from several threads.
+ */
+class AssetPack
+{
+  public:
+	/**
+	 * @brief Maps a pack in memory
+	 * @param path The path to the pack
+	 * @throws runtime_error if the pack cannot be mapped or its index is invalid
+	 */
+	AssetPack(const std::string &path);
+
+	AssetPack(const AssetPack &) = delete;
+
+	AssetPack(AssetPack &&) = delete;
+
+	~AssetPack();
+
+	AssetPack &operator=(const AssetPack &) = delete;
+
+	AssetPack &operator=(AssetPack &&) = delete;
+
+	/**
+	 * @param name The name of a file, relative to the root of the application
+	 * @return Whether the pack contains the file
+	 */
+	bool contains(const std::string &name) const;
+
+	/**
+	 * @brief Copies a file of the pack, decompressing it if needed
+	 * @param name The name of a file, relative to the root of the application
+	 * @param data Filled with the content of the file
+	 * @param count How many bytes to read, 0 for the whole file
+	 * @return False if the pack does not contain the file
+	 * @throws runtime_error if the data of the file is corrupt
+	 */
+	bool read(const std::string &name, std::vector<uint8_t> &data, uint32_t count = 0) const;
+
+	const std::string &get_path() const;
+
+	size_t get_entry_count() const;
+
+  private:
+	const pack::PackEntry *find(const std::string &name) const;
+
+	void unmap();
+
+	std::string path;
+
+	const uint8_t *data{nullptr};
+
+	uint64_t size{0};
+
+	const pack::PackEntry *entries{nullptr};
+
+	uint32_t entry_count{0};
+
+	const char *names{nullptr};
+
+#if defined(_WIN32)
+	void *file_handle{nullptr};
+
+	void *mapping_handle{nullptr};
+#endif
+};
+}        // namespace vkb
@@ -0,0 +1,309 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief Layout of the asset packs read by AssetPack and written by the asset_packer tool
+ *
+ * This header has no dependency on the rest of the framework, so that the packer tool
+ * can build packs without linking it. Values are stored in little endian byte order.
+ *
+ * A pack is made of:
+ * - a PackHeader
+ * - a PackEntry for each file, sorted by the hash of their names
+ * - the names of the files, not null terminated
+ * - the data of each file, starting at a multiple of ALIGNMENT
+ *
+ * Names are relative to the root of the application, such as "assets/fonts/Roboto-Regular.ttf"
+ * or "shaders/base.frag", with forward slashes.
+ */
+namespace pack
+{
+/// "VKBP" read as a little endian integer
+constexpr uint32_t MAGIC = 0x50424B56;
+
+constexpr uint32_t VERSION = 1;
+
+/// Alignment of the data of the entries, so that each one starts at a page boundary
+constexpr uint64_t ALIGNMENT = 4096;
+
+enum Compression : uint32_t
+{
+	None,
+	LZ
+};
+
+#pragma pack(push, 1)
+
+struct PackHeader
+{
+	uint32_t magic{MAGIC};
+
+	uint32_t version{VERSION};
+
+	uint32_t entry_count{0};
+
+	/// Size of the names that follow the entries in bytes
+	uint32_t names_size{0};
+};
+
+struct PackEntry
+{
+	/// Hash of the name, as given by hash_name()
+	uint64_t hash{0};
+
+	/// Offset of the data from the start of the pack
+	uint64_t offset{0};
+
+	/// Size of the file once decompressed
+	uint64_t size{0};
+
+	/// Size of the data in the pack
+	uint64_t stored_size{0};
+
+	/// Offset of the name from the start of the names
+	uint32_t name_offset{0};
+
+	uint32_t name_size{0};
+
+	Compression compression{None};
+
+	uint32_t reserved{0};
+};
+
+#pragma pack(pop)
+
+/**
+ * @brief 64-bit FNV-1a hash of the name of an entry
+ */
+inline uint64_t hash_name(const std::string &name)
+{
+	uint64_t hash = 0xcbf29ce484222325;
+
+	for (auto c : name)
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 0x100000001b3;
+	}
+
+	return hash;
+}
+
+inline uint64_t align_offset(uint64_t offset)
+{
+	return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+/**
+ * @brief Byte-oriented LZ77 codec of the entries, fast to decode and without dependency
+ *
+ * The compressed data is a list of sequences. A sequence starts with a token, whose high
+ * nibble is the number of literals and low nibble the length of the match minus MIN_MATCH.
+ * A nibble of 15 is followed by bytes added to it, until a byte is not 255. The literals
+ * follow, then the distance of the match as two bytes. The last sequence has no match.
+ */
+namespace lz
+{
+constexpr size_t MIN_MATCH = 4;
+
+constexpr size_t MAX_DISTANCE = 65535;
+
+constexpr uint32_t HASH_BITS = 16;
+
+inline void write_length(std::vector<uint8_t> &output, size_t length)
+{
+	for (; length >= 255; length -= 255)
+	{
+		output.push_back(255);
+	}
+
+	output.push_back(static_cast<uint8_t>(length));
+}
+
+inline void write_sequence(std::vector<uint8_t> &output, const uint8_t *literals, size_t literal_count, size_t match_length, size_t distance)
+{
+	auto literal_nibble = literal_count < 15 ? literal_count : 15;
+	auto match_nibble   = match_length == 0 ? 0 : (match_length - MIN_MATCH < 15 ? match_length - MIN_MATCH : 15);
+
+	output.push_back(static_cast<uint8_t>((literal_nibble << 4) | match_nibble));
+
+	if (literal_nibble == 15)
+	{
+		write_length(output, literal_count - 15);
+	}
+
+	output.insert(output.end(), literals, literals + literal_count);
+
+	if (match_length == 0)
+	{
+		return;
+	}
+
+	output.push_back(static_cast<uint8_t>(distance & 0xff));
+	output.push_back(static_cast<uint8_t>(distance >> 8));
+
+	if (match_nibble == 15)
+	{
+		write_length(output, match_length - MIN_MATCH - 15);
+	}
+}
+
+/**
+ * @brief Compresses data with a greedy search of the last position of each 4-byte sequence
+ */
+inline std::vector<uint8_t> compress(const uint8_t *data, size_t size)
+{
+	std::vector<uint8_t> output;
+	output.reserve(size / 2 + 16);
+
+	// Positions plus one of the sequences, zero is an empty slot
+	std::vector<size_t> positions(size_t{1} << HASH_BITS, 0);
+
+	size_t literal_start = 0;
+	size_t position      = 0;
+
+	while (position + MIN_MATCH <= size)
+	{
+		uint32_t sequence;
+		std::memcpy(&sequence, data + position, sizeof(sequence));
+
+		auto &slot      = positions[(sequence * 2654435761u) >> (32 - HASH_BITS)];
+		auto  candidate = slot;
+		slot            = position + 1;
+
+		if (candidate == 0 || position + 1 - candidate > MAX_DISTANCE || std::memcmp(data + candidate - 1, data + position, MIN_MATCH) != 0)
+		{
+			++position;
+			continue;
+		}
+
+		auto match_start  = candidate - 1;
+		auto match_length = MIN_MATCH;
+
+		while (position + match_length < size && data[match_start + match_length] == data[position + match_length])
+		{
+			++match_length;
+		}
+
+		write_sequence(output, data + literal_start, position - literal_start, match_length, position - match_start);
+
+		position += match_length;
+		literal_start = position;
+	}
+
+	write_sequence(output, data + literal_start, size - literal_start, 0, 0);
+
+	return output;
+}
+
+inline bool read_length(const uint8_t *&input, const uint8_t *end, size_t &length)
+{
+	uint8_t byte;
+
+	do
+	{
+		if (input == end)
+		{
+			return false;
+		}
+
+		byte = *input++;
+		length += byte;
+	} while (byte == 255);
+
+	return true;
+}
+
+/**
+ * @brief Decompresses data, checking every read and write against the size of the buffers
+ * @return False if the data is corrupt or does not decompress to exactly output_size bytes
+ */
+inline bool decompress(const uint8_t *input, size_t input_size, uint8_t *output, size_t output_size)
+{
+	auto input_end = input + input_size;
+
+	size_t written = 0;
+
+	while (input < input_end)
+	{
+		auto token = *input++;
+
+		size_t literal_count = token >> 4;
+		if (literal_count == 15 && !read_length(input, input_end, literal_count))
+		{
+			return false;
+		}
+
+		if (literal_count > static_cast<size_t>(input_end - input) || literal_count > output_size - written)
+		{
+			return false;
+		}
+
+		std::copy(input, input + literal_count, output + written);
+		input += literal_count;
+		written += literal_count;
+
+		// The last sequence has no match
+		if (input == input_end)
+		{
+			break;
+		}
+
+		if (input_end - input < 2)
+		{
+			return false;
+		}
+
+		size_t distance = input[0] | (input[1] << 8);
+		input += 2;
+
+		size_t match_length = token & 0xf;
+		if (match_length == 15 && !read_length(input, input_end, match_length))
+		{
+			return false;
+		}
+		match_length += MIN_MATCH;
+
+		if (distance == 0 || distance > written || match_length > output_size - written)
+		{
+			return false;
+		}
+
+		// Matches can overlap the bytes they produce, so they are copied one byte at a time
+		for (auto source = output + written - distance, end = source + match_length; source != end; ++source)
+		{
+			output[written++] = *source;
+		}
+	}
+
+	return written == output_size;
+}
+}        // namespace lz
+}        // namespace pack
+}        // namespace vkb
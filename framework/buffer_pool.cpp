@@ -20,6 +20,7 @@
 
 #include "buffer_pool.h"
 
+#include <algorithm>
 #include <cstddef>
 
 #include "common/error.h"
@@ -125,10 +126,23 @@ void BufferPool::reset()
 	active_buffer_block_count = 0;
 }
 
-BufferAllocation::BufferAllocation(core::Buffer &buffer, VkDeviceSize size, VkDeviceSize offset) :
+VkDeviceSize BufferPool::get_memory_size() const
+{
+	VkDeviceSize memory_size = 0;
+
+	for (auto &buffer_block : buffer_blocks)
+	{
+		memory_size += buffer_block.get_size();
+	}
+
+	return memory_size;
+}
+
+BufferAllocation::BufferAllocation(core::Buffer &buffer, VkDeviceSize size, VkDeviceSize offset, uint8_t *mapped_data) :
     buffer{&buffer},
     size{size},
-    base_offset{offset}
+    base_offset{offset},
+    mapped_data{mapped_data}
 {
 }
 
@@ -138,7 +152,16 @@ void BufferAllocation::update(const std::vector<uint8_t> &data, uint32_t offset)
 
 	if (offset + data.size() <= size)
 	{
-		buffer->update(data, static_cast<size_t>(base_offset) + offset);
+		if (mapped_data)
+		{
+			// Never map or unmap a shared buffer, other threads may be writing to it
+			std::copy(data.begin(), data.end(), mapped_data + base_offset + offset);
+			buffer->flush(base_offset + offset, data.size());
+		}
+		else
+		{
+			buffer->update(data, static_cast<size_t>(base_offset) + offset);
+		}
 	}
 	else
 	{
@@ -36,7 +36,14 @@ class BufferAllocation
   public:
 	BufferAllocation() = default;
 
-	BufferAllocation(core::Buffer &buffer, VkDeviceSize size, VkDeviceSize offset);
+	/**
+	 * @param buffer The buffer the allocation comes from
+	 * @param size Size of the allocation
+	 * @param offset Offset of the allocation in the buffer
+	 * @param mapped_data Persistently mapped memory of the buffer, updates are written to it
+	 *        directly instead of mapping the buffer, so allocations can be updated concurrently
+	 */
+	BufferAllocation(core::Buffer &buffer, VkDeviceSize size, VkDeviceSize offset, uint8_t *mapped_data = nullptr);
 
 	BufferAllocation(const BufferAllocation &) = delete;
 
@@ -70,6 +77,8 @@ class BufferAllocation
 	VkDeviceSize base_offset{0};
 
 	VkDeviceSize size{0};
+
+	uint8_t *mapped_data{nullptr};
 };
 
 /**
@@ -124,6 +133,11 @@ class BufferPool
 
 	void reset();
 
+	/**
+	 * @return The total size of the blocks owned by the pool
+	 */
+	VkDeviceSize get_memory_size() const;
+
   private:
 	Device &device;
 
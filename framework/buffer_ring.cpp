@@ -0,0 +1,175 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "buffer_ring.h"
+
+#include "common/error.h"
+#include "common/logging.h"
+#include "core/device.h"
+
+namespace vkb
+{
+namespace
+{
+// Upper bound of every offset alignment limit in the Vulkan specification,
+// chunks start at multiples of it so that any allocation can be aligned within them
+constexpr VkDeviceSize MAX_OFFSET_ALIGNMENT = 256;
+
+inline VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+}        // namespace
+
+BufferRing::BufferRing(Device &device, VkDeviceSize size, size_t thread_count, VkDeviceSize chunk_size) :
+    buffer{device,
+           align_up(size, MAX_OFFSET_ALIGNMENT),
+           VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+           VMA_MEMORY_USAGE_CPU_TO_GPU},
+    chunk_size{align_up(chunk_size, MAX_OFFSET_ALIGNMENT)},
+    uniform_alignment{device.get_properties().limits.minUniformBufferOffsetAlignment},
+    storage_alignment{device.get_properties().limits.minStorageBufferOffsetAlignment},
+    chunks(thread_count)
+{
+	assert(thread_count > 0 && "Thread count must be greater than zero");
+
+	mapped_data = buffer.map();
+}
+
+BufferRing::~BufferRing()
+{
+	LOGI("Buffer ring peak usage: {} of {} bytes", peak_used_size, buffer.get_size());
+}
+
+BufferAllocation BufferRing::allocate(const VkBufferUsageFlags usage, const VkDeviceSize size, size_t thread_index)
+{
+	assert(size > 0 && "Allocation size must be greater than zero");
+	assert(thread_index < chunks.size() && "Thread index is out of bounds");
+
+	auto &chunk = chunks[thread_index];
+
+	auto aligned_offset = align_up(chunk.offset, get_alignment(usage));
+
+	if (aligned_offset + size > chunk.end)
+	{
+		// The chunk of this thread is exhausted, reserve a new one that fits the allocation
+		if (!reserve(std::max(chunk_size, align_up(size, MAX_OFFSET_ALIGNMENT)), chunk))
+		{
+			LOGE("Buffer ring is full, cannot allocate {} bytes", size);
+			return BufferAllocation{};
+		}
+
+		aligned_offset = chunk.offset;
+	}
+
+	chunk.offset = aligned_offset + size;
+
+	return BufferAllocation{buffer, size, aligned_offset % buffer.get_size(), mapped_data};
+}
+
+VkDeviceSize BufferRing::end_frame()
+{
+	std::lock_guard<std::mutex> guard(ring_mutex);
+
+	// Force every thread to reserve a new chunk, so that chunks never span two frames
+	for (auto &chunk : chunks)
+	{
+		chunk = Chunk{};
+	}
+
+	return head;
+}
+
+void BufferRing::retire(const VkDeviceSize marker)
+{
+	std::lock_guard<std::mutex> guard(ring_mutex);
+
+	tail = std::max(tail, marker);
+}
+
+VkDeviceSize BufferRing::get_size() const
+{
+	return buffer.get_size();
+}
+
+VkDeviceSize BufferRing::get_used_size()
+{
+	std::lock_guard<std::mutex> guard(ring_mutex);
+
+	return head - tail;
+}
+
+VkDeviceSize BufferRing::get_peak_used_size() const
+{
+	return peak_used_size;
+}
+
+bool BufferRing::reserve(const VkDeviceSize size, Chunk &chunk)
+{
+	std::lock_guard<std::mutex> guard(ring_mutex);
+
+	const auto ring_size = buffer.get_size();
+
+	if (size > ring_size)
+	{
+		return false;
+	}
+
+	auto begin = align_up(head, MAX_OFFSET_ALIGNMENT);
+
+	// A chunk cannot wrap around, skip the remaining bytes at the end of the buffer
+	auto physical_offset = begin % ring_size;
+	if (physical_offset + size > ring_size)
+	{
+		begin += ring_size - physical_offset;
+	}
+
+	// Check that the range does not overlap memory still in use by the GPU
+	if (begin + size - tail > ring_size)
+	{
+		return false;
+	}
+
+	chunk.begin  = begin;
+	chunk.offset = begin;
+	chunk.end    = begin + size;
+
+	head = chunk.end;
+
+	peak_used_size = std::max(peak_used_size, head - tail);
+
+	return true;
+}
+
+VkDeviceSize BufferRing::get_alignment(const VkBufferUsageFlags usage) const
+{
+	if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+	{
+		return uniform_alignment;
+	}
+	else if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+	{
+		return storage_alignment;
+	}
+
+	// Vertex and index data, a power of two large enough for any index type or vertex attribute
+	return 16;
+}
+}        // namespace vkb
@@ -0,0 +1,149 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "buffer_pool.h"
+#include "common/helpers.h"
+#include "core/buffer.h"
+
+namespace vkb
+{
+class Device;
+
+/**
+ * @brief A single persistently mapped buffer shared by all the frames of a RenderContext,
+ *        used for transient uniform, vertex, index and storage data.
+ *
+ * Each thread reserves a chunk from the head of the ring and bump-allocates from it.
+ * Offsets grow monotonically and are wrapped around the size of the buffer, so a frame
+ * can be described by the offset the head had when it ended (its marker). When a frame
+ * is waited on, every allocation before its marker is retired and the tail moves forward.
+ *
+ * Compared to per-frame BufferPool objects, the memory is sized for the frames actually
+ * in flight instead of frames x usages x threads x block size.
+ */
+class BufferRing
+{
+  public:
+	/**
+	 * @brief Default size of the chunks reserved by each thread in kilobytes
+	 */
+	static constexpr uint32_t CHUNK_SIZE = 64;
+
+	/**
+	 * @param device A valid device
+	 * @param size Size of the ring in bytes
+	 * @param thread_count Number of threads that can allocate concurrently
+	 * @param chunk_size Size of the chunks reserved by each thread in bytes
+	 */
+	BufferRing(Device &device, VkDeviceSize size, size_t thread_count = 1, VkDeviceSize chunk_size = CHUNK_SIZE * 1024);
+
+	BufferRing(const BufferRing &) = delete;
+
+	BufferRing(BufferRing &&) = delete;
+
+	~BufferRing();
+
+	BufferRing &operator=(const BufferRing &) = delete;
+
+	BufferRing &operator=(BufferRing &&) = delete;
+
+	/**
+	 * @param usage Usage of the allocation, it determines its alignment
+	 * @param size Amount of memory required
+	 * @param thread_index Index of the chunk to be used by the current thread
+	 * @return The requested allocation, empty if the ring is full
+	 */
+	BufferAllocation allocate(VkBufferUsageFlags usage, VkDeviceSize size, size_t thread_index = 0);
+
+	/**
+	 * @brief Closes the chunks of all threads, so that the next allocations belong to a new frame
+	 * @return The marker of the frame that has just been recorded
+	 */
+	VkDeviceSize end_frame();
+
+	/**
+	 * @brief Releases every allocation made before a frame marker
+	 * @param marker The marker returned by end_frame() for a frame whose execution completed
+	 */
+	void retire(VkDeviceSize marker);
+
+	VkDeviceSize get_size() const;
+
+	/**
+	 * @return The number of bytes currently in flight
+	 */
+	VkDeviceSize get_used_size();
+
+	/**
+	 * @return The largest number of bytes that were in flight at the same time
+	 */
+	VkDeviceSize get_peak_used_size() const;
+
+  private:
+	/**
+	 * @brief Range of the ring owned by a thread
+	 */
+	struct Chunk
+	{
+		VkDeviceSize begin{0};
+
+		VkDeviceSize offset{0};
+
+		VkDeviceSize end{0};
+	};
+
+	/**
+	 * @brief Moves the head forward to reserve a contiguous range of the buffer
+	 * @param size Size of the range
+	 * @param chunk Chunk to be updated with the new range
+	 * @return Whether there was enough free space in the ring
+	 */
+	bool reserve(VkDeviceSize size, Chunk &chunk);
+
+	VkDeviceSize get_alignment(VkBufferUsageFlags usage) const;
+
+	core::Buffer buffer;
+
+	/// Mapped once for the lifetime of the ring, allocations write to it directly
+	uint8_t *mapped_data{nullptr};
+
+	VkDeviceSize chunk_size{0};
+
+	VkDeviceSize uniform_alignment{0};
+
+	VkDeviceSize storage_alignment{0};
+
+	/// Monotonic offset of the next free byte
+	VkDeviceSize head{0};
+
+	/// Monotonic offset of the oldest byte still in use by the GPU
+	VkDeviceSize tail{0};
+
+	VkDeviceSize peak_used_size{0};
+
+	std::vector<Chunk> chunks;
+
+	std::mutex ring_mutex;
+};
+}        // namespace vkb
@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
@@ -28,7 +32,126 @@
 
 #define __FILENAME__ (static_cast<const char *>(__FILE__) + ROOT_PATH_SIZE)
 
-#define LOGI(...) spdlog::info(__VA_ARGS__);
-#define LOGW(...) spdlog::warn(__VA_ARGS__);
-#define LOGE(...) spdlog::error("[{}:{}] {}", __FILENAME__, __LINE__, fmt::format(__VA_ARGS__));
-#define LOGD(...) spdlog::debug(__VA_ARGS__);
+// Compile-time log levels, messages below VKB_LOG_LEVEL are removed
+// together with the evaluation of their arguments
+#define VKB_LOG_LEVEL_DEBUG 0
+#define VKB_LOG_LEVEL_INFO 1
+#define VKB_LOG_LEVEL_WARN 2
+#define VKB_LOG_LEVEL_ERROR 3
+#define VKB_LOG_LEVEL_OFF 4
+
+#ifndef VKB_LOG_LEVEL
+#	if !defined(NDEBUG) || defined(DEBUG) || defined(_DEBUG)
+#		define VKB_LOG_LEVEL VKB_LOG_LEVEL_DEBUG
+#	else
+#		define VKB_LOG_LEVEL VKB_LOG_LEVEL_INFO
+#	endif
+#endif
+
+#if VKB_LOG_LEVEL <= VKB_LOG_LEVEL_INFO
+#	define LOGI(...) spdlog::info(__VA_ARGS__);
+#else
+#	define LOGI(...) (void) 0;
+#endif
+
+#if VKB_LOG_LEVEL <= VKB_LOG_LEVEL_WARN
+#	define LOGW(...) spdlog::warn(__VA_ARGS__);
+#else
+#	define LOGW(...) (void) 0;
+#endif
+
+#if VKB_LOG_LEVEL <= VKB_LOG_LEVEL_ERROR
+#	define LOGE(...) vkb::logging::error(__FILENAME__, __LINE__, __VA_ARGS__);
+#else
+#	define LOGE(...) (void) 0;
+#endif
+
+#if VKB_LOG_LEVEL <= VKB_LOG_LEVEL_DEBUG
+#	define LOGD(...) spdlog::debug(__VA_ARGS__);
+#else
+#	define LOGD(...) (void) 0;
+#endif
+
+/**
+ * @brief Logs a warning at most once per interval (in milliseconds) for each call site,
+ *        useful for warnings that can be raised every frame or every draw call
+ */
+#define LOGW_RATE_LIMITED(interval_ms, ...)                                                                  \
+	do                                                                                                       \
+	{                                                                                                        \
+		static vkb::logging::RateLimit rate_limit{std::chrono::milliseconds(interval_ms)};                   \
+		uint32_t                       suppressed_count = 0;                                                 \
+		if (rate_limit.allow(suppressed_count))                                                              \
+		{                                                                                                    \
+			LOGW(__VA_ARGS__);                                                                               \
+			if (suppressed_count > 0)                                                                        \
+			{                                                                                                \
+				LOGW("Previous warning was suppressed {} times since it was last logged", suppressed_count); \
+			}                                                                                                \
+		}                                                                                                    \
+	} while (0)
+
+namespace vkb
+{
+namespace logging
+{
+/**
+ * @brief Formats the location and the message of an error into a single buffer,
+ *        which is then passed to the logger without being formatted again
+ */
+template <typename... Args>
+inline void error(const char *file, int line, const char *format, const Args &... args)
+{
+	auto logger = spdlog::default_logger_raw();
+	if (!logger->should_log(spdlog::level::err))
+	{
+		return;
+	}
+
+	fmt::memory_buffer buffer;
+	fmt::format_to(buffer, "[{}:{}] ", file, line);
+	fmt::format_to(buffer, format, args...);
+
+	logger->log(spdlog::level::err, fmt::string_view(buffer.data(), buffer.size()));
+}
+
+/**
+ * @brief Thread-safe state of a rate limited call site, see LOGW_RATE_LIMITED
+ */
+class RateLimit
+{
+  public:
+	using Clock = std::chrono::steady_clock;
+
+	explicit RateLimit(std::chrono::milliseconds interval) :
+	    interval{std::chrono::duration_cast<Clock::duration>(interval).count()}
+	{}
+
+	/**
+	 * @param suppressed_count Set to the number of calls rejected since the last allowed one
+	 * @return Whether the message should be logged now
+	 */
+	bool allow(uint32_t &suppressed_count)
+	{
+		const auto now  = Clock::now().time_since_epoch().count();
+		auto       next = next_time.load(std::memory_order_relaxed);
+
+		if (now < next || !next_time.compare_exchange_strong(next, now + interval, std::memory_order_relaxed))
+		{
+			suppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		suppressed_count = suppressed.exchange(0, std::memory_order_relaxed);
+		return true;
+	}
+
+  private:
+	const Clock::rep interval;
+
+	std::atomic<Clock::rep> next_time{0};
+
+	std::atomic<uint32_t> suppressed{0};
+};
+}        // namespace logging
+}        // namespace vkb
@@ -0,0 +1,120 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace vkb
+{
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread
+ *
+ * Slots are allocated once at construction and reused, so that neither side allocates
+ * or blocks once the queue is running. When the queue is full, push() fails and the
+ * element is left to the producer, which decides whether to drop it.
+ */
+template <typename T>
+class SpscQueue
+{
+  public:
+	/**
+	 * @param capacity Number of slots, rounded up to a power of two
+	 */
+	explicit SpscQueue(size_t capacity)
+	{
+		size_t size = 2;
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+
+		slots.resize(size);
+		mask = size - 1;
+	}
+
+	SpscQueue(const SpscQueue &) = delete;
+
+	SpscQueue(SpscQueue &&) = delete;
+
+	SpscQueue &operator=(const SpscQueue &) = delete;
+
+	SpscQueue &operator=(SpscQueue &&) = delete;
+
+	/**
+	 * @brief Copies an element into the next free slot, only called by the producer
+	 * @return False if the queue is full
+	 */
+	bool push(const T &value)
+	{
+		const auto write = write_index.load(std::memory_order_relaxed);
+
+		if (write - read_index.load(std::memory_order_acquire) == slots.size())
+		{
+			return false;
+		}
+
+		slots[write & mask] = value;
+		write_index.store(write + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/**
+	 * @brief Takes the oldest element out of the queue, only called by the consumer
+	 *        The slot receives the previous content of value, so its storage is recycled by the producer
+	 * @return False if the queue is empty
+	 */
+	bool pop(T &value)
+	{
+		const auto read = read_index.load(std::memory_order_relaxed);
+
+		if (read == write_index.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		std::swap(value, slots[read & mask]);
+		read_index.store(read + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	size_t get_capacity() const
+	{
+		return slots.size();
+	}
+
+  private:
+	std::vector<T> slots;
+
+	size_t mask{0};
+
+	/// Monotonic index of the next slot to be written, owned by the producer
+	alignas(64) std::atomic<size_t> write_index{0};
+
+	/// Monotonic index of the next slot to be read, owned by the consumer
+	alignas(64) std::atomic<size_t> read_index{0};
+};
+}        // namespace vkb
@@ -20,6 +20,8 @@
 
 #include "vk_common.h"
 
+#include <stdexcept>
+
 std::ostream &operator<<(std::ostream &os, const VkResult result)
 {
 #define WRITE_VK_ENUM(r) \
@@ -77,6 +79,22 @@ bool is_depth_stencil_format(VkFormat format)
 	       is_depth_only_format(format);
 }
 
+VkFormat get_suitable_depth_format(VkPhysicalDevice physical_device, const std::vector<VkFormat> &depth_format_priority_list)
+{
+	for (auto &format : depth_format_priority_list)
+	{
+		VkFormatProperties properties;
+		vkGetPhysicalDeviceFormatProperties(physical_device, format, &properties);
+
+		if (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT)
+		{
+			return format;
+		}
+	}
+
+	throw std::runtime_error("No suitable depth format could be determined");
+}
+
 bool is_dynamic_buffer_descriptor_type(VkDescriptorType descriptor_type)
 {
 	return descriptor_type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC ||
@@ -25,6 +25,7 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <vk_mem_alloc.h>
 #include <volk.h>
@@ -51,6 +52,18 @@ bool is_depth_only_format(VkFormat format);
  */
 bool is_depth_stencil_format(VkFormat format);
 
+/**
+ * @brief Helper function to pick the first depth format the physical device can use as an optimal tiling attachment.
+ * @param physical_device Vulkan physical device to query.
+ * @param depth_format_priority_list Candidate depth formats, in order of preference.
+ * @return The first supported depth format.
+ */
+VkFormat get_suitable_depth_format(VkPhysicalDevice             physical_device,
+                                   const std::vector<VkFormat> &depth_format_priority_list = {
+                                       VK_FORMAT_D32_SFLOAT,
+                                       VK_FORMAT_D24_UNORM_S8_UINT,
+                                       VK_FORMAT_D16_UNORM});
+
 /**
  * @brief Helper function to determine if a Vulkan descriptor type is a dynamic storage buffer or dynamic uniform buffer.
  * @param descriptor_type Vulkan descriptor type to check.
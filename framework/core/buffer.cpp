@@ -28,7 +28,8 @@ namespace core
 {
 Buffer::Buffer(Device &device, VkDeviceSize size, VkBufferUsageFlags buffer_usage, VmaMemoryUsage memory_usage, VmaAllocationCreateFlags flags) :
     device{device},
-    size{size}
+    size{size},
+    usage{buffer_usage}
 {
 	assert(((flags & VMA_ALLOCATION_CREATE_MAPPED_BIT) == 0) && "Buffer memory should be mapped explicitly outside the constructor");
 
@@ -57,6 +58,7 @@ Buffer::Buffer(Buffer &&other) :
     handle{other.handle},
     memory{other.memory},
     size{other.size},
+    usage{other.usage},
     mapped_data{other.mapped_data},
     mapped{other.mapped}
 {
@@ -96,6 +98,40 @@ VkDeviceSize Buffer::get_size() const
 	return size;
 }
 
+VkBufferUsageFlags Buffer::get_usage() const
+{
+	return usage;
+}
+
+void Buffer::rebind()
+{
+	assert(handle != VK_NULL_HANDLE && memory != VK_NULL_HANDLE && "Buffer is not valid");
+
+	// The mapped pointer refers to the old location of the memory
+	bool was_mapped = mapped;
+	unmap();
+
+	vkDestroyBuffer(device.get_handle(), handle, nullptr);
+
+	VkBufferCreateInfo buffer_info{VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+	buffer_info.usage = usage;
+	buffer_info.size  = size;
+
+	auto result = vkCreateBuffer(device.get_handle(), &buffer_info, nullptr, &handle);
+
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Cannot recreate Buffer"};
+	}
+
+	VK_CHECK(vmaBindBufferMemory(device.get_memory_allocator(), memory, handle));
+
+	if (was_mapped)
+	{
+		map();
+	}
+}
+
 uint8_t *Buffer::map()
 {
 	if (!mapped_data)
@@ -116,9 +152,9 @@ void Buffer::unmap()
 	}
 }
 
-void Buffer::flush()
+void Buffer::flush(VkDeviceSize offset, VkDeviceSize size)
 {
-	vmaFlushAllocation(device.get_memory_allocator(), memory, 0, size);
+	vmaFlushAllocation(device.get_memory_allocator(), memory, offset, size);
 }
 
 void Buffer::update(const std::vector<uint8_t> &data, size_t offset)
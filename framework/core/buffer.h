@@ -50,6 +50,14 @@ class Buffer
 
 	VmaAllocation get_memory() const;
 
+	VkBufferUsageFlags get_usage() const;
+
+	/**
+	 * @brief Recreates the Vulkan buffer and binds it to its allocation,
+	 *        required after its memory has been moved by a defragmentation
+	 */
+	void rebind();
+
 	/**
 	 * @brief Maps vulkan memory to an host visible address
 	 * @return Pointer to host visible memory
@@ -63,8 +71,10 @@ class Buffer
 
 	/**
 	 * @brief Flushes memory if it is HOST_VISIBLE and not HOST_COHERENT
+	 * @param offset Offset of the range to flush
+	 * @param size Size of the range to flush, the whole buffer by default
 	 */
-	void flush();
+	void flush(VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE);
 
 	/**
 	 * @return The size of the buffer
@@ -100,6 +110,8 @@ class Buffer
 
 	VkDeviceSize size{0};
 
+	VkBufferUsageFlags usage{0};
+
 	uint8_t *mapped_data{nullptr};
 
 	/// Whether it has been mapped with vmaMapMemory
@@ -22,7 +22,9 @@
 
 #include "command_pool.h"
 #include "common/error.h"
+#include "descriptor_set.h"
 #include "device.h"
+#include "query_pool.h"
 #include "rendering/render_frame.h"
 
 namespace vkb
@@ -45,6 +47,13 @@ CommandBuffer::CommandBuffer(CommandPool &command_pool, VkCommandBufferLevel lev
 	}
 }
 
+CommandBuffer::CommandBuffer(CommandPool &command_pool, VkCommandBufferLevel level, VkCommandBuffer handle) :
+    command_pool{command_pool},
+    level{level},
+    handle{handle}
+{
+}
+
 CommandBuffer::~CommandBuffer()
 {
 	// Destroy command buffer
@@ -99,6 +108,7 @@ VkResult CommandBuffer::begin(VkCommandBufferUsageFlags flags, CommandBuffer *pr
 	pipeline_state.reset();
 	resource_binding_state.reset();
 	descriptor_set_layout_state.clear();
+	external_descriptor_sets.clear();
 	stored_push_constants.clear();
 
 	VkCommandBufferBeginInfo       begin_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
@@ -145,6 +155,7 @@ void CommandBuffer::begin_render_pass(const RenderTarget &render_target, const s
 	pipeline_state.reset();
 	resource_binding_state.reset();
 	descriptor_set_layout_state.clear();
+	external_descriptor_sets.clear();
 
 	// Create render pass
 	assert(subpasses.size() > 0 && "Cannot create a render pass without any subpass");
@@ -170,6 +181,11 @@ void CommandBuffer::begin_render_pass(const RenderTarget &render_target, const s
 
 	vkCmdBeginRenderPass(get_handle(), &begin_info, contents);
 
+	if (auto render_frame = command_pool.get_render_frame())
+	{
+		render_frame->add_attachment_bandwidth(current_render_pass.render_pass->estimate_bandwidth(begin_info.renderArea.extent));
+	}
+
 	// Update blend state attachments for first subpass
 	auto blend_state = pipeline_state.get_color_blend_state();
 	blend_state.attachments.resize(current_render_pass.render_pass->get_color_output_count(pipeline_state.get_subpass_index()));
@@ -189,6 +205,7 @@ void CommandBuffer::next_subpass()
 	// Reset descriptor sets
 	resource_binding_state.reset();
 	descriptor_set_layout_state.clear();
+	external_descriptor_sets.clear();
 
 	// Clear stored push constants
 	stored_push_constants.clear();
@@ -224,6 +241,11 @@ void CommandBuffer::set_specialization_constant(uint32_t constant_id, const std:
 	pipeline_state.set_specialization_constant(constant_id, data);
 }
 
+void CommandBuffer::clear_specialization_constants()
+{
+	pipeline_state.clear_specialization_constants();
+}
+
 void CommandBuffer::set_push_constants(const std::vector<uint8_t> &values)
 {
 	stored_push_constants.insert(stored_push_constants.end(), values.begin(), values.end());
@@ -244,7 +266,7 @@ void CommandBuffer::push_constants(uint32_t offset, const std::vector<uint8_t> &
 	}
 	else
 	{
-		LOGW("Push constant range [{}, {}] not found", offset, values.size());
+		LOGW_RATE_LIMITED(1000, "Push constant range [{}, {}] not found", offset, values.size());
 	}
 }
 
@@ -263,6 +285,30 @@ void CommandBuffer::bind_input(const core::ImageView &image_view, uint32_t set,
 	resource_binding_state.bind_input(image_view, set, binding, array_element);
 }
 
+void CommandBuffer::bind_descriptor_set(const DescriptorSet &descriptor_set, uint32_t set, VkPipelineBindPoint pipeline_bind_point)
+{
+	VkDescriptorSet  descriptor_set_handle  = descriptor_set.get_handle();
+	VkPipelineLayout pipeline_layout_handle = pipeline_state.get_pipeline_layout().get_handle();
+
+	// Binding a pipeline with a different layout can disturb previously bound sets, so only skip exact repeats
+	auto binding = std::make_pair(pipeline_layout_handle, descriptor_set_handle);
+
+	auto it = external_descriptor_sets.find(set);
+	if (it != external_descriptor_sets.end() && it->second == binding)
+	{
+		return;
+	}
+
+	external_descriptor_sets[set] = binding;
+
+	vkCmdBindDescriptorSets(get_handle(),
+	                        pipeline_bind_point,
+	                        pipeline_layout_handle,
+	                        set,
+	                        1, &descriptor_set_handle,
+	                        0, nullptr);
+}
+
 void CommandBuffer::bind_vertex_buffers(uint32_t first_binding, const std::vector<std::reference_wrapper<const vkb::core::Buffer>> &buffers, const std::vector<VkDeviceSize> &offsets)
 {
 	std::vector<VkBuffer> buffer_handles(buffers.size(), VK_NULL_HANDLE);
@@ -465,6 +511,21 @@ void CommandBuffer::buffer_memory_barrier(const core::Buffer &buffer, VkDeviceSi
 	    0, nullptr);
 }
 
+void CommandBuffer::reset_query_pool(const QueryPool &query_pool, uint32_t first_query, uint32_t query_count)
+{
+	vkCmdResetQueryPool(get_handle(), query_pool.get_handle(), first_query, query_count);
+}
+
+void CommandBuffer::begin_query(const QueryPool &query_pool, uint32_t query, VkQueryControlFlags flags)
+{
+	vkCmdBeginQuery(get_handle(), query_pool.get_handle(), query, flags);
+}
+
+void CommandBuffer::end_query(const QueryPool &query_pool, uint32_t query)
+{
+	vkCmdEndQuery(get_handle(), query_pool.get_handle(), query);
+}
+
 void CommandBuffer::flush_pipeline_state(VkPipelineBindPoint pipeline_bind_point)
 {
 	// Create a new pipeline only if the graphics state changed
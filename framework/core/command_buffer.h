@@ -41,6 +41,7 @@ class Framebuffer;
 class Pipeline;
 class PipelineLayout;
 class PipelineState;
+class QueryPool;
 class RenderTarget;
 
 /**
@@ -77,6 +78,14 @@ class CommandBuffer
 
 	CommandBuffer(CommandPool &command_pool, VkCommandBufferLevel level);
 
+	/**
+	 * @brief Wraps a command buffer already allocated from the command pool
+	 * @param command_pool The pool the handle was allocated from
+	 * @param level The level of the command buffer
+	 * @param handle A valid command buffer handle, freed by this object
+	 */
+	CommandBuffer(CommandPool &command_pool, VkCommandBufferLevel level, VkCommandBuffer handle);
+
 	CommandBuffer(const CommandBuffer &) = delete;
 
 	CommandBuffer(CommandBuffer &&other);
@@ -126,6 +135,8 @@ class CommandBuffer
 
 	void set_specialization_constant(uint32_t constant_id, const std::vector<uint8_t> &data);
 
+	void clear_specialization_constants();
+
 	/**
 	 * @brief Stores additional data which is prepended to the
 	 *        values passed to the push_constant() function
@@ -152,6 +163,16 @@ class CommandBuffer
 
 	void bind_input(const core::ImageView &image_view, uint32_t set, uint32_t binding, uint32_t array_element);
 
+	/**
+	 * @brief Binds a descriptor set which is not created from the bound resources, such as a set of bindless textures,
+	 *        using the current pipeline layout. Binding the same set again is skipped, so the following pipeline
+	 *        layouts must be compatible with the current one up to that set index.
+	 * @param descriptor_set The descriptor set to bind
+	 * @param set The set index, it must not be used by the resources bound with bind_buffer() and bind_image()
+	 * @param pipeline_bind_point The bind point of the pipelines using the set
+	 */
+	void bind_descriptor_set(const DescriptorSet &descriptor_set, uint32_t set, VkPipelineBindPoint pipeline_bind_point = VK_PIPELINE_BIND_POINT_GRAPHICS);
+
 	void bind_vertex_buffers(uint32_t first_binding, const std::vector<std::reference_wrapper<const vkb::core::Buffer>> &buffers, const std::vector<VkDeviceSize> &offsets);
 
 	void bind_index_buffer(const core::Buffer &buffer, VkDeviceSize offset, VkIndexType index_type);
@@ -206,6 +227,15 @@ class CommandBuffer
 
 	void buffer_memory_barrier(const core::Buffer &buffer, VkDeviceSize offset, VkDeviceSize size, const BufferMemoryBarrier &memory_barrier);
 
+	/**
+	 * @brief Resets a range of queries, it must be recorded outside of a render pass
+	 */
+	void reset_query_pool(const QueryPool &query_pool, uint32_t first_query, uint32_t query_count);
+
+	void begin_query(const QueryPool &query_pool, uint32_t query, VkQueryControlFlags flags);
+
+	void end_query(const QueryPool &query_pool, uint32_t query);
+
 	const State get_state() const;
 
 	/**
@@ -231,6 +261,9 @@ class CommandBuffer
 
 	std::unordered_map<uint32_t, DescriptorSetLayout *> descriptor_set_layout_state;
 
+	/// Pipeline layout and descriptor set bound to each set index with bind_descriptor_set()
+	std::unordered_map<uint32_t, std::pair<VkPipelineLayout, VkDescriptorSet>> external_descriptor_sets;
+
 	const RenderPassBinding &get_current_render_pass() const;
 
 	const uint32_t get_current_subpass_index() const;
@@ -20,6 +20,8 @@
 
 #include "command_pool.h"
 
+#include <array>
+
 #include "device.h"
 #include "rendering/render_frame.h"
 
@@ -79,7 +81,8 @@ CommandPool::CommandPool(CommandPool &&other) :
     active_secondary_command_buffer_count{other.active_secondary_command_buffer_count},
     render_frame{other.render_frame},
     thread_index{other.thread_index},
-    reset_mode{other.reset_mode}
+    reset_mode{other.reset_mode},
+    allocation_count{other.allocation_count}
 {
 	other.handle = VK_NULL_HANDLE;
 
@@ -119,6 +122,8 @@ VkResult CommandPool::reset_pool()
 {
 	VkResult result = VK_SUCCESS;
 
+	allocation_count = 0;
+
 	switch (reset_mode)
 	{
 		case CommandBuffer::ResetMode::ResetIndividually:
@@ -192,29 +197,52 @@ CommandBuffer &CommandPool::request_command_buffer(VkCommandBufferLevel level)
 {
 	if (level == VK_COMMAND_BUFFER_LEVEL_PRIMARY)
 	{
-		if (active_primary_command_buffer_count < primary_command_buffers.size())
+		if (active_primary_command_buffer_count == primary_command_buffers.size())
 		{
-			return *primary_command_buffers.at(active_primary_command_buffer_count++);
+			allocate_command_buffers(level, primary_command_buffers);
 		}
 
-		primary_command_buffers.emplace_back(std::make_unique<CommandBuffer>(*this, level));
-
-		active_primary_command_buffer_count++;
-
-		return *primary_command_buffers.back();
+		return *primary_command_buffers[active_primary_command_buffer_count++];
 	}
 	else
 	{
-		if (active_secondary_command_buffer_count < secondary_command_buffers.size())
+		if (active_secondary_command_buffer_count == secondary_command_buffers.size())
 		{
-			return *secondary_command_buffers.at(active_secondary_command_buffer_count++);
+			allocate_command_buffers(level, secondary_command_buffers);
 		}
 
-		secondary_command_buffers.emplace_back(std::make_unique<CommandBuffer>(*this, level));
+		return *secondary_command_buffers[active_secondary_command_buffer_count++];
+	}
+}
+
+void CommandPool::allocate_command_buffers(VkCommandBufferLevel level, std::vector<std::unique_ptr<CommandBuffer>> &command_buffers)
+{
+	// Command buffers are freed on every reset when always allocating, a chunk would mostly be wasted
+	uint32_t count = reset_mode == CommandBuffer::ResetMode::AlwaysAllocate ? 1 : ALLOCATION_CHUNK_SIZE;
+
+	std::array<VkCommandBuffer, ALLOCATION_CHUNK_SIZE> handles{};
+
+	VkCommandBufferAllocateInfo allocate_info{VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+
+	allocate_info.commandPool        = handle;
+	allocate_info.commandBufferCount = count;
+	allocate_info.level              = level;
 
-		active_secondary_command_buffer_count++;
+	VkResult result = vkAllocateCommandBuffers(device.get_handle(), &allocate_info, handles.data());
 
-		return *secondary_command_buffers.back();
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Failed to allocate command buffers"};
+	}
+
+	allocation_count++;
+
+	// The wrappers are heap allocated, references returned to callers stay valid when the vector grows
+	command_buffers.reserve(command_buffers.size() + count);
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		command_buffers.emplace_back(std::make_unique<CommandBuffer>(*this, level, handles[i]));
 	}
 }
 
@@ -222,4 +250,9 @@ CommandBuffer::ResetMode const CommandPool::get_reset_mode() const
 {
 	return reset_mode;
 }
+
+uint32_t CommandPool::get_allocation_count() const
+{
+	return allocation_count;
+}
 }        // namespace vkb
@@ -32,6 +32,12 @@ class RenderFrame;
 class CommandPool
 {
   public:
+	/**
+	 * @brief Number of command buffers allocated at once when the pool runs out of them,
+	 *        except when always allocating where they are allocated one by one
+	 */
+	static constexpr uint32_t ALLOCATION_CHUNK_SIZE = 16;
+
 	CommandPool(Device &device, uint32_t queue_family_index, RenderFrame *render_frame = nullptr,
 	            size_t                   thread_index = 0,
 	            CommandBuffer::ResetMode reset_mode   = CommandBuffer::ResetMode::ResetPool);
@@ -62,6 +68,11 @@ class CommandPool
 
 	const CommandBuffer::ResetMode get_reset_mode() const;
 
+	/**
+	 * @return The number of calls to vkAllocateCommandBuffers since the pool was last reset
+	 */
+	uint32_t get_allocation_count() const;
+
   private:
 	Device &device;
 
@@ -83,6 +94,15 @@ class CommandPool
 
 	CommandBuffer::ResetMode reset_mode{CommandBuffer::ResetMode::ResetPool};
 
+	uint32_t allocation_count{0};
+
 	VkResult reset_command_buffers();
+
+	/**
+	 * @brief Allocates a chunk of command buffers with a single call, a single one when always allocating
+	 * @param level The level of the command buffers
+	 * @param command_buffers Vector where the new command buffers are appended
+	 */
+	void allocate_command_buffers(VkCommandBufferLevel level, std::vector<std::unique_ptr<CommandBuffer>> &command_buffers);
 };
 }        // namespace vkb
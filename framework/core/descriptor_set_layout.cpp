@@ -100,6 +100,16 @@ DescriptorSetLayout::DescriptorSetLayout(Device &device, const std::vector<Shade
 
 		bindings.push_back(layout_binding);
 
+		if (resource.update_after_bind)
+		{
+			binding_flags.push_back(VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT);
+			update_after_bind = true;
+		}
+		else
+		{
+			binding_flags.push_back(0);
+		}
+
 		// Store mapping between binding and the binding point
 		bindings_lookup.emplace(resource.binding, layout_binding);
 
@@ -111,6 +121,17 @@ DescriptorSetLayout::DescriptorSetLayout(Device &device, const std::vector<Shade
 	create_info.bindingCount = to_u32(bindings.size());
 	create_info.pBindings    = bindings.data();
 
+	VkDescriptorSetLayoutBindingFlagsCreateInfoEXT binding_flags_info{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT};
+
+	if (update_after_bind)
+	{
+		binding_flags_info.bindingCount  = to_u32(binding_flags.size());
+		binding_flags_info.pBindingFlags = binding_flags.data();
+
+		create_info.pNext = &binding_flags_info;
+		create_info.flags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+	}
+
 	// Create the Vulkan descriptor set layout handle
 	VkResult result = vkCreateDescriptorSetLayout(device.get_handle(), &create_info, nullptr, &handle);
 
@@ -125,7 +146,9 @@ DescriptorSetLayout::DescriptorSetLayout(DescriptorSetLayout &&other) :
     handle{other.handle},
     bindings{std::move(other.bindings)},
     bindings_lookup{std::move(other.bindings_lookup)},
-    resources_lookup{std::move(other.resources_lookup)}
+    resources_lookup{std::move(other.resources_lookup)},
+    binding_flags{std::move(other.binding_flags)},
+    update_after_bind{other.update_after_bind}
 {
 	other.handle = VK_NULL_HANDLE;
 }
@@ -149,6 +172,11 @@ const std::vector<VkDescriptorSetLayoutBinding> &DescriptorSetLayout::get_bindin
 	return bindings;
 }
 
+bool DescriptorSetLayout::is_update_after_bind() const
+{
+	return update_after_bind;
+}
+
 bool DescriptorSetLayout::get_layout_binding(uint32_t binding_index, VkDescriptorSetLayoutBinding &binding) const
 {
 	auto it = bindings_lookup.find(binding_index);
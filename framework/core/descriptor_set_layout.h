@@ -53,6 +53,11 @@ class DescriptorSetLayout
 
 	const std::vector<VkDescriptorSetLayoutBinding> &get_bindings() const;
 
+	/**
+	 * @return Whether a binding can be updated after being bound, pools must then be created with the matching flag
+	 */
+	bool is_update_after_bind() const;
+
 	bool get_layout_binding(uint32_t binding_index, VkDescriptorSetLayoutBinding &binding) const;
 
 	bool has_layout_binding(const std::string &name, VkDescriptorSetLayoutBinding &binding) const;
@@ -67,5 +72,9 @@ class DescriptorSetLayout
 	std::unordered_map<uint32_t, VkDescriptorSetLayoutBinding> bindings_lookup;
 
 	std::unordered_map<std::string, uint32_t> resources_lookup;
+
+	std::vector<VkDescriptorBindingFlagsEXT> binding_flags;
+
+	bool update_after_bind{false};
 };
 }        // namespace vkb
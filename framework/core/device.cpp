@@ -27,7 +27,8 @@ VKBP_ENABLE_WARNINGS()
 
 namespace vkb
 {
-Device::Device(VkPhysicalDevice physical_device, VkSurfaceKHR surface, std::vector<const char *> extensions, VkPhysicalDeviceFeatures requested_features) :
+Device::Device(VkPhysicalDevice physical_device, VkSurfaceKHR surface, std::vector<const char *> extensions, VkPhysicalDeviceFeatures requested_features,
+               const std::string &pipeline_cache_filename) :
     physical_device{physical_device},
     resource_cache{*this}
 {
@@ -38,6 +39,12 @@ Device::Device(VkPhysicalDevice physical_device, VkSurfaceKHR surface, std::vect
 		requested_features.textureCompressionASTC_LDR = VK_TRUE;
 	}
 
+	// Pipeline statistics are queried by the instrumentation mode of the samples
+	if (features.pipelineStatisticsQuery)
+	{
+		requested_features.pipelineStatisticsQuery = VK_TRUE;
+	}
+
 	// Gpu properties
 	vkGetPhysicalDeviceProperties(physical_device, &properties);
 	LOGI("GPU: {}", properties.deviceName);
@@ -84,8 +91,52 @@ Device::Device(VkPhysicalDevice physical_device, VkSurfaceKHR surface, std::vect
 		LOGI("Dedicated Allocation enabled");
 	}
 
+	// Check whether descriptor indexing can be enabled for bindless textures, its features
+	// are queried through VK_KHR_get_physical_device_properties2 as the instance targets Vulkan 1.0
+	auto is_extension_available = [&device_extensions](const char *name) {
+		return std::find_if(std::begin(device_extensions),
+		                    std::end(device_extensions),
+		                    [name](auto &extension) { return std::strcmp(extension.extensionName, name) == 0; }) != std::end(device_extensions);
+	};
+
+	VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT};
+
+	if (is_extension_available(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) &&
+	    is_extension_available(VK_KHR_MAINTENANCE3_EXTENSION_NAME) &&
+	    vkGetPhysicalDeviceFeatures2KHR && vkGetPhysicalDeviceProperties2KHR)
+	{
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT supported_features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT};
+
+		VkPhysicalDeviceFeatures2KHR features2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR};
+		features2.pNext = &supported_features;
+		vkGetPhysicalDeviceFeatures2KHR(physical_device, &features2);
+
+		if (supported_features.descriptorBindingPartiallyBound &&
+		    supported_features.descriptorBindingSampledImageUpdateAfterBind &&
+		    features.shaderSampledImageArrayDynamicIndexing)
+		{
+			descriptor_indexing_features.descriptorBindingPartiallyBound              = VK_TRUE;
+			descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			requested_features.shaderSampledImageArrayDynamicIndexing                 = VK_TRUE;
+
+			VkPhysicalDeviceProperties2KHR properties2{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR};
+			properties2.pNext = &descriptor_indexing_properties;
+			vkGetPhysicalDeviceProperties2KHR(physical_device, &properties2);
+
+			extensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+			extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+			descriptor_indexing_enabled = true;
+			LOGI("Descriptor indexing enabled");
+		}
+	}
+
 	VkDeviceCreateInfo create_info{VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
 
+	if (descriptor_indexing_enabled)
+	{
+		create_info.pNext = &descriptor_indexing_features;
+	}
+
 	create_info.pQueueCreateInfos       = queue_create_infos.data();
 	create_info.queueCreateInfoCount    = to_u32(queue_create_infos.size());
 	create_info.pEnabledFeatures        = &requested_features;
@@ -123,6 +174,7 @@ Device::Device(VkPhysicalDevice physical_device, VkSurfaceKHR surface, std::vect
 	vma_vulkan_func.vkAllocateMemory                    = vkAllocateMemory;
 	vma_vulkan_func.vkBindBufferMemory                  = vkBindBufferMemory;
 	vma_vulkan_func.vkBindImageMemory                   = vkBindImageMemory;
+	vma_vulkan_func.vkCmdCopyBuffer                     = vkCmdCopyBuffer;
 	vma_vulkan_func.vkCreateBuffer                      = vkCreateBuffer;
 	vma_vulkan_func.vkCreateImage                       = vkCreateImage;
 	vma_vulkan_func.vkDestroyBuffer                     = vkDestroyBuffer;
@@ -159,12 +211,18 @@ Device::Device(VkPhysicalDevice physical_device, VkSurfaceKHR surface, std::vect
 
 	command_pool = std::make_unique<CommandPool>(*this, get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, 0).get_family_index());
 	fence_pool   = std::make_unique<FencePool>(*this);
+
+	pipeline_cache_manager = std::make_unique<PipelineCacheManager>(*this, pipeline_cache_filename);
+
+	resource_cache.set_pipeline_cache(pipeline_cache_manager->get_handle());
 }
 
 Device::~Device()
 {
 	resource_cache.clear();
 
+	pipeline_cache_manager.reset();
+
 	command_pool.reset();
 	fence_pool.reset();
 
@@ -218,6 +276,16 @@ DriverVersion Device::get_driver_version() const
 	return version;
 }
 
+bool Device::is_descriptor_indexing_enabled() const
+{
+	return descriptor_indexing_enabled;
+}
+
+const VkPhysicalDeviceDescriptorIndexingPropertiesEXT &Device::get_descriptor_indexing_properties() const
+{
+	return descriptor_indexing_properties;
+}
+
 bool Device::is_image_format_supported(VkFormat format) const
 {
 	VkImageFormatProperties format_properties;
@@ -296,6 +364,24 @@ const Queue &Device::get_suitable_graphics_queue()
 	return get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
 }
 
+const Queue &Device::get_transfer_queue()
+{
+	for (uint32_t queue_family_index = 0U; queue_family_index < queues.size(); ++queue_family_index)
+	{
+		Queue &first_queue = queues[queue_family_index][0];
+
+		VkQueueFlags queue_flags = first_queue.get_properties().queueFlags;
+
+		if ((queue_flags & VK_QUEUE_TRANSFER_BIT) && !(queue_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+		{
+			return first_queue;
+		}
+	}
+
+	// Graphics and compute queues support transfers even if they do not report it
+	return get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT, 0);
+}
+
 CommandBuffer &Device::request_command_buffer()
 {
 	return command_pool->request_command_buffer();
@@ -315,4 +401,9 @@ ResourceCache &Device::get_resource_cache()
 {
 	return resource_cache;
 }
+
+PipelineCacheManager &Device::get_pipeline_cache_manager()
+{
+	return *pipeline_cache_manager;
+}
 }        // namespace vkb
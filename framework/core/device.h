@@ -36,6 +36,7 @@
 #include "core/shader_module.h"
 #include "core/swapchain.h"
 #include "fence_pool.h"
+#include "pipeline_cache_manager.h"
 #include "rendering/pipeline_state.h"
 #include "rendering/render_target.h"
 #include "resource_cache.h"
@@ -52,7 +53,15 @@ struct DriverVersion
 class Device
 {
   public:
-	Device(VkPhysicalDevice physical_device, VkSurfaceKHR surface, std::vector<const char *> extensions = {}, VkPhysicalDeviceFeatures features = {});
+	/**
+	 * @param physical_device The GPU
+	 * @param surface The surface the swapchain presents to, VK_NULL_HANDLE when headless
+	 * @param extensions Extensions requested to be enabled
+	 * @param features Features requested to be enabled
+	 * @param pipeline_cache_filename Name of the file the pipeline cache persists to, see PipelineCacheManager
+	 */
+	Device(VkPhysicalDevice physical_device, VkSurfaceKHR surface, std::vector<const char *> extensions = {}, VkPhysicalDeviceFeatures features = {},
+	       const std::string &pipeline_cache_filename = PipelineCacheManager::DEFAULT_FILENAME);
 
 	Device(const Device &) = delete;
 
@@ -79,6 +88,17 @@ class Device
 	 */
 	DriverVersion get_driver_version() const;
 
+	/**
+	 * @return Whether VK_EXT_descriptor_indexing was enabled with partially bound,
+	 *         update-after-bind sampled images, as required by bindless textures
+	 */
+	bool is_descriptor_indexing_enabled() const;
+
+	/**
+	 * @return The limits of descriptor indexing, only valid if it is enabled
+	 */
+	const VkPhysicalDeviceDescriptorIndexingPropertiesEXT &get_descriptor_indexing_properties() const;
+
 	/**
 	 * @return Whether an image format is supported by the GPU
 	 */
@@ -97,6 +117,11 @@ class Device
 	 */
 	const Queue &get_suitable_graphics_queue();
 
+	/**
+	 * @brief Returns the first queue of a family dedicated to transfers, otherwise a graphics and compute queue
+	 */
+	const Queue &get_transfer_queue();
+
 	/**
 	 * @return The command pool
 	 */
@@ -129,6 +154,11 @@ class Device
 
 	ResourceCache &get_resource_cache();
 
+	/**
+	 * @return The manager of the pipeline cache used by the resource cache
+	 */
+	PipelineCacheManager &get_pipeline_cache_manager();
+
   private:
 	VkPhysicalDevice physical_device{VK_NULL_HANDLE};
 
@@ -142,6 +172,10 @@ class Device
 
 	VkPhysicalDeviceProperties properties;
 
+	bool descriptor_indexing_enabled{false};
+
+	VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptor_indexing_properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT};
+
 	std::vector<std::vector<Queue>> queues;
 
 	/// A command pool associated to the primary queue
@@ -150,6 +184,9 @@ class Device
 	/// A fence pool associated to the primary queue
 	std::unique_ptr<FencePool> fence_pool;
 
+	/// Pipeline cache persisted across runs
+	std::unique_ptr<PipelineCacheManager> pipeline_cache_manager;
+
 	ResourceCache resource_cache;
 };
 }        // namespace vkb
@@ -27,7 +27,9 @@ namespace vkb
 {
 namespace core
 {
-ImageView::ImageView(Image &img, VkImageViewType view_type, VkFormat format) :
+ImageView::ImageView(Image &img, VkImageViewType view_type, VkFormat format,
+                     uint32_t base_mip_level, uint32_t base_array_layer,
+                     uint32_t n_mip_levels, uint32_t n_array_layers) :
     device{img.get_device()},
     image{&img},
     format{format}
@@ -37,8 +39,13 @@ ImageView::ImageView(Image &img, VkImageViewType view_type, VkFormat format) :
 		this->format = format = image->get_format();
 	}
 
-	subresource_range.levelCount = image->get_subresource().mipLevel;
-	subresource_range.layerCount = image->get_subresource().arrayLayer;
+	assert(base_mip_level < image->get_subresource().mipLevel && "Base mip level is out of the image");
+	assert(base_array_layer < image->get_subresource().arrayLayer && "Base array layer is out of the image");
+
+	subresource_range.baseMipLevel   = base_mip_level;
+	subresource_range.baseArrayLayer = base_array_layer;
+	subresource_range.levelCount     = n_mip_levels == 0 ? image->get_subresource().mipLevel - base_mip_level : n_mip_levels;
+	subresource_range.layerCount     = n_array_layers == 0 ? image->get_subresource().arrayLayer - base_array_layer : n_array_layers;
 
 	if (is_depth_only_format(format))
 	{
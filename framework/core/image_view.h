@@ -31,7 +31,18 @@ namespace core
 class ImageView
 {
   public:
-	ImageView(Image &image, VkImageViewType view_type, VkFormat format = VK_FORMAT_UNDEFINED);
+	/**
+	 * @param image Image the view refers to
+	 * @param view_type Type of the view
+	 * @param format Format of the view, the one of the image if undefined
+	 * @param base_mip_level First mip level of the view
+	 * @param base_array_layer First array layer of the view
+	 * @param n_mip_levels Number of mip levels of the view, 0 for all the remaining ones
+	 * @param n_array_layers Number of array layers of the view, 0 for all the remaining ones
+	 */
+	ImageView(Image &image, VkImageViewType view_type, VkFormat format = VK_FORMAT_UNDEFINED,
+	          uint32_t base_mip_level = 0, uint32_t base_array_layer = 0,
+	          uint32_t n_mip_levels = 0, uint32_t n_array_layers = 0);
 
 	ImageView(ImageView &) = delete;
 
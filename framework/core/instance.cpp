@@ -22,6 +22,8 @@
 
 #include <algorithm>
 
+#include "core/null_driver.h"
+
 namespace vkb
 {
 namespace
@@ -104,13 +106,23 @@ bool validate_layers(const std::vector<const char *> &     required,
 Instance::Instance(const std::string &              application_name,
                    const std::vector<const char *> &required_extensions,
                    const std::vector<const char *> &required_validation_layers,
-                   bool                             headless) :
+                   bool                             headless,
+                   bool                             null_driver) :
     extensions{required_extensions}
 {
-	VkResult result = volkInitialize();
-	if (result)
+	VkResult result = VK_SUCCESS;
+
+	if (null_driver)
+	{
+		null_driver::install();
+	}
+	else
 	{
-		throw VulkanException(result, "Failed to initialize volk.");
+		result = volkInitialize();
+		if (result)
+		{
+			throw VulkanException(result, "Failed to initialize volk.");
+		}
 	}
 
 	uint32_t instance_extension_count;
@@ -146,6 +158,22 @@ Instance::Instance(const std::string &              application_name,
 		extensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
 	}
 
+	// Try to enable the extension used to query the features of device extensions, such as descriptor indexing
+	bool properties2_requested = std::any_of(extensions.begin(), extensions.end(), [](const char *extension) {
+		return strcmp(extension, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0;
+	});
+
+	if (!properties2_requested)
+	{
+		for (auto &available_extension : available_instance_extensions)
+		{
+			if (strcmp(available_extension.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0)
+			{
+				extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+			}
+		}
+	}
+
 	if (!validate_extensions(extensions, available_instance_extensions))
 	{
 		throw std::runtime_error("Required instance extensions are missing.");
@@ -163,6 +191,12 @@ Instance::Instance(const std::string &              application_name,
 	active_instance_layers.push_back("VK_LAYER_KHRONOS_validation");
 #endif
 
+	if (null_driver && !active_instance_layers.empty())
+	{
+		LOGW("Layers cannot be used with the null driver, disabling them");
+		active_instance_layers.clear();
+	}
+
 	if (!validate_layers(active_instance_layers, instance_layers))
 	{
 		throw std::runtime_error("Required validation layers are missing.");
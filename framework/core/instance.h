@@ -40,12 +40,14 @@ class Instance
 	 * @param required_extensions The extensions requested to be enabled
 	 * @param required_validation_layers The validation layers to be enabled
 	 * @param headless Whether the application is requesting a headless setup or not
+	 * @param null_driver Whether the entry points of the null driver are used instead of the Vulkan library
 	 * @throws runtime_error if the required extensions and validation layers are not found
 	 */
 	Instance(const std::string &              application_name,
 	         const std::vector<const char *> &required_extensions        = {},
 	         const std::vector<const char *> &required_validation_layers = {},
-	         bool                             headless                   = false);
+	         bool                             headless                   = false,
+	         bool                             null_driver                = false);
 
 	Instance(const Instance &) = delete;
 
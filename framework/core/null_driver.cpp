@@ -0,0 +1,1587 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "null_driver.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/helpers.h"
+#include "common/logging.h"
+
+namespace vkb
+{
+namespace null_driver
+{
+namespace
+{
+constexpr uint32_t VENDOR_ID = 0;
+
+constexpr uint32_t DEVICE_ID = 0;
+
+constexpr uint32_t QUEUE_COUNT = 2;
+
+constexpr VkDeviceSize HEAP_SIZE = 4ULL * 1024 * 1024 * 1024;
+
+// Alignment of resources and mapped pointers, large enough for any usage
+constexpr VkDeviceSize MEMORY_ALIGNMENT = 256;
+
+constexpr uint8_t PIPELINE_CACHE_UUID[VK_UUID_SIZE] = {'v', 'k', 'b', ' ', 'n', 'u', 'l', 'l', ' ', 'd', 'r', 'i', 'v', 'e', 'r', '\0'};
+
+// Size of the header of the pipeline cache data, as defined by VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+constexpr size_t PIPELINE_CACHE_HEADER_SIZE = 16 + VK_UUID_SIZE;
+
+std::atomic<bool> installed{false};
+
+std::atomic<bool> command_recording{false};
+
+std::atomic<uint64_t> total_call_count{0};
+
+std::atomic<int64_t> live_object_count{0};
+
+std::mutex call_counts_mutex;
+
+std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>> &get_call_count_map()
+{
+	static std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>> call_counts;
+	return call_counts;
+}
+
+std::atomic<uint64_t> &register_entry_point(const char *name)
+{
+	std::lock_guard<std::mutex> guard(call_counts_mutex);
+
+	auto &call_count = get_call_count_map()[name];
+
+	if (!call_count)
+	{
+		call_count = std::make_unique<std::atomic<uint64_t>>(0);
+	}
+
+	return *call_count;
+}
+
+// Counts a call of the entry point implemented by the enclosing function
+#define COUNT_CALL(name)                                                   \
+	static std::atomic<uint64_t> &call_count = register_entry_point(name); \
+	call_count.fetch_add(1, std::memory_order_relaxed);                    \
+	total_call_count.fetch_add(1, std::memory_order_relaxed)
+
+/// Any object without state of its own
+struct Object
+{
+};
+
+struct PhysicalDevice
+{
+};
+
+struct Instance
+{
+	PhysicalDevice physical_device;
+};
+
+struct Queue
+{
+};
+
+struct Device
+{
+	std::array<Queue, QUEUE_COUNT> queues;
+};
+
+struct DeviceMemory
+{
+	~DeviceMemory()
+	{
+		std::free(allocation);
+	}
+
+	void *allocation{nullptr};
+
+	uint8_t *data{nullptr};
+};
+
+struct Buffer
+{
+	VkDeviceSize size{0};
+};
+
+struct Image
+{
+	VkFormat format{VK_FORMAT_UNDEFINED};
+
+	VkExtent3D extent{};
+
+	uint32_t mip_levels{1};
+
+	uint32_t array_layers{1};
+
+	VkSampleCountFlagBits samples{VK_SAMPLE_COUNT_1_BIT};
+};
+
+struct Fence
+{
+	std::atomic<bool> signaled{false};
+};
+
+struct CommandBuffer;
+
+struct CommandPool
+{
+	std::vector<CommandBuffer *> command_buffers;
+};
+
+struct CommandBuffer
+{
+	CommandPool *pool{nullptr};
+
+	std::vector<const char *> commands;
+};
+
+struct DescriptorPool
+{
+	uint32_t max_sets{0};
+
+	std::unordered_set<Object *> descriptor_sets;
+};
+
+struct PipelineCache
+{
+	std::vector<uint8_t> data;
+};
+
+template <typename Handle, typename T>
+Handle to_handle(T *object)
+{
+	// Non-dispatchable handles are integers on 32-bit platforms, a C-style cast handles both cases
+	return (Handle) reinterpret_cast<uintptr_t>(object);
+}
+
+template <typename T, typename Handle>
+T *from_handle(Handle handle)
+{
+	return reinterpret_cast<T *>((uintptr_t) handle);
+}
+
+template <typename Handle, typename T>
+Handle register_object(T *object)
+{
+	live_object_count.fetch_add(1, std::memory_order_relaxed);
+	return to_handle<Handle>(object);
+}
+
+template <typename T>
+void release_object(T *object)
+{
+	if (object)
+	{
+		live_object_count.fetch_sub(1, std::memory_order_relaxed);
+		delete object;
+	}
+}
+
+template <typename T, typename Handle>
+void destroy_object(Handle handle)
+{
+	release_object(from_handle<T>(handle));
+}
+
+template <typename Handle>
+VkResult create_object(Handle *handle)
+{
+	*handle = register_object<Handle>(new Object{});
+	return VK_SUCCESS;
+}
+
+template <typename T>
+VkResult enumerate(const std::vector<T> &items, uint32_t *count, T *out)
+{
+	if (!out)
+	{
+		*count = to_u32(items.size());
+		return VK_SUCCESS;
+	}
+
+	*count = std::min(*count, to_u32(items.size()));
+	std::copy(items.begin(), items.begin() + *count, out);
+
+	return *count < items.size() ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+VkExtensionProperties make_extension(const char *name, uint32_t spec_version)
+{
+	VkExtensionProperties extension{};
+	std::strncpy(extension.extensionName, name, VK_MAX_EXTENSION_NAME_SIZE - 1);
+	extension.specVersion = spec_version;
+	return extension;
+}
+
+const std::vector<VkExtensionProperties> &get_instance_extensions()
+{
+	static const std::vector<VkExtensionProperties> extensions = {
+	    make_extension(VK_EXT_DEBUG_REPORT_EXTENSION_NAME, VK_EXT_DEBUG_REPORT_SPEC_VERSION),
+	    make_extension(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_SPEC_VERSION)};
+
+	return extensions;
+}
+
+VkDeviceSize align_up(VkDeviceSize value, VkDeviceSize alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+VkDeviceSize get_texel_size(VkFormat format)
+{
+	auto bits = get_bits_per_pixel(format);
+
+	// Compressed formats take a byte per texel or less
+	return bits > 0 ? static_cast<VkDeviceSize>((bits + 7) / 8) : 1;
+}
+
+void record_command(VkCommandBuffer command_buffer, const char *name)
+{
+	if (command_recording.load(std::memory_order_relaxed))
+	{
+		from_handle<CommandBuffer>(command_buffer)->commands.push_back(name);
+	}
+}
+
+// Counts the call of a command and records it in the command buffer
+#define RECORD_COMMAND(command_buffer, name) \
+	COUNT_CALL(name);                        \
+	record_command(command_buffer, name)
+
+/*
+ * Instance and physical device
+ */
+
+VKAPI_ATTR VkResult VKAPI_CALL create_instance(const VkInstanceCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkInstance *instance)
+{
+	COUNT_CALL("vkCreateInstance");
+	*instance = register_object<VkInstance>(new Instance{});
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_instance(VkInstance instance, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyInstance");
+	destroy_object<Instance>(instance);
+
+	auto leaked_object_count = live_object_count.load();
+	if (leaked_object_count != 0)
+	{
+		LOGW("Null driver: {} objects were not destroyed", leaked_object_count);
+	}
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_instance_extension_properties(const char *layer_name, uint32_t *property_count, VkExtensionProperties *properties)
+{
+	COUNT_CALL("vkEnumerateInstanceExtensionProperties");
+
+	if (layer_name)
+	{
+		return VK_ERROR_LAYER_NOT_PRESENT;
+	}
+
+	return enumerate(get_instance_extensions(), property_count, properties);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_instance_layer_properties(uint32_t *property_count, VkLayerProperties * /*properties*/)
+{
+	COUNT_CALL("vkEnumerateInstanceLayerProperties");
+	*property_count = 0;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_physical_devices(VkInstance instance, uint32_t *physical_device_count, VkPhysicalDevice *physical_devices)
+{
+	COUNT_CALL("vkEnumeratePhysicalDevices");
+
+	std::vector<VkPhysicalDevice> devices{to_handle<VkPhysicalDevice>(&from_handle<Instance>(instance)->physical_device)};
+
+	return enumerate(devices, physical_device_count, physical_devices);
+}
+
+void fill_features(VkPhysicalDeviceFeatures *features)
+{
+	// Every member is a VkBool32, all features are supported
+	auto feature_array = reinterpret_cast<VkBool32 *>(features);
+	std::fill(feature_array, feature_array + sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32), VK_TRUE);
+}
+
+void fill_properties(VkPhysicalDeviceProperties *properties)
+{
+	*properties = {};
+
+	properties->apiVersion    = VK_MAKE_VERSION(1, 0, 0);
+	properties->driverVersion = 1;
+	properties->vendorID      = VENDOR_ID;
+	properties->deviceID      = DEVICE_ID;
+	properties->deviceType    = VK_PHYSICAL_DEVICE_TYPE_CPU;
+
+	std::strncpy(properties->deviceName, "Null Device", VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+	std::memcpy(properties->pipelineCacheUUID, PIPELINE_CACHE_UUID, VK_UUID_SIZE);
+
+	auto &limits = properties->limits;
+
+	limits.maxImageDimension1D                   = 16384;
+	limits.maxImageDimension2D                   = 16384;
+	limits.maxImageDimension3D                   = 2048;
+	limits.maxImageDimensionCube                 = 16384;
+	limits.maxImageArrayLayers                   = 2048;
+	limits.maxTexelBufferElements                = 1 << 27;
+	limits.maxUniformBufferRange                 = 65536;
+	limits.maxStorageBufferRange                 = 1 << 30;
+	limits.maxPushConstantsSize                  = 256;
+	limits.maxMemoryAllocationCount              = 4096;
+	limits.maxSamplerAllocationCount             = 4000;
+	limits.bufferImageGranularity                = 1;
+	limits.maxBoundDescriptorSets                = 8;
+	limits.maxPerStageDescriptorSamplers         = 1 << 20;
+	limits.maxPerStageDescriptorUniformBuffers   = 1 << 20;
+	limits.maxPerStageDescriptorStorageBuffers   = 1 << 20;
+	limits.maxPerStageDescriptorSampledImages    = 1 << 20;
+	limits.maxPerStageDescriptorStorageImages    = 1 << 20;
+	limits.maxPerStageDescriptorInputAttachments = 1 << 20;
+	limits.maxPerStageResources                  = 1 << 20;
+	limits.maxDescriptorSetSamplers              = 1 << 20;
+	limits.maxDescriptorSetUniformBuffers        = 1 << 20;
+	limits.maxDescriptorSetUniformBuffersDynamic = 16;
+	limits.maxDescriptorSetStorageBuffers        = 1 << 20;
+	limits.maxDescriptorSetStorageBuffersDynamic = 16;
+	limits.maxDescriptorSetSampledImages         = 1 << 20;
+	limits.maxDescriptorSetStorageImages         = 1 << 20;
+	limits.maxDescriptorSetInputAttachments      = 1 << 20;
+	limits.maxVertexInputAttributes              = 32;
+	limits.maxVertexInputBindings                = 32;
+	limits.maxVertexInputAttributeOffset         = 2047;
+	limits.maxVertexInputBindingStride           = 2048;
+	limits.maxVertexOutputComponents             = 128;
+	limits.maxFragmentInputComponents            = 128;
+	limits.maxFragmentOutputAttachments          = 8;
+	limits.maxFragmentCombinedOutputResources    = 1 << 20;
+	limits.maxComputeSharedMemorySize            = 32768;
+	limits.maxComputeWorkGroupCount[0]           = 65535;
+	limits.maxComputeWorkGroupCount[1]           = 65535;
+	limits.maxComputeWorkGroupCount[2]           = 65535;
+	limits.maxComputeWorkGroupInvocations        = 1024;
+	limits.maxComputeWorkGroupSize[0]            = 1024;
+	limits.maxComputeWorkGroupSize[1]            = 1024;
+	limits.maxComputeWorkGroupSize[2]            = 64;
+	limits.maxDrawIndexedIndexValue              = UINT32_MAX;
+	limits.maxDrawIndirectCount                  = UINT32_MAX;
+	limits.maxSamplerLodBias                     = 16.0f;
+	limits.maxSamplerAnisotropy                  = 16.0f;
+	limits.maxViewports                          = 16;
+	limits.maxViewportDimensions[0]              = 16384;
+	limits.maxViewportDimensions[1]              = 16384;
+	limits.viewportBoundsRange[0]                = -32768.0f;
+	limits.viewportBoundsRange[1]                = 32767.0f;
+	limits.minMemoryMapAlignment                 = static_cast<size_t>(MEMORY_ALIGNMENT);
+	limits.minTexelBufferOffsetAlignment         = MEMORY_ALIGNMENT;
+	limits.minUniformBufferOffsetAlignment       = MEMORY_ALIGNMENT;
+	limits.minStorageBufferOffsetAlignment       = MEMORY_ALIGNMENT;
+	limits.maxFramebufferWidth                   = 16384;
+	limits.maxFramebufferHeight                  = 16384;
+	limits.maxFramebufferLayers                  = 2048;
+	limits.framebufferColorSampleCounts          = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT;
+	limits.framebufferDepthSampleCounts          = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT;
+	limits.framebufferStencilSampleCounts        = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT;
+	limits.framebufferNoAttachmentsSampleCounts  = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT;
+	limits.maxColorAttachments                   = 8;
+	limits.sampledImageColorSampleCounts         = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT;
+	limits.sampledImageIntegerSampleCounts       = VK_SAMPLE_COUNT_1_BIT;
+	limits.sampledImageDepthSampleCounts         = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT;
+	limits.sampledImageStencilSampleCounts       = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT;
+	limits.storageImageSampleCounts              = VK_SAMPLE_COUNT_1_BIT;
+	limits.maxSampleMaskWords                    = 1;
+	limits.timestampComputeAndGraphics           = VK_TRUE;
+	limits.timestampPeriod                       = 1.0f;
+	limits.maxClipDistances                      = 8;
+	limits.maxCullDistances                      = 8;
+	limits.maxCombinedClipAndCullDistances       = 8;
+	limits.discreteQueuePriorities               = 2;
+	limits.pointSizeRange[0]                     = 1.0f;
+	limits.pointSizeRange[1]                     = 1024.0f;
+	limits.lineWidthRange[0]                     = 1.0f;
+	limits.lineWidthRange[1]                     = 8.0f;
+	limits.pointSizeGranularity                  = 1.0f;
+	limits.lineWidthGranularity                  = 1.0f;
+	limits.optimalBufferCopyOffsetAlignment      = 1;
+	limits.optimalBufferCopyRowPitchAlignment    = 1;
+	limits.nonCoherentAtomSize                   = 64;
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_features(VkPhysicalDevice /*physical_device*/, VkPhysicalDeviceFeatures *features)
+{
+	COUNT_CALL("vkGetPhysicalDeviceFeatures");
+	fill_features(features);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_features2(VkPhysicalDevice /*physical_device*/, VkPhysicalDeviceFeatures2KHR *features)
+{
+	COUNT_CALL("vkGetPhysicalDeviceFeatures2KHR");
+
+	// Extension structures in the chain are left untouched, as no device extension is supported
+	fill_features(&features->features);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_properties(VkPhysicalDevice /*physical_device*/, VkPhysicalDeviceProperties *properties)
+{
+	COUNT_CALL("vkGetPhysicalDeviceProperties");
+	fill_properties(properties);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_properties2(VkPhysicalDevice /*physical_device*/, VkPhysicalDeviceProperties2KHR *properties)
+{
+	COUNT_CALL("vkGetPhysicalDeviceProperties2KHR");
+	fill_properties(&properties->properties);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_queue_family_properties(VkPhysicalDevice /*physical_device*/, uint32_t *property_count, VkQueueFamilyProperties *properties)
+{
+	COUNT_CALL("vkGetPhysicalDeviceQueueFamilyProperties");
+
+	VkQueueFamilyProperties family{};
+	family.queueFlags                  = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+	family.queueCount                  = QUEUE_COUNT;
+	family.timestampValidBits          = 64;
+	family.minImageTransferGranularity = {1, 1, 1};
+
+	enumerate(std::vector<VkQueueFamilyProperties>{family}, property_count, properties);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_memory_properties(VkPhysicalDevice /*physical_device*/, VkPhysicalDeviceMemoryProperties *properties)
+{
+	COUNT_CALL("vkGetPhysicalDeviceMemoryProperties");
+
+	*properties = {};
+
+	// All memory is host memory, a lazily allocated type is exposed for transient attachments
+	properties->memoryTypeCount = 2;
+
+	properties->memoryTypes[0].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+	                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+	properties->memoryTypes[1].propertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+
+	properties->memoryHeapCount = 1;
+
+	properties->memoryHeaps[0].size  = HEAP_SIZE;
+	properties->memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+}
+
+VKAPI_ATTR void VKAPI_CALL get_physical_device_format_properties(VkPhysicalDevice /*physical_device*/, VkFormat format, VkFormatProperties *properties)
+{
+	COUNT_CALL("vkGetPhysicalDeviceFormatProperties");
+
+	*properties = {};
+
+	if (format == VK_FORMAT_UNDEFINED)
+	{
+		return;
+	}
+
+	VkFormatFeatureFlags image_features = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT |
+	                                      VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT | VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+
+	if (is_depth_only_format(format) || is_depth_stencil_format(format))
+	{
+		image_features |= VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT;
+	}
+	else
+	{
+		image_features |= VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BLEND_BIT;
+	}
+
+	properties->linearTilingFeatures  = image_features;
+	properties->optimalTilingFeatures = image_features;
+	properties->bufferFeatures        = VK_FORMAT_FEATURE_VERTEX_BUFFER_BIT | VK_FORMAT_FEATURE_UNIFORM_TEXEL_BUFFER_BIT | VK_FORMAT_FEATURE_STORAGE_TEXEL_BUFFER_BIT;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_physical_device_image_format_properties(VkPhysicalDevice /*physical_device*/, VkFormat /*format*/, VkImageType /*type*/,
+                                                                         VkImageTiling /*tiling*/, VkImageUsageFlags /*usage*/, VkImageCreateFlags /*flags*/,
+                                                                         VkImageFormatProperties *properties)
+{
+	COUNT_CALL("vkGetPhysicalDeviceImageFormatProperties");
+
+	properties->maxExtent       = {16384, 16384, 2048};
+	properties->maxMipLevels    = 15;
+	properties->maxArrayLayers  = 2048;
+	properties->sampleCounts    = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_2_BIT | VK_SAMPLE_COUNT_4_BIT;
+	properties->maxResourceSize = HEAP_SIZE;
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL enumerate_device_extension_properties(VkPhysicalDevice /*physical_device*/, const char *layer_name, uint32_t *property_count, VkExtensionProperties * /*properties*/)
+{
+	COUNT_CALL("vkEnumerateDeviceExtensionProperties");
+
+	if (layer_name)
+	{
+		return VK_ERROR_LAYER_NOT_PRESENT;
+	}
+
+	*property_count = 0;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_debug_report_callback(VkInstance /*instance*/, const VkDebugReportCallbackCreateInfoEXT * /*create_info*/,
+                                                            const VkAllocationCallbacks * /*allocator*/, VkDebugReportCallbackEXT *callback)
+{
+	COUNT_CALL("vkCreateDebugReportCallbackEXT");
+	return create_object(callback);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_debug_report_callback(VkInstance /*instance*/, VkDebugReportCallbackEXT callback, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyDebugReportCallbackEXT");
+	destroy_object<Object>(callback);
+}
+
+/*
+ * Device and queues
+ */
+
+VKAPI_ATTR VkResult VKAPI_CALL create_device(VkPhysicalDevice /*physical_device*/, const VkDeviceCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkDevice *device)
+{
+	COUNT_CALL("vkCreateDevice");
+	*device = register_object<VkDevice>(new Device{});
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_device(VkDevice device, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyDevice");
+	destroy_object<Device>(device);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_device_queue(VkDevice device, uint32_t /*queue_family_index*/, uint32_t queue_index, VkQueue *queue)
+{
+	COUNT_CALL("vkGetDeviceQueue");
+
+	assert(queue_index < QUEUE_COUNT && "Queue index is out of bounds");
+
+	*queue = to_handle<VkQueue>(&from_handle<Device>(device)->queues[queue_index]);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL queue_submit(VkQueue /*queue*/, uint32_t /*submit_count*/, const VkSubmitInfo * /*submits*/, VkFence fence)
+{
+	COUNT_CALL("vkQueueSubmit");
+
+	// Nothing is executed, so the submission is complete as soon as it is made
+	if (fence != VK_NULL_HANDLE)
+	{
+		from_handle<Fence>(fence)->signaled = true;
+	}
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL queue_wait_idle(VkQueue /*queue*/)
+{
+	COUNT_CALL("vkQueueWaitIdle");
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL device_wait_idle(VkDevice /*device*/)
+{
+	COUNT_CALL("vkDeviceWaitIdle");
+	return VK_SUCCESS;
+}
+
+/*
+ * Memory and resources
+ */
+
+VKAPI_ATTR VkResult VKAPI_CALL allocate_memory(VkDevice /*device*/, const VkMemoryAllocateInfo *allocate_info, const VkAllocationCallbacks * /*allocator*/, VkDeviceMemory *memory)
+{
+	COUNT_CALL("vkAllocateMemory");
+
+	// Untouched pages of large allocations are usually not committed by the operating system
+	auto device_memory        = new DeviceMemory{};
+	device_memory->allocation = std::malloc(static_cast<size_t>(allocate_info->allocationSize + MEMORY_ALIGNMENT));
+
+	if (!device_memory->allocation)
+	{
+		delete device_memory;
+		return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+	}
+
+	device_memory->data = reinterpret_cast<uint8_t *>(align_up(reinterpret_cast<uintptr_t>(device_memory->allocation), MEMORY_ALIGNMENT));
+
+	*memory = register_object<VkDeviceMemory>(device_memory);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL free_memory(VkDevice /*device*/, VkDeviceMemory memory, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkFreeMemory");
+	destroy_object<DeviceMemory>(memory);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL map_memory(VkDevice /*device*/, VkDeviceMemory memory, VkDeviceSize offset, VkDeviceSize /*size*/, VkMemoryMapFlags /*flags*/, void **data)
+{
+	COUNT_CALL("vkMapMemory");
+	*data = from_handle<DeviceMemory>(memory)->data + offset;
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL unmap_memory(VkDevice /*device*/, VkDeviceMemory /*memory*/)
+{
+	COUNT_CALL("vkUnmapMemory");
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL flush_mapped_memory_ranges(VkDevice /*device*/, uint32_t /*memory_range_count*/, const VkMappedMemoryRange * /*memory_ranges*/)
+{
+	COUNT_CALL("vkFlushMappedMemoryRanges");
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL invalidate_mapped_memory_ranges(VkDevice /*device*/, uint32_t /*memory_range_count*/, const VkMappedMemoryRange * /*memory_ranges*/)
+{
+	COUNT_CALL("vkInvalidateMappedMemoryRanges");
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_buffer(VkDevice /*device*/, const VkBufferCreateInfo *create_info, const VkAllocationCallbacks * /*allocator*/, VkBuffer *buffer)
+{
+	COUNT_CALL("vkCreateBuffer");
+
+	auto object  = new Buffer{};
+	object->size = create_info->size;
+
+	*buffer = register_object<VkBuffer>(object);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_buffer(VkDevice /*device*/, VkBuffer buffer, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyBuffer");
+	destroy_object<Buffer>(buffer);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_buffer_memory_requirements(VkDevice /*device*/, VkBuffer buffer, VkMemoryRequirements *memory_requirements)
+{
+	COUNT_CALL("vkGetBufferMemoryRequirements");
+
+	memory_requirements->size           = align_up(from_handle<Buffer>(buffer)->size, MEMORY_ALIGNMENT);
+	memory_requirements->alignment      = MEMORY_ALIGNMENT;
+	memory_requirements->memoryTypeBits = 1 << 0;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL bind_buffer_memory(VkDevice /*device*/, VkBuffer /*buffer*/, VkDeviceMemory /*memory*/, VkDeviceSize /*memory_offset*/)
+{
+	COUNT_CALL("vkBindBufferMemory");
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_image(VkDevice /*device*/, const VkImageCreateInfo *create_info, const VkAllocationCallbacks * /*allocator*/, VkImage *image)
+{
+	COUNT_CALL("vkCreateImage");
+
+	auto object          = new Image{};
+	object->format       = create_info->format;
+	object->extent       = create_info->extent;
+	object->mip_levels   = create_info->mipLevels;
+	object->array_layers = create_info->arrayLayers;
+	object->samples      = create_info->samples;
+
+	*image = register_object<VkImage>(object);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_image(VkDevice /*device*/, VkImage image, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyImage");
+	destroy_object<Image>(image);
+}
+
+VKAPI_ATTR void VKAPI_CALL get_image_memory_requirements(VkDevice /*device*/, VkImage image, VkMemoryRequirements *memory_requirements)
+{
+	COUNT_CALL("vkGetImageMemoryRequirements");
+
+	auto object     = from_handle<Image>(image);
+	auto texel_size = get_texel_size(object->format);
+
+	VkDeviceSize size = 0;
+
+	for (uint32_t level = 0; level < object->mip_levels; ++level)
+	{
+		VkDeviceSize width  = std::max(object->extent.width >> level, 1U);
+		VkDeviceSize height = std::max(object->extent.height >> level, 1U);
+		VkDeviceSize depth  = std::max(object->extent.depth >> level, 1U);
+
+		size += width * height * depth * texel_size;
+	}
+
+	memory_requirements->size           = align_up(size * object->array_layers * object->samples, MEMORY_ALIGNMENT);
+	memory_requirements->alignment      = MEMORY_ALIGNMENT;
+	memory_requirements->memoryTypeBits = (1 << 0) | (1 << 1);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL bind_image_memory(VkDevice /*device*/, VkImage /*image*/, VkDeviceMemory /*memory*/, VkDeviceSize /*memory_offset*/)
+{
+	COUNT_CALL("vkBindImageMemory");
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL get_image_subresource_layout(VkDevice /*device*/, VkImage image, const VkImageSubresource *subresource, VkSubresourceLayout *layout)
+{
+	COUNT_CALL("vkGetImageSubresourceLayout");
+
+	auto object = from_handle<Image>(image);
+
+	VkDeviceSize width  = std::max(object->extent.width >> subresource->mipLevel, 1U);
+	VkDeviceSize height = std::max(object->extent.height >> subresource->mipLevel, 1U);
+	VkDeviceSize depth  = std::max(object->extent.depth >> subresource->mipLevel, 1U);
+
+	// Linear images are only used with a single level and layer, which are tightly packed
+	layout->offset     = 0;
+	layout->rowPitch   = width * get_texel_size(object->format);
+	layout->depthPitch = layout->rowPitch * height;
+	layout->arrayPitch = layout->depthPitch * depth;
+	layout->size       = layout->arrayPitch;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_image_view(VkDevice /*device*/, const VkImageViewCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkImageView *view)
+{
+	COUNT_CALL("vkCreateImageView");
+	return create_object(view);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_image_view(VkDevice /*device*/, VkImageView view, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyImageView");
+	destroy_object<Object>(view);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_sampler(VkDevice /*device*/, const VkSamplerCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkSampler *sampler)
+{
+	COUNT_CALL("vkCreateSampler");
+	return create_object(sampler);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_sampler(VkDevice /*device*/, VkSampler sampler, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroySampler");
+	destroy_object<Object>(sampler);
+}
+
+/*
+ * Synchronization
+ */
+
+VKAPI_ATTR VkResult VKAPI_CALL create_fence(VkDevice /*device*/, const VkFenceCreateInfo *create_info, const VkAllocationCallbacks * /*allocator*/, VkFence *fence)
+{
+	COUNT_CALL("vkCreateFence");
+
+	auto object      = new Fence{};
+	object->signaled = (create_info->flags & VK_FENCE_CREATE_SIGNALED_BIT) != 0;
+
+	*fence = register_object<VkFence>(object);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_fence(VkDevice /*device*/, VkFence fence, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyFence");
+	destroy_object<Fence>(fence);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL reset_fences(VkDevice /*device*/, uint32_t fence_count, const VkFence *fences)
+{
+	COUNT_CALL("vkResetFences");
+
+	for (uint32_t i = 0; i < fence_count; ++i)
+	{
+		from_handle<Fence>(fences[i])->signaled = false;
+	}
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_fence_status(VkDevice /*device*/, VkFence fence)
+{
+	COUNT_CALL("vkGetFenceStatus");
+	return from_handle<Fence>(fence)->signaled ? VK_SUCCESS : VK_NOT_READY;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL wait_for_fences(VkDevice /*device*/, uint32_t fence_count, const VkFence *fences, VkBool32 wait_all, uint64_t /*timeout*/)
+{
+	COUNT_CALL("vkWaitForFences");
+
+	auto is_signaled = [](VkFence fence) { return from_handle<Fence>(fence)->signaled.load(); };
+
+	bool signaled = wait_all ? std::all_of(fences, fences + fence_count, is_signaled) : std::any_of(fences, fences + fence_count, is_signaled);
+
+	// Submissions complete immediately, a fence which is not signaled yet will never be
+	return signaled ? VK_SUCCESS : VK_TIMEOUT;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_semaphore(VkDevice /*device*/, const VkSemaphoreCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkSemaphore *semaphore)
+{
+	COUNT_CALL("vkCreateSemaphore");
+	return create_object(semaphore);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_semaphore(VkDevice /*device*/, VkSemaphore semaphore, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroySemaphore");
+	destroy_object<Object>(semaphore);
+}
+
+/*
+ * Pipelines and render passes
+ */
+
+VKAPI_ATTR VkResult VKAPI_CALL create_shader_module(VkDevice /*device*/, const VkShaderModuleCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkShaderModule *shader_module)
+{
+	COUNT_CALL("vkCreateShaderModule");
+	return create_object(shader_module);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_shader_module(VkDevice /*device*/, VkShaderModule shader_module, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyShaderModule");
+	destroy_object<Object>(shader_module);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_pipeline_cache(VkDevice /*device*/, const VkPipelineCacheCreateInfo *create_info, const VkAllocationCallbacks * /*allocator*/, VkPipelineCache *pipeline_cache)
+{
+	COUNT_CALL("vkCreatePipelineCache");
+
+	auto object = new PipelineCache{};
+
+	auto initial_data = reinterpret_cast<const uint8_t *>(create_info->pInitialData);
+
+	// Data created by the null driver is kept, anything else is ignored as a real driver would
+	if (create_info->initialDataSize >= PIPELINE_CACHE_HEADER_SIZE &&
+	    std::memcmp(initial_data + 16, PIPELINE_CACHE_UUID, VK_UUID_SIZE) == 0)
+	{
+		object->data.assign(initial_data, initial_data + create_info->initialDataSize);
+	}
+	else
+	{
+		uint32_t header[4] = {to_u32(PIPELINE_CACHE_HEADER_SIZE), VK_PIPELINE_CACHE_HEADER_VERSION_ONE, VENDOR_ID, DEVICE_ID};
+
+		object->data.resize(PIPELINE_CACHE_HEADER_SIZE);
+		std::memcpy(object->data.data(), header, sizeof(header));
+		std::memcpy(object->data.data() + sizeof(header), PIPELINE_CACHE_UUID, VK_UUID_SIZE);
+	}
+
+	*pipeline_cache = register_object<VkPipelineCache>(object);
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_pipeline_cache(VkDevice /*device*/, VkPipelineCache pipeline_cache, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyPipelineCache");
+	destroy_object<PipelineCache>(pipeline_cache);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_pipeline_cache_data(VkDevice /*device*/, VkPipelineCache pipeline_cache, size_t *data_size, void *data)
+{
+	COUNT_CALL("vkGetPipelineCacheData");
+
+	auto &cache_data = from_handle<PipelineCache>(pipeline_cache)->data;
+
+	if (!data)
+	{
+		*data_size = cache_data.size();
+		return VK_SUCCESS;
+	}
+
+	*data_size = std::min(*data_size, cache_data.size());
+	std::memcpy(data, cache_data.data(), *data_size);
+
+	return *data_size < cache_data.size() ? VK_INCOMPLETE : VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL merge_pipeline_caches(VkDevice /*device*/, VkPipelineCache /*dst_cache*/, uint32_t /*src_cache_count*/, const VkPipelineCache * /*src_caches*/)
+{
+	COUNT_CALL("vkMergePipelineCaches");
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_graphics_pipelines(VkDevice /*device*/, VkPipelineCache /*pipeline_cache*/, uint32_t create_info_count,
+                                                         const VkGraphicsPipelineCreateInfo * /*create_infos*/, const VkAllocationCallbacks * /*allocator*/, VkPipeline *pipelines)
+{
+	COUNT_CALL("vkCreateGraphicsPipelines");
+
+	for (uint32_t i = 0; i < create_info_count; ++i)
+	{
+		create_object(&pipelines[i]);
+	}
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_compute_pipelines(VkDevice /*device*/, VkPipelineCache /*pipeline_cache*/, uint32_t create_info_count,
+                                                        const VkComputePipelineCreateInfo * /*create_infos*/, const VkAllocationCallbacks * /*allocator*/, VkPipeline *pipelines)
+{
+	COUNT_CALL("vkCreateComputePipelines");
+
+	for (uint32_t i = 0; i < create_info_count; ++i)
+	{
+		create_object(&pipelines[i]);
+	}
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_pipeline(VkDevice /*device*/, VkPipeline pipeline, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyPipeline");
+	destroy_object<Object>(pipeline);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_pipeline_layout(VkDevice /*device*/, const VkPipelineLayoutCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkPipelineLayout *pipeline_layout)
+{
+	COUNT_CALL("vkCreatePipelineLayout");
+	return create_object(pipeline_layout);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_pipeline_layout(VkDevice /*device*/, VkPipelineLayout pipeline_layout, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyPipelineLayout");
+	destroy_object<Object>(pipeline_layout);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_render_pass(VkDevice /*device*/, const VkRenderPassCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkRenderPass *render_pass)
+{
+	COUNT_CALL("vkCreateRenderPass");
+	return create_object(render_pass);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_render_pass(VkDevice /*device*/, VkRenderPass render_pass, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyRenderPass");
+	destroy_object<Object>(render_pass);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_framebuffer(VkDevice /*device*/, const VkFramebufferCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkFramebuffer *framebuffer)
+{
+	COUNT_CALL("vkCreateFramebuffer");
+	return create_object(framebuffer);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_framebuffer(VkDevice /*device*/, VkFramebuffer framebuffer, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyFramebuffer");
+	destroy_object<Object>(framebuffer);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_query_pool(VkDevice /*device*/, const VkQueryPoolCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkQueryPool *query_pool)
+{
+	COUNT_CALL("vkCreateQueryPool");
+	return create_object(query_pool);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_query_pool(VkDevice /*device*/, VkQueryPool query_pool, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyQueryPool");
+	destroy_object<Object>(query_pool);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL get_query_pool_results(VkDevice /*device*/, VkQueryPool /*query_pool*/, uint32_t /*first_query*/, uint32_t /*query_count*/, size_t data_size, void *data, VkDeviceSize /*stride*/, VkQueryResultFlags /*flags*/)
+{
+	COUNT_CALL("vkGetQueryPoolResults");
+
+	// Nothing is executed, every query reports zero
+	std::memset(data, 0, data_size);
+
+	return VK_SUCCESS;
+}
+
+/*
+ * Descriptors
+ */
+
+VKAPI_ATTR VkResult VKAPI_CALL create_descriptor_set_layout(VkDevice /*device*/, const VkDescriptorSetLayoutCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkDescriptorSetLayout *set_layout)
+{
+	COUNT_CALL("vkCreateDescriptorSetLayout");
+	return create_object(set_layout);
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_descriptor_set_layout(VkDevice /*device*/, VkDescriptorSetLayout set_layout, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyDescriptorSetLayout");
+	destroy_object<Object>(set_layout);
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL create_descriptor_pool(VkDevice /*device*/, const VkDescriptorPoolCreateInfo *create_info, const VkAllocationCallbacks * /*allocator*/, VkDescriptorPool *descriptor_pool)
+{
+	COUNT_CALL("vkCreateDescriptorPool");
+
+	auto object      = new DescriptorPool{};
+	object->max_sets = create_info->maxSets;
+
+	*descriptor_pool = register_object<VkDescriptorPool>(object);
+	return VK_SUCCESS;
+}
+
+void release_descriptor_sets(DescriptorPool *pool)
+{
+	for (auto descriptor_set : pool->descriptor_sets)
+	{
+		release_object(descriptor_set);
+	}
+
+	pool->descriptor_sets.clear();
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL reset_descriptor_pool(VkDevice /*device*/, VkDescriptorPool descriptor_pool, VkDescriptorPoolResetFlags /*flags*/)
+{
+	COUNT_CALL("vkResetDescriptorPool");
+	release_descriptor_sets(from_handle<DescriptorPool>(descriptor_pool));
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_descriptor_pool(VkDevice /*device*/, VkDescriptorPool descriptor_pool, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyDescriptorPool");
+
+	if (descriptor_pool != VK_NULL_HANDLE)
+	{
+		release_descriptor_sets(from_handle<DescriptorPool>(descriptor_pool));
+		destroy_object<DescriptorPool>(descriptor_pool);
+	}
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL allocate_descriptor_sets(VkDevice /*device*/, const VkDescriptorSetAllocateInfo *allocate_info, VkDescriptorSet *descriptor_sets)
+{
+	COUNT_CALL("vkAllocateDescriptorSets");
+
+	auto pool = from_handle<DescriptorPool>(allocate_info->descriptorPool);
+
+	if (pool->descriptor_sets.size() + allocate_info->descriptorSetCount > pool->max_sets)
+	{
+		return VK_ERROR_OUT_OF_POOL_MEMORY_KHR;
+	}
+
+	for (uint32_t i = 0; i < allocate_info->descriptorSetCount; ++i)
+	{
+		auto descriptor_set = new Object{};
+		pool->descriptor_sets.insert(descriptor_set);
+
+		descriptor_sets[i] = register_object<VkDescriptorSet>(descriptor_set);
+	}
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL free_descriptor_sets(VkDevice /*device*/, VkDescriptorPool descriptor_pool, uint32_t descriptor_set_count, const VkDescriptorSet *descriptor_sets)
+{
+	COUNT_CALL("vkFreeDescriptorSets");
+
+	auto pool = from_handle<DescriptorPool>(descriptor_pool);
+
+	for (uint32_t i = 0; i < descriptor_set_count; ++i)
+	{
+		auto descriptor_set = from_handle<Object>(descriptor_sets[i]);
+
+		if (pool->descriptor_sets.erase(descriptor_set) > 0)
+		{
+			release_object(descriptor_set);
+		}
+	}
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL update_descriptor_sets(VkDevice /*device*/, uint32_t /*write_count*/, const VkWriteDescriptorSet * /*writes*/, uint32_t /*copy_count*/, const VkCopyDescriptorSet * /*copies*/)
+{
+	COUNT_CALL("vkUpdateDescriptorSets");
+}
+
+/*
+ * Command pools and buffers
+ */
+
+VKAPI_ATTR VkResult VKAPI_CALL create_command_pool(VkDevice /*device*/, const VkCommandPoolCreateInfo * /*create_info*/, const VkAllocationCallbacks * /*allocator*/, VkCommandPool *command_pool)
+{
+	COUNT_CALL("vkCreateCommandPool");
+	*command_pool = register_object<VkCommandPool>(new CommandPool{});
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL destroy_command_pool(VkDevice /*device*/, VkCommandPool command_pool, const VkAllocationCallbacks * /*allocator*/)
+{
+	COUNT_CALL("vkDestroyCommandPool");
+
+	if (command_pool != VK_NULL_HANDLE)
+	{
+		// Command buffers are freed with their pool
+		for (auto command_buffer : from_handle<CommandPool>(command_pool)->command_buffers)
+		{
+			release_object(command_buffer);
+		}
+
+		destroy_object<CommandPool>(command_pool);
+	}
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL reset_command_pool(VkDevice /*device*/, VkCommandPool command_pool, VkCommandPoolResetFlags /*flags*/)
+{
+	COUNT_CALL("vkResetCommandPool");
+
+	for (auto command_buffer : from_handle<CommandPool>(command_pool)->command_buffers)
+	{
+		command_buffer->commands.clear();
+	}
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL allocate_command_buffers(VkDevice /*device*/, const VkCommandBufferAllocateInfo *allocate_info, VkCommandBuffer *command_buffers)
+{
+	COUNT_CALL("vkAllocateCommandBuffers");
+
+	auto pool = from_handle<CommandPool>(allocate_info->commandPool);
+
+	for (uint32_t i = 0; i < allocate_info->commandBufferCount; ++i)
+	{
+		auto command_buffer  = new CommandBuffer{};
+		command_buffer->pool = pool;
+		pool->command_buffers.push_back(command_buffer);
+
+		command_buffers[i] = register_object<VkCommandBuffer>(command_buffer);
+	}
+
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL free_command_buffers(VkDevice /*device*/, VkCommandPool command_pool, uint32_t command_buffer_count, const VkCommandBuffer *command_buffers)
+{
+	COUNT_CALL("vkFreeCommandBuffers");
+
+	auto &pool_command_buffers = from_handle<CommandPool>(command_pool)->command_buffers;
+
+	for (uint32_t i = 0; i < command_buffer_count; ++i)
+	{
+		auto command_buffer = from_handle<CommandBuffer>(command_buffers[i]);
+
+		auto it = std::find(pool_command_buffers.begin(), pool_command_buffers.end(), command_buffer);
+
+		if (it != pool_command_buffers.end())
+		{
+			pool_command_buffers.erase(it);
+			release_object(command_buffer);
+		}
+	}
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL begin_command_buffer(VkCommandBuffer command_buffer, const VkCommandBufferBeginInfo * /*begin_info*/)
+{
+	COUNT_CALL("vkBeginCommandBuffer");
+	from_handle<CommandBuffer>(command_buffer)->commands.clear();
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL end_command_buffer(VkCommandBuffer /*command_buffer*/)
+{
+	COUNT_CALL("vkEndCommandBuffer");
+	return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL reset_command_buffer(VkCommandBuffer command_buffer, VkCommandBufferResetFlags /*flags*/)
+{
+	COUNT_CALL("vkResetCommandBuffer");
+	from_handle<CommandBuffer>(command_buffer)->commands.clear();
+	return VK_SUCCESS;
+}
+
+/*
+ * Commands
+ */
+
+VKAPI_ATTR void VKAPI_CALL cmd_begin_render_pass(VkCommandBuffer command_buffer, const VkRenderPassBeginInfo * /*begin_info*/, VkSubpassContents /*contents*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdBeginRenderPass");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_next_subpass(VkCommandBuffer command_buffer, VkSubpassContents /*contents*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdNextSubpass");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_end_render_pass(VkCommandBuffer command_buffer)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdEndRenderPass");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_execute_commands(VkCommandBuffer command_buffer, uint32_t /*command_buffer_count*/, const VkCommandBuffer * /*command_buffers*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdExecuteCommands");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_bind_pipeline(VkCommandBuffer command_buffer, VkPipelineBindPoint /*bind_point*/, VkPipeline /*pipeline*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdBindPipeline");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_bind_descriptor_sets(VkCommandBuffer command_buffer, VkPipelineBindPoint /*bind_point*/, VkPipelineLayout /*layout*/, uint32_t /*first_set*/,
+                                                    uint32_t /*descriptor_set_count*/, const VkDescriptorSet * /*descriptor_sets*/,
+                                                    uint32_t /*dynamic_offset_count*/, const uint32_t * /*dynamic_offsets*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdBindDescriptorSets");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_bind_vertex_buffers(VkCommandBuffer command_buffer, uint32_t /*first_binding*/, uint32_t /*binding_count*/, const VkBuffer * /*buffers*/, const VkDeviceSize * /*offsets*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdBindVertexBuffers");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_bind_index_buffer(VkCommandBuffer command_buffer, VkBuffer /*buffer*/, VkDeviceSize /*offset*/, VkIndexType /*index_type*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdBindIndexBuffer");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_push_constants(VkCommandBuffer command_buffer, VkPipelineLayout /*layout*/, VkShaderStageFlags /*stage_flags*/, uint32_t /*offset*/, uint32_t /*size*/, const void * /*values*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdPushConstants");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_set_viewport(VkCommandBuffer command_buffer, uint32_t /*first_viewport*/, uint32_t /*viewport_count*/, const VkViewport * /*viewports*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdSetViewport");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_set_scissor(VkCommandBuffer command_buffer, uint32_t /*first_scissor*/, uint32_t /*scissor_count*/, const VkRect2D * /*scissors*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdSetScissor");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_set_line_width(VkCommandBuffer command_buffer, float /*line_width*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdSetLineWidth");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_set_depth_bias(VkCommandBuffer command_buffer, float /*constant_factor*/, float /*clamp*/, float /*slope_factor*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdSetDepthBias");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_set_blend_constants(VkCommandBuffer command_buffer, const float /*blend_constants*/[4])
+{
+	RECORD_COMMAND(command_buffer, "vkCmdSetBlendConstants");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_set_depth_bounds(VkCommandBuffer command_buffer, float /*min_depth_bounds*/, float /*max_depth_bounds*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdSetDepthBounds");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_draw(VkCommandBuffer command_buffer, uint32_t /*vertex_count*/, uint32_t /*instance_count*/, uint32_t /*first_vertex*/, uint32_t /*first_instance*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdDraw");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_draw_indexed(VkCommandBuffer command_buffer, uint32_t /*index_count*/, uint32_t /*instance_count*/, uint32_t /*first_index*/, int32_t /*vertex_offset*/, uint32_t /*first_instance*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdDrawIndexed");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_draw_indexed_indirect(VkCommandBuffer command_buffer, VkBuffer /*buffer*/, VkDeviceSize /*offset*/, uint32_t /*draw_count*/, uint32_t /*stride*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdDrawIndexedIndirect");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_dispatch(VkCommandBuffer command_buffer, uint32_t /*group_count_x*/, uint32_t /*group_count_y*/, uint32_t /*group_count_z*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdDispatch");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_dispatch_indirect(VkCommandBuffer command_buffer, VkBuffer /*buffer*/, VkDeviceSize /*offset*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdDispatchIndirect");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_copy_buffer(VkCommandBuffer command_buffer, VkBuffer /*src_buffer*/, VkBuffer /*dst_buffer*/, uint32_t /*region_count*/, const VkBufferCopy * /*regions*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdCopyBuffer");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_copy_image(VkCommandBuffer command_buffer, VkImage /*src_image*/, VkImageLayout /*src_image_layout*/, VkImage /*dst_image*/,
+                                          VkImageLayout /*dst_image_layout*/, uint32_t /*region_count*/, const VkImageCopy * /*regions*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdCopyImage");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_blit_image(VkCommandBuffer command_buffer, VkImage /*src_image*/, VkImageLayout /*src_image_layout*/, VkImage /*dst_image*/,
+                                          VkImageLayout /*dst_image_layout*/, uint32_t /*region_count*/, const VkImageBlit * /*regions*/, VkFilter /*filter*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdBlitImage");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_copy_buffer_to_image(VkCommandBuffer command_buffer, VkBuffer /*src_buffer*/, VkImage /*dst_image*/, VkImageLayout /*dst_image_layout*/,
+                                                    uint32_t /*region_count*/, const VkBufferImageCopy * /*regions*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdCopyBufferToImage");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_update_buffer(VkCommandBuffer command_buffer, VkBuffer /*dst_buffer*/, VkDeviceSize /*dst_offset*/, VkDeviceSize /*data_size*/, const void * /*data*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdUpdateBuffer");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_clear_attachments(VkCommandBuffer command_buffer, uint32_t /*attachment_count*/, const VkClearAttachment * /*attachments*/,
+                                                 uint32_t /*rect_count*/, const VkClearRect * /*rects*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdClearAttachments");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_reset_query_pool(VkCommandBuffer command_buffer, VkQueryPool /*query_pool*/, uint32_t /*first_query*/, uint32_t /*query_count*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdResetQueryPool");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_begin_query(VkCommandBuffer command_buffer, VkQueryPool /*query_pool*/, uint32_t /*query*/, VkQueryControlFlags /*flags*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdBeginQuery");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_end_query(VkCommandBuffer command_buffer, VkQueryPool /*query_pool*/, uint32_t /*query*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdEndQuery");
+}
+
+VKAPI_ATTR void VKAPI_CALL cmd_pipeline_barrier(VkCommandBuffer command_buffer, VkPipelineStageFlags /*src_stage_mask*/, VkPipelineStageFlags /*dst_stage_mask*/,
+                                                VkDependencyFlags /*dependency_flags*/, uint32_t /*memory_barrier_count*/, const VkMemoryBarrier * /*memory_barriers*/,
+                                                uint32_t /*buffer_memory_barrier_count*/, const VkBufferMemoryBarrier * /*buffer_memory_barriers*/,
+                                                uint32_t /*image_memory_barrier_count*/, const VkImageMemoryBarrier * /*image_memory_barriers*/)
+{
+	RECORD_COMMAND(command_buffer, "vkCmdPipelineBarrier");
+}
+
+/*
+ * Entry points
+ */
+
+const std::unordered_map<std::string, PFN_vkVoidFunction> &get_entry_points();
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL get_instance_proc_addr(VkInstance /*instance*/, const char *name)
+{
+	COUNT_CALL("vkGetInstanceProcAddr");
+
+	auto &entry_points = get_entry_points();
+
+	auto it = entry_points.find(name);
+
+	return it != entry_points.end() ? it->second : nullptr;
+}
+
+VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL get_device_proc_addr(VkDevice /*device*/, const char *name)
+{
+	COUNT_CALL("vkGetDeviceProcAddr");
+
+	auto &entry_points = get_entry_points();
+
+	auto it = entry_points.find(name);
+
+	return it != entry_points.end() ? it->second : nullptr;
+}
+
+#define ENTRY_POINT(name, function) {name, reinterpret_cast<PFN_vkVoidFunction>(function)}
+
+const std::unordered_map<std::string, PFN_vkVoidFunction> &get_entry_points()
+{
+	static const std::unordered_map<std::string, PFN_vkVoidFunction> entry_points = {
+	    ENTRY_POINT("vkGetInstanceProcAddr", get_instance_proc_addr),
+	    ENTRY_POINT("vkGetDeviceProcAddr", get_device_proc_addr),
+	    ENTRY_POINT("vkCreateInstance", create_instance),
+	    ENTRY_POINT("vkDestroyInstance", destroy_instance),
+	    ENTRY_POINT("vkEnumerateInstanceExtensionProperties", enumerate_instance_extension_properties),
+	    ENTRY_POINT("vkEnumerateInstanceLayerProperties", enumerate_instance_layer_properties),
+	    ENTRY_POINT("vkEnumeratePhysicalDevices", enumerate_physical_devices),
+	    ENTRY_POINT("vkGetPhysicalDeviceFeatures", get_physical_device_features),
+	    ENTRY_POINT("vkGetPhysicalDeviceFeatures2KHR", get_physical_device_features2),
+	    ENTRY_POINT("vkGetPhysicalDeviceProperties", get_physical_device_properties),
+	    ENTRY_POINT("vkGetPhysicalDeviceProperties2KHR", get_physical_device_properties2),
+	    ENTRY_POINT("vkGetPhysicalDeviceQueueFamilyProperties", get_physical_device_queue_family_properties),
+	    ENTRY_POINT("vkGetPhysicalDeviceMemoryProperties", get_physical_device_memory_properties),
+	    ENTRY_POINT("vkGetPhysicalDeviceFormatProperties", get_physical_device_format_properties),
+	    ENTRY_POINT("vkGetPhysicalDeviceImageFormatProperties", get_physical_device_image_format_properties),
+	    ENTRY_POINT("vkEnumerateDeviceExtensionProperties", enumerate_device_extension_properties),
+	    ENTRY_POINT("vkCreateDebugReportCallbackEXT", create_debug_report_callback),
+	    ENTRY_POINT("vkDestroyDebugReportCallbackEXT", destroy_debug_report_callback),
+	    ENTRY_POINT("vkCreateDevice", create_device),
+	    ENTRY_POINT("vkDestroyDevice", destroy_device),
+	    ENTRY_POINT("vkGetDeviceQueue", get_device_queue),
+	    ENTRY_POINT("vkQueueSubmit", queue_submit),
+	    ENTRY_POINT("vkQueueWaitIdle", queue_wait_idle),
+	    ENTRY_POINT("vkDeviceWaitIdle", device_wait_idle),
+	    ENTRY_POINT("vkAllocateMemory", allocate_memory),
+	    ENTRY_POINT("vkFreeMemory", free_memory),
+	    ENTRY_POINT("vkMapMemory", map_memory),
+	    ENTRY_POINT("vkUnmapMemory", unmap_memory),
+	    ENTRY_POINT("vkFlushMappedMemoryRanges", flush_mapped_memory_ranges),
+	    ENTRY_POINT("vkInvalidateMappedMemoryRanges", invalidate_mapped_memory_ranges),
+	    ENTRY_POINT("vkCreateBuffer", create_buffer),
+	    ENTRY_POINT("vkDestroyBuffer", destroy_buffer),
+	    ENTRY_POINT("vkGetBufferMemoryRequirements", get_buffer_memory_requirements),
+	    ENTRY_POINT("vkBindBufferMemory", bind_buffer_memory),
+	    ENTRY_POINT("vkCreateImage", create_image),
+	    ENTRY_POINT("vkDestroyImage", destroy_image),
+	    ENTRY_POINT("vkGetImageMemoryRequirements", get_image_memory_requirements),
+	    ENTRY_POINT("vkBindImageMemory", bind_image_memory),
+	    ENTRY_POINT("vkGetImageSubresourceLayout", get_image_subresource_layout),
+	    ENTRY_POINT("vkCreateImageView", create_image_view),
+	    ENTRY_POINT("vkDestroyImageView", destroy_image_view),
+	    ENTRY_POINT("vkCreateSampler", create_sampler),
+	    ENTRY_POINT("vkDestroySampler", destroy_sampler),
+	    ENTRY_POINT("vkCreateFence", create_fence),
+	    ENTRY_POINT("vkDestroyFence", destroy_fence),
+	    ENTRY_POINT("vkResetFences", reset_fences),
+	    ENTRY_POINT("vkGetFenceStatus", get_fence_status),
+	    ENTRY_POINT("vkWaitForFences", wait_for_fences),
+	    ENTRY_POINT("vkCreateSemaphore", create_semaphore),
+	    ENTRY_POINT("vkDestroySemaphore", destroy_semaphore),
+	    ENTRY_POINT("vkCreateShaderModule", create_shader_module),
+	    ENTRY_POINT("vkDestroyShaderModule", destroy_shader_module),
+	    ENTRY_POINT("vkCreatePipelineCache", create_pipeline_cache),
+	    ENTRY_POINT("vkDestroyPipelineCache", destroy_pipeline_cache),
+	    ENTRY_POINT("vkGetPipelineCacheData", get_pipeline_cache_data),
+	    ENTRY_POINT("vkMergePipelineCaches", merge_pipeline_caches),
+	    ENTRY_POINT("vkCreateGraphicsPipelines", create_graphics_pipelines),
+	    ENTRY_POINT("vkCreateComputePipelines", create_compute_pipelines),
+	    ENTRY_POINT("vkDestroyPipeline", destroy_pipeline),
+	    ENTRY_POINT("vkCreatePipelineLayout", create_pipeline_layout),
+	    ENTRY_POINT("vkDestroyPipelineLayout", destroy_pipeline_layout),
+	    ENTRY_POINT("vkCreateRenderPass", create_render_pass),
+	    ENTRY_POINT("vkDestroyRenderPass", destroy_render_pass),
+	    ENTRY_POINT("vkCreateFramebuffer", create_framebuffer),
+	    ENTRY_POINT("vkDestroyFramebuffer", destroy_framebuffer),
+	    ENTRY_POINT("vkCreateQueryPool", create_query_pool),
+	    ENTRY_POINT("vkDestroyQueryPool", destroy_query_pool),
+	    ENTRY_POINT("vkGetQueryPoolResults", get_query_pool_results),
+	    ENTRY_POINT("vkCreateDescriptorSetLayout", create_descriptor_set_layout),
+	    ENTRY_POINT("vkDestroyDescriptorSetLayout", destroy_descriptor_set_layout),
+	    ENTRY_POINT("vkCreateDescriptorPool", create_descriptor_pool),
+	    ENTRY_POINT("vkResetDescriptorPool", reset_descriptor_pool),
+	    ENTRY_POINT("vkDestroyDescriptorPool", destroy_descriptor_pool),
+	    ENTRY_POINT("vkAllocateDescriptorSets", allocate_descriptor_sets),
+	    ENTRY_POINT("vkFreeDescriptorSets", free_descriptor_sets),
+	    ENTRY_POINT("vkUpdateDescriptorSets", update_descriptor_sets),
+	    ENTRY_POINT("vkCreateCommandPool", create_command_pool),
+	    ENTRY_POINT("vkDestroyCommandPool", destroy_command_pool),
+	    ENTRY_POINT("vkResetCommandPool", reset_command_pool),
+	    ENTRY_POINT("vkAllocateCommandBuffers", allocate_command_buffers),
+	    ENTRY_POINT("vkFreeCommandBuffers", free_command_buffers),
+	    ENTRY_POINT("vkBeginCommandBuffer", begin_command_buffer),
+	    ENTRY_POINT("vkEndCommandBuffer", end_command_buffer),
+	    ENTRY_POINT("vkResetCommandBuffer", reset_command_buffer),
+	    ENTRY_POINT("vkCmdBeginRenderPass", cmd_begin_render_pass),
+	    ENTRY_POINT("vkCmdNextSubpass", cmd_next_subpass),
+	    ENTRY_POINT("vkCmdEndRenderPass", cmd_end_render_pass),
+	    ENTRY_POINT("vkCmdExecuteCommands", cmd_execute_commands),
+	    ENTRY_POINT("vkCmdBindPipeline", cmd_bind_pipeline),
+	    ENTRY_POINT("vkCmdBindDescriptorSets", cmd_bind_descriptor_sets),
+	    ENTRY_POINT("vkCmdBindVertexBuffers", cmd_bind_vertex_buffers),
+	    ENTRY_POINT("vkCmdBindIndexBuffer", cmd_bind_index_buffer),
+	    ENTRY_POINT("vkCmdPushConstants", cmd_push_constants),
+	    ENTRY_POINT("vkCmdSetViewport", cmd_set_viewport),
+	    ENTRY_POINT("vkCmdSetScissor", cmd_set_scissor),
+	    ENTRY_POINT("vkCmdSetLineWidth", cmd_set_line_width),
+	    ENTRY_POINT("vkCmdSetDepthBias", cmd_set_depth_bias),
+	    ENTRY_POINT("vkCmdSetBlendConstants", cmd_set_blend_constants),
+	    ENTRY_POINT("vkCmdSetDepthBounds", cmd_set_depth_bounds),
+	    ENTRY_POINT("vkCmdDraw", cmd_draw),
+	    ENTRY_POINT("vkCmdDrawIndexed", cmd_draw_indexed),
+	    ENTRY_POINT("vkCmdDrawIndexedIndirect", cmd_draw_indexed_indirect),
+	    ENTRY_POINT("vkCmdDispatch", cmd_dispatch),
+	    ENTRY_POINT("vkCmdDispatchIndirect", cmd_dispatch_indirect),
+	    ENTRY_POINT("vkCmdCopyBuffer", cmd_copy_buffer),
+	    ENTRY_POINT("vkCmdCopyImage", cmd_copy_image),
+	    ENTRY_POINT("vkCmdBlitImage", cmd_blit_image),
+	    ENTRY_POINT("vkCmdCopyBufferToImage", cmd_copy_buffer_to_image),
+	    ENTRY_POINT("vkCmdUpdateBuffer", cmd_update_buffer),
+	    ENTRY_POINT("vkCmdClearAttachments", cmd_clear_attachments),
+	    ENTRY_POINT("vkCmdResetQueryPool", cmd_reset_query_pool),
+	    ENTRY_POINT("vkCmdBeginQuery", cmd_begin_query),
+	    ENTRY_POINT("vkCmdEndQuery", cmd_end_query),
+	    ENTRY_POINT("vkCmdPipelineBarrier", cmd_pipeline_barrier)};
+
+	return entry_points;
+}
+}        // namespace
+
+void install()
+{
+	// volk loads every other entry point through vkGetInstanceProcAddr
+	vkGetInstanceProcAddr                  = get_instance_proc_addr;
+	vkCreateInstance                       = create_instance;
+	vkEnumerateInstanceExtensionProperties = enumerate_instance_extension_properties;
+	vkEnumerateInstanceLayerProperties     = enumerate_instance_layer_properties;
+
+	installed = true;
+
+	LOGI("Null driver installed, nothing will be rendered");
+}
+
+bool is_installed()
+{
+	return installed;
+}
+
+void set_command_recording(bool enabled)
+{
+	command_recording = enabled;
+}
+
+const std::vector<const char *> &get_recorded_commands(VkCommandBuffer command_buffer)
+{
+	return from_handle<CommandBuffer>(command_buffer)->commands;
+}
+
+std::map<std::string, uint64_t> get_call_counts()
+{
+	std::lock_guard<std::mutex> guard(call_counts_mutex);
+
+	std::map<std::string, uint64_t> call_counts;
+
+	for (auto &call_count : get_call_count_map())
+	{
+		call_counts[call_count.first] = call_count.second->load(std::memory_order_relaxed);
+	}
+
+	return call_counts;
+}
+
+uint64_t get_total_call_count()
+{
+	return total_call_count.load(std::memory_order_relaxed);
+}
+
+int64_t get_live_object_count()
+{
+	return live_object_count.load(std::memory_order_relaxed);
+}
+}        // namespace null_driver
+}        // namespace vkb
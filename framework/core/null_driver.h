@@ -0,0 +1,81 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/vk_common.h"
+
+namespace vkb
+{
+/**
+ * @brief Implementation of the Vulkan entry points which runs without a GPU or a Vulkan library.
+ *
+ * It makes the framework run on any machine to measure and inspect its CPU overhead:
+ * handles are allocated when objects are created and freed when they are destroyed,
+ * device memory is host memory so it can be mapped, submissions complete immediately,
+ * and commands are recorded but never executed. Every call is counted, and command
+ * buffers can keep the names of the commands recorded into them.
+ *
+ * The null driver has no surface support, so it is only used by headless applications.
+ */
+namespace null_driver
+{
+/**
+ * @brief Makes volk use the entry points of the null driver, instead of loading the Vulkan library
+ */
+void install();
+
+/**
+ * @return Whether the null driver has been installed
+ */
+bool is_installed();
+
+/**
+ * @brief Makes command buffers keep the names of the commands recorded into them
+ */
+void set_command_recording(bool enabled);
+
+/**
+ * @param command_buffer A command buffer allocated from the null driver
+ * @return The names of the commands recorded since the command buffer was begun,
+ *         empty unless command recording is enabled
+ */
+const std::vector<const char *> &get_recorded_commands(VkCommandBuffer command_buffer);
+
+/**
+ * @return Number of calls of each entry point since the null driver was installed
+ */
+std::map<std::string, uint64_t> get_call_counts();
+
+/**
+ * @return Number of calls of all entry points since the null driver was installed
+ */
+uint64_t get_total_call_count();
+
+/**
+ * @return Number of objects which have been created and not destroyed yet
+ */
+int64_t get_live_object_count();
+}        // namespace null_driver
+}        // namespace vkb
@@ -23,6 +23,7 @@
 #include "device.h"
 #include "pipeline_layout.h"
 #include "shader_module.h"
+#include "timer.h"
 
 namespace vkb
 {
@@ -112,7 +113,16 @@ ComputePipeline::ComputePipeline(Device &        device,
 	create_info.layout = pipeline_state.get_pipeline_layout().get_handle();
 	create_info.stage  = stage;
 
-	result = vkCreateComputePipelines(device.get_handle(), pipeline_cache, 1, &create_info, nullptr, &handle);
+	{
+		auto creation_lock = device.get_pipeline_cache_manager().lock_creation();
+
+		Timer timer;
+		timer.start();
+
+		result = vkCreateComputePipelines(device.get_handle(), pipeline_cache, 1, &create_info, nullptr, &handle);
+
+		device.get_pipeline_cache_manager().add_creation_time(timer.stop<Timer::Milliseconds>());
+	}
 
 	if (result != VK_SUCCESS)
 	{
@@ -286,7 +296,18 @@ GraphicsPipeline::GraphicsPipeline(Device &        device,
 	create_info.renderPass = pipeline_state.get_render_pass()->get_handle();
 	create_info.subpass    = pipeline_state.get_subpass_index();
 
-	auto result = vkCreateGraphicsPipelines(device.get_handle(), pipeline_cache, 1, &create_info, nullptr, &handle);
+	VkResult result;
+
+	{
+		auto creation_lock = device.get_pipeline_cache_manager().lock_creation();
+
+		Timer timer;
+		timer.start();
+
+		result = vkCreateGraphicsPipelines(device.get_handle(), pipeline_cache, 1, &create_info, nullptr, &handle);
+
+		device.get_pipeline_cache_manager().add_creation_time(timer.stop<Timer::Milliseconds>());
+	}
 
 	if (result != VK_SUCCESS)
 	{
@@ -0,0 +1,70 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "query_pool.h"
+
+#include "device.h"
+
+namespace vkb
+{
+QueryPool::QueryPool(Device &d, const VkQueryPoolCreateInfo &info) :
+    device{d},
+    query_count{info.queryCount}
+{
+	VK_CHECK(vkCreateQueryPool(device.get_handle(), &info, nullptr, &handle));
+}
+
+QueryPool::QueryPool(QueryPool &&other) :
+    device{other.device},
+    handle{other.handle},
+    query_count{other.query_count}
+{
+	other.handle = VK_NULL_HANDLE;
+}
+
+QueryPool::~QueryPool()
+{
+	if (handle != VK_NULL_HANDLE)
+	{
+		vkDestroyQueryPool(device.get_handle(), handle, nullptr);
+	}
+}
+
+VkQueryPool QueryPool::get_handle() const
+{
+	assert(handle != VK_NULL_HANDLE && "QueryPool handle is invalid");
+	return handle;
+}
+
+uint32_t QueryPool::get_query_count() const
+{
+	return query_count;
+}
+
+VkResult QueryPool::get_results(uint32_t first_query, uint32_t num_queries,
+                                size_t result_bytes, void *results, VkDeviceSize stride,
+                                VkQueryResultFlags flags)
+{
+	assert(first_query + num_queries <= query_count && "Query range is out of bounds");
+
+	return vkGetQueryPoolResults(device.get_handle(), get_handle(), first_query, num_queries,
+	                             result_bytes, results, stride, flags);
+}
+}        // namespace vkb
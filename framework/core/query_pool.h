@@ -0,0 +1,84 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+
+namespace vkb
+{
+class Device;
+
+/**
+ * @brief Represents a Vulkan Query Pool
+ */
+class QueryPool
+{
+  public:
+	/**
+	 * @brief Creates a Vulkan Query Pool
+	 * @param d The device to use
+	 * @param info Creation details
+	 */
+	QueryPool(Device &d, const VkQueryPoolCreateInfo &info);
+
+	QueryPool(const QueryPool &) = delete;
+
+	QueryPool(QueryPool &&pool);
+
+	~QueryPool();
+
+	QueryPool &operator=(const QueryPool &) = delete;
+
+	QueryPool &operator=(QueryPool &&) = delete;
+
+	/**
+	 * @return The vulkan query pool handle
+	 */
+	VkQueryPool get_handle() const;
+
+	/**
+	 * @return The number of queries in the pool
+	 */
+	uint32_t get_query_count() const;
+
+	/**
+	 * @brief Reads back the results of a range of queries
+	 * @param first_query The first query to read
+	 * @param num_queries The number of queries to read
+	 * @param result_bytes The size of the results array in bytes
+	 * @param results The array the results are written to
+	 * @param stride The distance between the results of two queries in bytes
+	 * @param flags How and when the results are returned
+	 * @return VK_NOT_READY if a query was not available and flags did not request to wait
+	 */
+	VkResult get_results(uint32_t first_query, uint32_t num_queries,
+	                     size_t result_bytes, void *results, VkDeviceSize stride,
+	                     VkQueryResultFlags flags);
+
+  private:
+	Device &device;
+
+	VkQueryPool handle{VK_NULL_HANDLE};
+
+	uint32_t query_count{0};
+};
+}        // namespace vkb
@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+
 #include "common/helpers.h"
 #include "common/vk_common.h"
 #include "core/swapchain.h"
@@ -74,5 +77,9 @@ class Queue
 	VkBool32 can_present{VK_FALSE};
 
 	VkQueueFamilyProperties properties{};
+
+	/// Access to a queue must be externally synchronized, render contexts on several threads may share it.
+	/// Copies refer to the same queue, so they share the mutex.
+	std::shared_ptr<std::mutex> submit_mutex{std::make_shared<std::mutex>()};
 };
 }        // namespace vkb
@@ -22,6 +22,7 @@
 
 #include <numeric>
 
+#include "common/logging.h"
 #include "device.h"
 #include "rendering/render_target.h"
 
@@ -65,6 +66,51 @@ RenderPass::RenderPass(Device &device, const std::vector<Attachment> &attachment
 			attachment.finalLayout   = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 		}
 
+		// Compressed formats cannot be attachments, and unknown formats are not counted
+		auto bits_per_pixel = get_bits_per_pixel(attachment.format);
+		if (bits_per_pixel > 0)
+		{
+			auto bytes_per_pixel = static_cast<VkDeviceSize>((bits_per_pixel + 7) / 8) * attachment.samples;
+
+			// The stencil aspect, one byte of depth-stencil formats, has its own load and store operations
+			VkDeviceSize stencil_bytes = 0;
+			if (is_depth_stencil_format(attachment.format) && !is_depth_only_format(attachment.format))
+			{
+				stencil_bytes = static_cast<VkDeviceSize>(attachment.samples);
+			}
+
+			VkDeviceSize depth_color_bytes = bytes_per_pixel - stencil_bytes;
+
+			if (attachment.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+			{
+				bandwidth_per_pixel.load_bytes += depth_color_bytes;
+			}
+
+			if (attachment.storeOp == VK_ATTACHMENT_STORE_OP_STORE)
+			{
+				bandwidth_per_pixel.store_bytes += depth_color_bytes;
+			}
+
+			if (attachment.stencilLoadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+			{
+				bandwidth_per_pixel.load_bytes += stencil_bytes;
+			}
+
+			if (attachment.stencilStoreOp == VK_ATTACHMENT_STORE_OP_STORE)
+			{
+				bandwidth_per_pixel.store_bytes += stencil_bytes;
+			}
+
+			bool accessed = attachment.loadOp == VK_ATTACHMENT_LOAD_OP_LOAD || attachment.storeOp == VK_ATTACHMENT_STORE_OP_STORE ||
+			                (stencil_bytes > 0 && (attachment.stencilLoadOp == VK_ATTACHMENT_LOAD_OP_LOAD || attachment.stencilStoreOp == VK_ATTACHMENT_STORE_OP_STORE));
+
+			// Lazily allocated memory is only backed when it is accessed
+			if ((attachments[i].usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) && accessed)
+			{
+				LOGW("Transient attachment {} is loaded or stored, its memory will be accessed", i);
+			}
+		}
+
 		attachment_descriptions.push_back(std::move(attachment));
 	}
 
@@ -257,7 +303,8 @@ RenderPass::RenderPass(RenderPass &&other) :
     subpass_count{other.subpass_count},
     input_attachments{other.input_attachments},
     color_attachments{other.color_attachments},
-    depth_stencil_attachments{other.depth_stencil_attachments}
+    depth_stencil_attachments{other.depth_stencil_attachments},
+    bandwidth_per_pixel{other.bandwidth_per_pixel}
 {
 	other.handle = VK_NULL_HANDLE;
 }
@@ -275,4 +322,11 @@ const uint32_t RenderPass::get_color_output_count(uint32_t subpass_index) const
 {
 	return to_u32(color_attachments[subpass_index].size());
 }
+
+AttachmentBandwidth RenderPass::estimate_bandwidth(const VkExtent2D &extent) const
+{
+	VkDeviceSize pixel_count = static_cast<VkDeviceSize>(extent.width) * extent.height;
+
+	return {bandwidth_per_pixel.load_bytes * pixel_count, bandwidth_per_pixel.store_bytes * pixel_count};
+}
 }        // namespace vkb
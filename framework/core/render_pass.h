@@ -35,6 +35,16 @@ struct LoadStoreInfo
 	VkAttachmentStoreOp store_op = VK_ATTACHMENT_STORE_OP_STORE;
 };
 
+/**
+ * @brief Estimated memory traffic of the attachments of render passes, without compression
+ */
+struct AttachmentBandwidth
+{
+	VkDeviceSize load_bytes{0};
+
+	VkDeviceSize store_bytes{0};
+};
+
 struct SubpassInfo
 {
 	std::vector<uint32_t> input_attachments;
@@ -64,6 +74,17 @@ class RenderPass
 
 	const uint32_t get_color_output_count(uint32_t subpass_index) const;
 
+	/**
+	 * @brief Estimates the bytes loaded and stored by the attachments for a render area
+	 *
+	 * Attachments are assumed to stay on chip between their load and store operations, as on
+	 * tile-based GPUs, so only the load and store operations access memory. Each sample is a
+	 * full texel, which is an upper bound when the attachments are compressed.
+	 *
+	 * @param extent The extent of the render area
+	 */
+	AttachmentBandwidth estimate_bandwidth(const VkExtent2D &extent) const;
+
   private:
 	Device &device;
 
@@ -77,5 +98,8 @@ class RenderPass
 	std::vector<std::vector<VkAttachmentReference>> color_attachments;
 
 	std::vector<std::vector<VkAttachmentReference>> depth_stencil_attachments;
+
+	/// Bytes loaded and stored by the attachments for each pixel of the render area
+	AttachmentBandwidth bandwidth_per_pixel;
 };
 }        // namespace vkb
@@ -128,6 +128,27 @@ void ShaderModule::set_resource_dynamic(const std::string &resource_name)
 	}
 }
 
+void ShaderModule::set_resource_update_after_bind(const std::string &resource_name)
+{
+	auto it = std::find_if(resources.begin(), resources.end(), [&resource_name](const ShaderResource &resource) { return resource.name == resource_name; });
+
+	if (it != resources.end())
+	{
+		if (it->type == ShaderResourceType::Image || it->type == ShaderResourceType::ImageSampler || it->type == ShaderResourceType::Sampler)
+		{
+			it->update_after_bind = true;
+		}
+		else
+		{
+			LOGW("Resource `{}` does not support update after bind.", resource_name);
+		}
+	}
+	else
+	{
+		LOGW("Resource `{}` not found for shader.", resource_name);
+	}
+}
+
 ShaderVariant::ShaderVariant(std::string &&preamble, std::vector<std::string> &&processes) :
     preamble{std::move(preamble)},
     processes{std::move(processes)}
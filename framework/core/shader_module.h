@@ -73,6 +73,9 @@ struct ShaderResource
 
 	bool dynamic;
 
+	/// Partially bound and updatable after being bound, for arrays of bindless resources
+	bool update_after_bind{false};
+
 	std::string name;
 };
 
@@ -188,6 +191,13 @@ class ShaderModule
 
 	void set_resource_dynamic(const std::string &resource_name);
 
+	/**
+	 * @brief Makes an image or sampler binding partially bound and updatable after being bound,
+	 *        requires descriptor indexing to be enabled on the device
+	 * @param resource_name Name of the resource in the shader
+	 */
+	void set_resource_update_after_bind(const std::string &resource_name);
+
   private:
 	Device &device;
 
@@ -21,6 +21,7 @@
 #define TINYGLTF_IMPLEMENTATION
 #include "gltf_loader.h"
 
+#include <cstring>
 #include <limits>
 #include <queue>
 
@@ -36,19 +37,23 @@ VKBP_ENABLE_WARNINGS()
 #include "core/device.h"
 #include "core/image.h"
 #include "platform/filesystem.h"
+#include "scene_graph/components/animation.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/image.h"
+#include "scene_graph/components/image/array.h"
 #include "scene_graph/components/image/astc.h"
 #include "scene_graph/components/light.h"
 #include "scene_graph/components/mesh.h"
 #include "scene_graph/components/pbr_material.h"
 #include "scene_graph/components/perspective_camera.h"
 #include "scene_graph/components/sampler.h"
+#include "scene_graph/components/skin.h"
 #include "scene_graph/components/sub_mesh.h"
 #include "scene_graph/components/texture.h"
 #include "scene_graph/components/transform.h"
 #include "scene_graph/node.h"
 #include "scene_graph/scene.h"
+#include "scene_graph/scripts/animation_player.h"
 
 #include <ctpl_stl.h>
 
@@ -142,6 +147,119 @@ inline size_t get_attribute_stride(const tinygltf::Model *model, uint32_t access
 	return accessor.ByteStride(bufferView);
 };
 
+/**
+ * @brief Reads a float accessor of up to four components, missing components are zero
+ */
+inline std::vector<glm::vec4> get_vec4_data(const tinygltf::Model *model, uint32_t accessorId)
+{
+	auto &accessor   = model->accessors.at(accessorId);
+	auto &bufferView = model->bufferViews.at(accessor.bufferView);
+	auto &buffer     = model->buffers.at(bufferView.buffer);
+
+	size_t stride         = accessor.ByteStride(bufferView);
+	size_t componentCount = std::min(tinygltf::GetNumComponentsInType(accessor.type), 4);
+
+	const uint8_t *data = buffer.data.data() + accessor.byteOffset + bufferView.byteOffset;
+
+	std::vector<glm::vec4> values(accessor.count, glm::vec4{0.0f});
+
+	for (size_t i = 0; i < accessor.count; ++i)
+	{
+		std::memcpy(&values[i].x, data + i * stride, componentCount * sizeof(float));
+	}
+
+	return values;
+};
+
+/**
+ * @brief Reads JOINTS_n data as four 32-bit unsigned integers per vertex
+ */
+inline std::vector<uint8_t> get_joints_data(const tinygltf::Model *model, uint32_t accessorId)
+{
+	auto &accessor   = model->accessors.at(accessorId);
+	auto &bufferView = model->bufferViews.at(accessor.bufferView);
+	auto &buffer     = model->buffers.at(bufferView.buffer);
+
+	size_t stride        = accessor.ByteStride(bufferView);
+	size_t componentSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+
+	const uint8_t *data = buffer.data.data() + accessor.byteOffset + bufferView.byteOffset;
+
+	std::vector<glm::uvec4> joints(accessor.count);
+
+	for (size_t i = 0; i < accessor.count; ++i)
+	{
+		for (glm::length_t c = 0; c < 4; ++c)
+		{
+			const uint8_t *component = data + i * stride + c * componentSize;
+
+			uint16_t joint = *component;
+			if (componentSize == sizeof(uint16_t))
+			{
+				std::memcpy(&joint, component, sizeof(uint16_t));
+			}
+
+			joints[i][c] = joint;
+		}
+	}
+
+	return {reinterpret_cast<const uint8_t *>(joints.data()), reinterpret_cast<const uint8_t *>(joints.data() + joints.size())};
+};
+
+/**
+ * @brief Reads WEIGHTS_n data as four floats per vertex, normalized integers are converted
+ */
+inline std::vector<uint8_t> get_weights_data(const tinygltf::Model *model, uint32_t accessorId)
+{
+	auto &accessor   = model->accessors.at(accessorId);
+	auto &bufferView = model->bufferViews.at(accessor.bufferView);
+	auto &buffer     = model->buffers.at(bufferView.buffer);
+
+	size_t stride = accessor.ByteStride(bufferView);
+
+	const uint8_t *data = buffer.data.data() + accessor.byteOffset + bufferView.byteOffset;
+
+	std::vector<glm::vec4> weights(accessor.count);
+
+	for (size_t i = 0; i < accessor.count; ++i)
+	{
+		const uint8_t *vertex = data + i * stride;
+
+		switch (accessor.componentType)
+		{
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+				weights[i] = glm::vec4(vertex[0], vertex[1], vertex[2], vertex[3]) / 255.0f;
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+			{
+				uint16_t values[4];
+				std::memcpy(values, vertex, sizeof(values));
+				weights[i] = glm::vec4(values[0], values[1], values[2], values[3]) / 65535.0f;
+				break;
+			}
+			default:
+				std::memcpy(&weights[i].x, vertex, sizeof(glm::vec4));
+				break;
+		}
+	}
+
+	return {reinterpret_cast<const uint8_t *>(weights.data()), reinterpret_cast<const uint8_t *>(weights.data() + weights.size())};
+};
+
+inline sg::AnimationInterpolation find_interpolation(const std::string &interpolation)
+{
+	if (interpolation == "STEP")
+	{
+		return sg::AnimationInterpolation::Step;
+	}
+	else if (interpolation == "CUBICSPLINE")
+	{
+		return sg::AnimationInterpolation::CubicSpline;
+	}
+
+	return sg::AnimationInterpolation::Linear;
+};
+
 inline VkFormat get_attribute_format(const tinygltf::Model *model, uint32_t accessorId)
 {
 	auto &accessor = model->accessors.at(accessorId);
@@ -277,7 +395,12 @@ inline std::vector<uint8_t> convert_underlying_data_stride(const std::vector<uin
 	return result;
 }
 
-inline void upload_image_to_gpu(CommandBuffer &command_buffer, core::Buffer &staging_buffer, sg::Image &image)
+/**
+ * @param image_kernels Kernels generating the levels of the Vulkan image missing from the data of the image
+ * @param[out] transient_views Views of the levels used by the kernels, valid until the command buffer is executed
+ */
+inline void upload_image_to_gpu(CommandBuffer &command_buffer, core::Buffer &staging_buffer, sg::Image &image,
+                                ImageKernels *image_kernels, std::vector<std::vector<core::ImageView>> &transient_views)
 {
 	// Clean up the image data, as they are copied in the staging buffer
 	image.clear_data();
@@ -313,18 +436,86 @@ inline void upload_image_to_gpu(CommandBuffer &command_buffer, core::Buffer &sta
 
 	command_buffer.copy_buffer_to_image(staging_buffer, image.get_vk_image(), buffer_copy_regions);
 
+	bool generate_mipmaps = image.get_vk_image().get_subresource().mipLevel > mipmaps.size();
+
+	if (generate_mipmaps)
 	{
+		assert(image_kernels && "Image kernels are required to generate mipmaps");
+
 		ImageMemoryBarrier memory_barrier{};
 		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_GENERAL;
+		memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+		command_buffer.image_memory_barrier(image.get_vk_image_view(), memory_barrier);
+
+		for (uint32_t layer = 0; layer < image.get_layers(); ++layer)
+		{
+			transient_views.push_back(ImageKernels::create_level_views(image.get_vk_image(), layer));
+
+			image_kernels->generate_mipmaps(command_buffer, transient_views.back());
+		}
+	}
+
+	{
+		ImageMemoryBarrier memory_barrier{};
+		memory_barrier.old_layout      = generate_mipmaps ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		memory_barrier.src_access_mask = 0;
+		memory_barrier.src_access_mask = generate_mipmaps ? VK_ACCESS_SHADER_WRITE_BIT : 0;
 		memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
-		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		memory_barrier.src_stage_mask  = generate_mipmaps ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT;
 		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
 
 		command_buffer.image_memory_barrier(image.get_vk_image_view(), memory_barrier);
 	}
 }
+
+/**
+ * @return The path relative to the assets directory, empty if the file is not an asset
+ */
+std::string get_asset_name(const std::string &path)
+{
+	auto assets_path = fs::path::get(fs::path::Type::Assets);
+
+	return path.compare(0, assets_path.size(), assets_path) == 0 ? path.substr(assets_path.size()) : std::string{};
+}
+
+// Files of a model are read through vkb::fs, so that they are found in the mounted asset packs
+bool model_file_exists(const std::string &abs_filename, void *user_data)
+{
+	auto asset_name = get_asset_name(abs_filename);
+
+	return asset_name.empty() ? tinygltf::FileExists(abs_filename, user_data) : fs::asset_exists(asset_name);
+}
+
+bool read_model_file(std::vector<unsigned char> *out, std::string *err, const std::string &filepath, void *user_data)
+{
+	auto asset_name = get_asset_name(filepath);
+
+	if (asset_name.empty())
+	{
+		return tinygltf::ReadWholeFile(out, err, filepath, user_data);
+	}
+
+	try
+	{
+		*out = fs::read_asset(asset_name);
+	}
+	catch (const std::runtime_error &e)
+	{
+		if (err)
+		{
+			*err += e.what();
+		}
+
+		return false;
+	}
+
+	return true;
+}
 }        // namespace
 
 std::unordered_map<std::string, bool> GLTFLoader::supported_extensions = {
@@ -335,6 +526,31 @@ GLTFLoader::GLTFLoader(Device &device) :
 {
 }
 
+void GLTFLoader::set_astc_encoding(const sg::AstcEncodeSettings &settings)
+{
+	auto format = sg::to_astc_format(settings.blockdim);
+
+	if (format == VK_FORMAT_UNDEFINED || !device.is_image_format_supported(format))
+	{
+		LOGW("ASTC {}x{} not supported: images are not encoded", settings.blockdim.x, settings.blockdim.y);
+		astc_encoding = false;
+		return;
+	}
+
+	astc_encoding = true;
+	astc_settings = settings;
+}
+
+void GLTFLoader::set_texture_arrays(bool enable)
+{
+	texture_arrays = enable;
+}
+
+void GLTFLoader::set_gpu_mipmaps(bool enable)
+{
+	gpu_mipmaps = enable;
+}
+
 std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &file_name)
 {
 	std::string err;
@@ -342,6 +558,13 @@ std::unique_ptr<sg::Scene> GLTFLoader::read_scene_from_file(const std::string &f
 
 	tinygltf::TinyGLTF gltf_loader;
 
+	tinygltf::FsCallbacks fs_callbacks{};
+	fs_callbacks.FileExists     = model_file_exists;
+	fs_callbacks.ExpandFilePath = tinygltf::ExpandFilePath;
+	fs_callbacks.ReadWholeFile  = read_model_file;
+	fs_callbacks.WriteWholeFile = tinygltf::WriteWholeFile;
+	gltf_loader.SetFsCallbacks(fs_callbacks);
+
 	std::string gltf_file = vkb::fs::path::get(vkb::fs::path::Type::Assets) + file_name;
 
 	bool importResult = gltf_loader.LoadASCIIFromFile(&model, &err, &warn, gltf_file.c_str());
@@ -430,6 +653,11 @@ sg::Scene GLTFLoader::load_scene()
 	Timer timer;
 	timer.start();
 
+	if (gpu_mipmaps)
+	{
+		image_kernels = std::make_unique<ImageKernels>(device);
+	}
+
 	// Load images
 	auto thread_count = std::thread::hardware_concurrency();
 	thread_count      = thread_count == 0 ? 1 : thread_count;
@@ -458,16 +686,67 @@ sg::Scene GLTFLoader::load_scene()
 		image_components.push_back(fut.get());
 	}
 
+	if (astc_encoding)
+	{
+		// Texels of the encoded images take 128 bits per block instead of 32 bits each
+		size_t encoded_count = 0;
+		size_t encoded_size  = 0;
+		size_t rgba_size     = 0;
+
+		for (auto &image : image_components)
+		{
+			if (dynamic_cast<sg::AstcEncoded *>(image.get()))
+			{
+				encoded_count++;
+				encoded_size += image->get_data().size();
+
+				for (auto &mipmap : image->get_mipmaps())
+				{
+					rgba_size += mipmap.extent.width * mipmap.extent.height * 4;
+				}
+			}
+		}
+
+		if (encoded_count > 0)
+		{
+			LOGI("Encoded {} images to ASTC {}x{}: {:.1f} MiB instead of {:.1f} MiB, {:.2f} bits per texel instead of 32",
+			     encoded_count, astc_settings.blockdim.x, astc_settings.blockdim.y,
+			     static_cast<float>(encoded_size) / (1024.0f * 1024.0f), static_cast<float>(rgba_size) / (1024.0f * 1024.0f),
+			     128.0f / (astc_settings.blockdim.x * astc_settings.blockdim.y));
+		}
+	}
+
+	// Array and layer of each image of the glTF file, the arrays replace the images in the scene
+	std::vector<std::pair<size_t, uint32_t>> image_layers(image_count);
+
+	if (texture_arrays)
+	{
+		image_components = pack_texture_arrays(std::move(image_components), image_layers);
+	}
+	else
+	{
+		for (size_t image_index = 0; image_index < image_count; image_index++)
+		{
+			image_layers[image_index] = {image_index, 0};
+		}
+	}
+
 	// Upload images to GPU
 	std::vector<core::Buffer> transient_buffers;
 
+	std::vector<std::vector<core::ImageView>> transient_views;
+
+	size_t gpu_mipmap_count = 0;
+
+	Timer upload_timer;
+	upload_timer.start();
+
 	auto &command_buffer = device.request_command_buffer();
 
 	command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0);
 
-	for (size_t image_index = 0; image_index < image_count; image_index++)
+	for (auto &image : image_components)
 	{
-		auto &image = image_components.at(image_index);
 
 		core::Buffer stage_buffer{device,
 		                          image->get_data().size(),
@@ -476,14 +755,20 @@ sg::Scene GLTFLoader::load_scene()
 
 		stage_buffer.update(image->get_data());
 
-		upload_image_to_gpu(command_buffer, stage_buffer, *image);
+		if (image->get_vk_image().get_subresource().mipLevel > image->get_mipmaps().size())
+		{
+			gpu_mipmap_count++;
+		}
+
+		upload_image_to_gpu(command_buffer, stage_buffer, *image, image_kernels.get(), transient_views);
 
 		transient_buffers.push_back(std::move(stage_buffer));
 	}
 
 	command_buffer.end();
 
-	auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+	// Mipmaps are generated by compute shaders in the same submission
+	auto &queue = device.get_queue_by_flags(image_kernels ? VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT : VK_QUEUE_GRAPHICS_BIT, 0);
 
 	queue.submit(command_buffer, device.request_fence());
 
@@ -491,8 +776,16 @@ sg::Scene GLTFLoader::load_scene()
 	device.get_fence_pool().reset();
 	device.get_command_pool().reset_pool();
 
+	transient_views.clear();
 	transient_buffers.clear();
 
+	image_kernels.reset();
+
+	if (gpu_mipmap_count > 0)
+	{
+		LOGI("Uploaded images and generated the mipmaps of {} of them on the GPU in {:.2f} ms", gpu_mipmap_count, upload_timer.stop<Timer::Milliseconds>());
+	}
+
 	scene.set_components(std::move(image_components));
 
 	auto elapsed_time = timer.stop();
@@ -508,7 +801,9 @@ sg::Scene GLTFLoader::load_scene()
 	{
 		auto texture = parse_texture(gltf_texture);
 
-		texture->set_image(*images.at(gltf_texture.source));
+		auto &image_layer = image_layers.at(gltf_texture.source);
+
+		texture->set_image(*images.at(image_layer.first), image_layer.second);
 
 		if (gltf_texture.sampler >= 0 && gltf_texture.sampler < static_cast<int>(samplers.size()))
 		{
@@ -518,7 +813,7 @@ sg::Scene GLTFLoader::load_scene()
 		{
 			if (gltf_texture.name.empty())
 			{
-				gltf_texture.name = images.at(gltf_texture.source)->get_name();
+				gltf_texture.name = images.at(image_layer.first)->get_name();
 			}
 
 			LOGW("Sampler not found for texture {}, possible GLTF error", gltf_texture.name);
@@ -575,12 +870,42 @@ sg::Scene GLTFLoader::load_scene()
 		{
 			auto submesh = std::make_unique<sg::SubMesh>();
 
+			// Skinned vertices can also be read by the compute skinning shader
+			VkBufferUsageFlags vertex_buffer_usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+			if (gltf_primitive.attributes.count("JOINTS_0") > 0)
+			{
+				vertex_buffer_usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+			}
+
 			for (auto &attribute : gltf_primitive.attributes)
 			{
 				std::string attrib_name = attribute.first;
 				std::transform(attrib_name.begin(), attrib_name.end(), attrib_name.begin(), ::tolower);
 
-				auto vertex_data = get_attribute_data(&model, attribute.second);
+				std::vector<uint8_t> vertex_data;
+
+				sg::VertexAttribute attrib;
+
+				// Joints and weights can have several component types, they are converted
+				// to a single format so that shaders do not need a variant for each of them
+				if (attrib_name == "joints_0")
+				{
+					vertex_data   = get_joints_data(&model, attribute.second);
+					attrib.format = VK_FORMAT_R32G32B32A32_UINT;
+					attrib.stride = to_u32(sizeof(glm::uvec4));
+				}
+				else if (attrib_name == "weights_0")
+				{
+					vertex_data   = get_weights_data(&model, attribute.second);
+					attrib.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+					attrib.stride = to_u32(sizeof(glm::vec4));
+				}
+				else
+				{
+					vertex_data   = get_attribute_data(&model, attribute.second);
+					attrib.format = get_attribute_format(&model, attribute.second);
+					attrib.stride = to_u32(get_attribute_stride(&model, attribute.second));
+				}
 
 				if (attrib_name == "position")
 				{
@@ -589,16 +914,12 @@ sg::Scene GLTFLoader::load_scene()
 
 				core::Buffer buffer{device,
 				                    vertex_data.size(),
-				                    VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+				                    vertex_buffer_usage,
 				                    VMA_MEMORY_USAGE_GPU_TO_CPU};
 				buffer.update(vertex_data);
 
 				submesh->vertex_buffers.insert(std::make_pair(attrib_name, std::move(buffer)));
 
-				sg::VertexAttribute attrib;
-				attrib.format = get_attribute_format(&model, attribute.second);
-				attrib.stride = to_u32(get_attribute_stride(&model, attribute.second));
-
 				submesh->set_attribute(attrib_name, attrib);
 			}
 
@@ -743,7 +1064,7 @@ sg::Scene GLTFLoader::load_scene()
 
 			for (auto child_node_index : model.nodes[node_it.second].children)
 			{
-				traverse_nodes.push(std::make_pair(std::ref(traverse_root_node), child_node_index));
+				traverse_nodes.push(std::make_pair(std::ref(current_node), child_node_index));
 			}
 		}
 
@@ -751,6 +1072,34 @@ sg::Scene GLTFLoader::load_scene()
 		nodes.push_back(std::move(root_node));
 	}
 
+	// Load skins, their joints refer to the nodes by their glTF index
+	std::vector<sg::Skin *> skins;
+
+	for (auto &gltf_skin : model.skins)
+	{
+		auto skin = parse_skin(gltf_skin, nodes);
+
+		skins.push_back(skin.get());
+
+		scene.add_component(std::move(skin));
+	}
+
+	for (size_t node_index = 0; node_index < model.nodes.size(); ++node_index)
+	{
+		int skin_index = model.nodes[node_index].skin;
+
+		if (skin_index >= 0)
+		{
+			nodes.at(node_index)->set_component(*skins.at(skin_index));
+		}
+	}
+
+	// Load animations, their channels refer to the nodes by their glTF index
+	for (auto &gltf_animation : model.animations)
+	{
+		scene.add_component(parse_animation(gltf_animation, nodes));
+	}
+
 	// Store nodes into the scene
 	scene.set_nodes(std::move(nodes));
 
@@ -765,9 +1114,108 @@ sg::Scene GLTFLoader::load_scene()
 	scene.add_child(*camera_node);
 	scene.add_node(std::move(camera_node));
 
+	// Play every animation in a loop
+	if (scene.has_component<sg::Animation>())
+	{
+		auto player_node = std::make_unique<sg::Node>("animation_player");
+
+		auto player = std::make_unique<sg::AnimationPlayer>(*player_node);
+
+		for (auto animation : scene.get_components<sg::Animation>())
+		{
+			player->play(*animation);
+		}
+
+		scene.add_component(std::move(player), *player_node);
+
+		scene.add_child(*player_node);
+		scene.add_node(std::move(player_node));
+	}
+
 	return scene;
 }
 
+std::unique_ptr<sg::Skin> GLTFLoader::parse_skin(const tinygltf::Skin &gltf_skin, const std::vector<std::unique_ptr<sg::Node>> &nodes) const
+{
+	auto skin = std::make_unique<sg::Skin>(gltf_skin.name);
+
+	std::vector<glm::mat4> inverse_bind_matrices(gltf_skin.joints.size(), glm::mat4(1.0f));
+
+	// The matrices are optional, joints default to identity
+	if (gltf_skin.inverseBindMatrices >= 0)
+	{
+		auto data = get_attribute_data(&model, gltf_skin.inverseBindMatrices);
+
+		std::memcpy(inverse_bind_matrices.data(), data.data(), std::min(data.size(), inverse_bind_matrices.size() * sizeof(glm::mat4)));
+	}
+
+	for (size_t i = 0; i < gltf_skin.joints.size(); ++i)
+	{
+		skin->add_joint(*nodes.at(gltf_skin.joints[i]), inverse_bind_matrices[i]);
+	}
+
+	return skin;
+}
+
+std::unique_ptr<sg::Animation> GLTFLoader::parse_animation(const tinygltf::Animation &gltf_animation, const std::vector<std::unique_ptr<sg::Node>> &nodes) const
+{
+	auto animation = std::make_unique<sg::Animation>(gltf_animation.name);
+
+	std::vector<uint32_t> samplers;
+
+	for (auto &gltf_sampler : gltf_animation.samplers)
+	{
+		if (model.accessors.at(gltf_sampler.input).componentType != TINYGLTF_COMPONENT_TYPE_FLOAT ||
+		    model.accessors.at(gltf_sampler.output).componentType != TINYGLTF_COMPONENT_TYPE_FLOAT)
+		{
+			// Quantized keyframes are not supported, the sampler is kept so that channel indices stay valid
+			LOGW("Animation {} has a sampler with non-float data, it will not be animated", gltf_animation.name);
+			samplers.push_back(std::numeric_limits<uint32_t>::max());
+			continue;
+		}
+
+		auto times = get_vec4_data(&model, gltf_sampler.input);
+
+		std::vector<float> key_times(times.size());
+		std::transform(times.begin(), times.end(), key_times.begin(), [](const glm::vec4 &time) { return time.x; });
+
+		auto values = get_vec4_data(&model, gltf_sampler.output);
+
+		samplers.push_back(animation->add_sampler(find_interpolation(gltf_sampler.interpolation), key_times, values));
+	}
+
+	for (auto &gltf_channel : gltf_animation.channels)
+	{
+		uint32_t sampler = samplers.at(gltf_channel.sampler);
+
+		if (gltf_channel.target_node < 0 || sampler == std::numeric_limits<uint32_t>::max())
+		{
+			continue;
+		}
+
+		auto &transform = nodes.at(gltf_channel.target_node)->get_transform();
+
+		if (gltf_channel.target_path == "translation")
+		{
+			animation->add_channel(transform, sg::AnimationTarget::Translation, sampler);
+		}
+		else if (gltf_channel.target_path == "rotation")
+		{
+			animation->add_channel(transform, sg::AnimationTarget::Rotation, sampler);
+		}
+		else if (gltf_channel.target_path == "scale")
+		{
+			animation->add_channel(transform, sg::AnimationTarget::Scale, sampler);
+		}
+		else
+		{
+			LOGW("Animation {} targets unsupported {} of node {}", gltf_animation.name, gltf_channel.target_path, gltf_channel.target_node);
+		}
+	}
+
+	return animation;
+}
+
 std::unique_ptr<sg::Node> GLTFLoader::parse_node(const tinygltf::Node &gltf_node) const
 {
 	auto node = std::make_unique<sg::Node>(gltf_node.name);
@@ -918,7 +1366,7 @@ std::unique_ptr<sg::Image> GLTFLoader::parse_image(tinygltf::Image &gltf_image)
 	{
 		// Load image from uri
 		auto image_uri = model_path + "/" + gltf_image.uri;
-		image          = sg::Image::load(gltf_image.name, image_uri);
+		image          = sg::Image::load(gltf_image.name, image_uri, astc_encoding ? &astc_settings : nullptr);
 	}
 
 	// Check whether the format is supported by the GPU
@@ -928,15 +1376,107 @@ std::unique_ptr<sg::Image> GLTFLoader::parse_image(tinygltf::Image &gltf_image)
 		{
 			LOGW("ASTC not supported: decoding {}", image->get_name());
 			image = std::make_unique<sg::Astc>(*image);
-			image->generate_mipmaps();
+
+			// Decoded images get mipmaps on the GPU when the kernels are enabled
+			if (get_mip_levels(*image) == 0)
+			{
+				Timer timer;
+				timer.start();
+
+				image->generate_mipmaps();
+
+				LOGI("Generated the mipmaps of {} on the CPU in {:.2f} ms", image->get_name(), timer.stop<Timer::Milliseconds>());
+			}
 		}
 	}
 
-	image->create_vk_image(device);
+	// The images are copied into arrays before their Vulkan images are created
+	if (!texture_arrays)
+	{
+		image->create_vk_image(device, get_mip_levels(*image));
+	}
 
 	return image;
 }
 
+uint32_t GLTFLoader::get_mip_levels(const sg::Image &image) const
+{
+	if (!image_kernels || image.get_mipmaps().size() > 1 || !image_kernels->is_format_supported(image.get_format()))
+	{
+		return 0;
+	}
+
+	auto extent = image.get_extent();
+
+	// Full chain down to 1x1
+	uint32_t mip_levels = 1;
+
+	for (auto size = std::max(extent.width, extent.height); size > 1; size /= 2)
+	{
+		mip_levels++;
+	}
+
+	return mip_levels;
+}
+
+std::vector<std::unique_ptr<sg::Image>> GLTFLoader::pack_texture_arrays(std::vector<std::unique_ptr<sg::Image>> &&images,
+                                                                        std::vector<std::pair<size_t, uint32_t>> &image_layers)
+{
+	auto max_layers = device.get_properties().limits.maxImageArrayLayers;
+
+	// Indices of the images gathered in each array
+	std::vector<std::vector<size_t>> groups;
+
+	for (size_t image_index = 0; image_index < images.size(); image_index++)
+	{
+		auto &image = *images.at(image_index);
+
+		auto group_it = std::find_if(groups.begin(), groups.end(), [&](const std::vector<size_t> &group) {
+			return group.size() < max_layers && sg::ImageArray::is_compatible(*images.at(group.front()), image);
+		});
+
+		if (group_it == groups.end())
+		{
+			groups.push_back({image_index});
+		}
+		else
+		{
+			group_it->push_back(image_index);
+		}
+	}
+
+	std::vector<std::unique_ptr<sg::Image>> arrays;
+
+	for (auto &group : groups)
+	{
+		std::vector<const sg::Image *> layers;
+
+		for (uint32_t layer = 0; layer < to_u32(group.size()); ++layer)
+		{
+			layers.push_back(images.at(group[layer]).get());
+
+			image_layers.at(group[layer]) = {arrays.size(), layer};
+		}
+
+		auto name = group.size() == 1 ? layers.front()->get_name() : "texture_array_" + std::to_string(arrays.size());
+
+		auto array = std::make_unique<sg::ImageArray>(name, layers);
+		array->create_vk_image(device, get_mip_levels(*array));
+
+		arrays.push_back(std::move(array));
+
+		// Release the copied data before building the next array
+		for (auto image_index : group)
+		{
+			images.at(image_index).reset();
+		}
+	}
+
+	LOGI("Packed {} images into {} texture arrays", images.size(), arrays.size());
+
+	return arrays;
+}
+
 std::unique_ptr<sg::Sampler> GLTFLoader::parse_sampler(const tinygltf::Sampler &gltf_sampler) const
 {
 	auto name = gltf_sampler.name;
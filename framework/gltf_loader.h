@@ -28,6 +28,8 @@
 #define TINYGLTF_NO_EXTERNAL_IMAGE
 #include <tiny_gltf.h>
 
+#include "rendering/image_kernels.h"
+#include "scene_graph/components/image/astc.h"
 #include "timer.h"
 
 #define KHR_LIGHTS_PUNCTUAL_EXTENSION "KHR_lights_punctual"
@@ -38,6 +40,7 @@ class Device;
 
 namespace sg
 {
+class Animation;
 class Camera;
 class Image;
 class Light;
@@ -46,6 +49,7 @@ class Node;
 class PBRMaterial;
 class Sampler;
 class Scene;
+class Skin;
 class SubMesh;
 class Texture;
 }        // namespace sg
@@ -77,11 +81,46 @@ class GLTFLoader
 
 	std::unique_ptr<sg::Scene> read_scene_from_file(const std::string &file_name);
 
+	/**
+	 * @brief Encodes the PNG and JPG images of the scene to ASTC while loading them,
+	 *        if the device supports the ASTC format with the block dimensions of the settings
+	 * @param settings Block dimensions and preset of the encoder
+	 */
+	void set_astc_encoding(const sg::AstcEncodeSettings &settings);
+
+	/**
+	 * @brief Gathers the images of the scene with the same format, size and mipmaps into texture arrays,
+	 *        textures then sample a layer of an array instead of an image of their own
+	 * @param enable Whether images are packed into arrays
+	 */
+	void set_texture_arrays(bool enable);
+
+	/**
+	 * @brief Generates the mipmaps of the images without any on the GPU after their upload,
+	 *        if the compute kernels support their format
+	 * @param enable Whether mipmaps are generated
+	 */
+	void set_gpu_mipmaps(bool enable);
+
   protected:
 	virtual std::unique_ptr<sg::Node> parse_node(const tinygltf::Node &gltf_node) const;
 
 	virtual std::unique_ptr<sg::Camera> parse_camera(const tinygltf::Camera &gltf_camera) const;
 
+	/**
+	 * @brief Parses a skin, its joints are nodes of the scene
+	 * @param gltf_skin The glTF skin
+	 * @param nodes The nodes of the scene, in the same order as in the glTF file
+	 */
+	virtual std::unique_ptr<sg::Skin> parse_skin(const tinygltf::Skin &gltf_skin, const std::vector<std::unique_ptr<sg::Node>> &nodes) const;
+
+	/**
+	 * @brief Parses an animation, its channels target the transforms of nodes
+	 * @param gltf_animation The glTF animation
+	 * @param nodes The nodes of the scene, in the same order as in the glTF file
+	 */
+	virtual std::unique_ptr<sg::Animation> parse_animation(const tinygltf::Animation &gltf_animation, const std::vector<std::unique_ptr<sg::Node>> &nodes) const;
+
 	virtual std::unique_ptr<sg::Mesh> parse_mesh(const tinygltf::Mesh &gltf_mesh) const;
 
 	virtual std::unique_ptr<sg::PBRMaterial> parse_material(const tinygltf::Material &gltf_material) const;
@@ -122,6 +161,19 @@ class GLTFLoader
 
 	tinygltf::Model model;
 
+	/// Whether PNG and JPG images are encoded to ASTC with astc_settings
+	bool astc_encoding{false};
+
+	sg::AstcEncodeSettings astc_settings;
+
+	/// Whether images are packed into texture arrays, their Vulkan images are then created by pack_texture_arrays()
+	bool texture_arrays{false};
+
+	bool gpu_mipmaps{false};
+
+	/// Kernels generating mipmaps while the scene is loaded, if gpu_mipmaps is enabled
+	std::unique_ptr<ImageKernels> image_kernels;
+
 	std::string model_path;
 
 	/// The extensions that the GLTFLoader can load mapped to whether they should be enabled or not
@@ -129,5 +181,19 @@ class GLTFLoader
 
   private:
 	sg::Scene load_scene();
+
+	/**
+	 * @return The number of levels of the Vulkan image of an image, 0 for the mipmaps of its data
+	 */
+	uint32_t get_mip_levels(const sg::Image &image) const;
+
+	/**
+	 * @brief Packs compatible images into arrays, every image becomes a layer of an array even if it is the only one
+	 * @param images Images of the scene, in the same order as in the glTF file
+	 * @param[out] image_layers Index of the array and layer of each image
+	 * @return The arrays with their Vulkan images
+	 */
+	std::vector<std::unique_ptr<sg::Image>> pack_texture_arrays(std::vector<std::unique_ptr<sg::Image>> &&images,
+	                                                            std::vector<std::pair<size_t, uint32_t>> &image_layers);
 };
 }        // namespace vkb
@@ -20,6 +20,7 @@
 
 #include "gui.h"
 
+#include <cstring>
 #include <map>
 #include <numeric>
 
@@ -58,6 +59,95 @@ inline void reset_graph_max_value(Gui::StatsView::GraphData &graph_data)
 		graph_data.max_value = 0.0f;
 	}
 }
+
+/**
+ * @brief FNV-1a hash of the geometry of the draw data, used to skip uploading unchanged geometry
+ */
+uint64_t hash_geometry(const ImDrawData &draw_data)
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	auto hash_bytes = [&hash](const void *data, size_t size) {
+		const auto *bytes = static_cast<const uint8_t *>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+	};
+
+	for (int n = 0; n < draw_data.CmdListsCount; n++)
+	{
+		const ImDrawList *cmd_list = draw_data.CmdLists[n];
+
+		hash_bytes(&cmd_list->VtxBuffer.Size, sizeof(cmd_list->VtxBuffer.Size));
+		hash_bytes(cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+		hash_bytes(&cmd_list->IdxBuffer.Size, sizeof(cmd_list->IdxBuffer.Size));
+		hash_bytes(cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+	}
+
+	return hash;
+}
+
+VertexInputState get_vertex_input_state()
+{
+	VkVertexInputBindingDescription vertex_input_binding{};
+	vertex_input_binding.stride = to_u32(sizeof(ImDrawVert));
+
+	// Location 0: Position
+	VkVertexInputAttributeDescription pos_attr{};
+	pos_attr.format = VK_FORMAT_R32G32_SFLOAT;
+	pos_attr.offset = to_u32(offsetof(ImDrawVert, pos));
+
+	// Location 1: UV
+	VkVertexInputAttributeDescription uv_attr{};
+	uv_attr.location = 1;
+	uv_attr.format   = VK_FORMAT_R32G32_SFLOAT;
+	uv_attr.offset   = to_u32(offsetof(ImDrawVert, uv));
+
+	// Location 2: Color
+	VkVertexInputAttributeDescription col_attr{};
+	col_attr.location = 2;
+	col_attr.format   = VK_FORMAT_R8G8B8A8_UNORM;
+	col_attr.offset   = to_u32(offsetof(ImDrawVert, col));
+
+	VertexInputState vertex_input_state{};
+	vertex_input_state.bindings   = {vertex_input_binding};
+	vertex_input_state.attributes = {pos_attr, uv_attr, col_attr};
+
+	return vertex_input_state;
+}
+
+ColorBlendState get_color_blend_state()
+{
+	ColorBlendAttachmentState color_attachment{};
+	color_attachment.blend_enable           = VK_TRUE;
+	color_attachment.color_write_mask       = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT;
+	color_attachment.src_color_blend_factor = VK_BLEND_FACTOR_SRC_ALPHA;
+	color_attachment.dst_color_blend_factor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+	color_attachment.src_alpha_blend_factor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+
+	ColorBlendState blend_state{};
+	blend_state.attachments = {color_attachment};
+
+	return blend_state;
+}
+
+RasterizationState get_rasterization_state()
+{
+	RasterizationState rasterization_state{};
+	rasterization_state.cull_mode = VK_CULL_MODE_NONE;
+
+	return rasterization_state;
+}
+
+DepthStencilState get_depth_stencil_state()
+{
+	DepthStencilState depth_state{};
+	depth_state.depth_test_enable  = VK_FALSE;
+	depth_state.depth_write_enable = VK_FALSE;
+
+	return depth_state;
+}
 }        // namespace
 
 const double Gui::press_time_ms = 200.0f;
@@ -219,12 +309,17 @@ void Gui::update(const float delta_time)
 		return;
 	}
 
+	Timer update_timer;
+	update_timer.start();
+
 	// Update imGui
 	ImGuiIO &io  = ImGui::GetIO();
 	io.DeltaTime = delta_time;
 
 	// Render to generate draw buffers
 	ImGui::Render();
+
+	cpu_time = static_cast<float>(update_timer.stop<Timer::Milliseconds>());
 }
 
 void Gui::update_buffers(CommandBuffer &command_buffer)
@@ -239,38 +334,57 @@ void Gui::update_buffers(CommandBuffer &command_buffer)
 		return;
 	}
 
-	std::vector<uint8_t> vertex_data(vertex_buffer_size);
-	std::vector<uint8_t> index_data(index_buffer_size);
+	auto &render_context = sample.get_render_context();
+
+	geometry_slots.resize(render_context.get_render_frames().size());
 
-	// Upload data
-	ImDrawVert *vtx_dst = (ImDrawVert *) vertex_data.data();
-	ImDrawIdx * idx_dst = (ImDrawIdx *) index_data.data();
+	// The buffers of the active frame are not in use by the GPU anymore
+	auto &slot = geometry_slots.at(render_context.get_active_frame_index());
 
-	for (int n = 0; n < draw_data->CmdListsCount; n++)
+	if (!slot.vertex_buffer || slot.vertex_buffer->get_size() < vertex_buffer_size)
 	{
-		const ImDrawList *cmd_list = draw_data->CmdLists[n];
-		memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
-		memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-		vtx_dst += cmd_list->VtxBuffer.Size;
-		idx_dst += cmd_list->IdxBuffer.Size;
+		slot.vertex_buffer = std::make_unique<core::Buffer>(render_context.get_device(), vertex_buffer_size * 2, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+		slot.geometry_hash = 0;
 	}
 
-	auto vertex_allocation = sample.get_render_context().get_active_frame().allocate_buffer(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertex_buffer_size);
+	if (!slot.index_buffer || slot.index_buffer->get_size() < index_buffer_size)
+	{
+		slot.index_buffer  = std::make_unique<core::Buffer>(render_context.get_device(), index_buffer_size * 2, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
+		slot.geometry_hash = 0;
+	}
 
-	vertex_allocation.update(vertex_data);
+	// The overlay is often identical from one frame to the next, the buffers then already hold it
+	auto geometry_hash = hash_geometry(*draw_data);
 
-	std::vector<std::reference_wrapper<const core::Buffer>> buffers;
-	buffers.emplace_back(std::ref(vertex_allocation.get_buffer()));
+	if (slot.geometry_hash != geometry_hash)
+	{
+		// Copy the draw lists straight into the buffers, which stay mapped
+		ImDrawVert *vertex_data = reinterpret_cast<ImDrawVert *>(slot.vertex_buffer->map());
+		ImDrawIdx * index_data  = reinterpret_cast<ImDrawIdx *>(slot.index_buffer->map());
 
-	std::vector<VkDeviceSize> offsets{vertex_allocation.get_offset()};
+		for (int n = 0; n < draw_data->CmdListsCount; n++)
+		{
+			const ImDrawList *cmd_list = draw_data->CmdLists[n];
 
-	command_buffer.bind_vertex_buffers(0, buffers, offsets);
+			std::memcpy(vertex_data, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+			std::memcpy(index_data, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
 
-	auto index_allocation = sample.get_render_context().get_active_frame().allocate_buffer(VK_BUFFER_USAGE_INDEX_BUFFER_BIT, index_buffer_size);
+			vertex_data += cmd_list->VtxBuffer.Size;
+			index_data += cmd_list->IdxBuffer.Size;
+		}
 
-	index_allocation.update(index_data);
+		slot.vertex_buffer->flush(0, vertex_buffer_size);
+		slot.index_buffer->flush(0, index_buffer_size);
 
-	command_buffer.bind_index_buffer(index_allocation.get_buffer(), index_allocation.get_offset(), VK_INDEX_TYPE_UINT16);
+		slot.geometry_hash = geometry_hash;
+	}
+
+	std::vector<std::reference_wrapper<const core::Buffer>> buffers;
+	buffers.emplace_back(std::ref(*slot.vertex_buffer));
+
+	command_buffer.bind_vertex_buffers(0, buffers, {0});
+
+	command_buffer.bind_index_buffer(*slot.index_buffer, 0, VK_INDEX_TYPE_UINT16);
 }
 
 void Gui::resize(const uint32_t width, const uint32_t height) const
@@ -287,54 +401,16 @@ void Gui::draw(CommandBuffer &command_buffer)
 		return;
 	}
 
-	// Vertex input state
-	VkVertexInputBindingDescription vertex_input_binding{};
-	vertex_input_binding.stride = to_u32(sizeof(ImDrawVert));
-
-	// Location 0: Position
-	VkVertexInputAttributeDescription pos_attr{};
-	pos_attr.format = VK_FORMAT_R32G32_SFLOAT;
-	pos_attr.offset = to_u32(offsetof(ImDrawVert, pos));
-
-	// Location 1: UV
-	VkVertexInputAttributeDescription uv_attr{};
-	uv_attr.location = 1;
-	uv_attr.format   = VK_FORMAT_R32G32_SFLOAT;
-	uv_attr.offset   = to_u32(offsetof(ImDrawVert, uv));
-
-	// Location 2: Color
-	VkVertexInputAttributeDescription col_attr{};
-	col_attr.location = 2;
-	col_attr.format   = VK_FORMAT_R8G8B8A8_UNORM;
-	col_attr.offset   = to_u32(offsetof(ImDrawVert, col));
-
-	VertexInputState vertex_input_state{};
-	vertex_input_state.bindings   = {vertex_input_binding};
-	vertex_input_state.attributes = {pos_attr, uv_attr, col_attr};
-
-	command_buffer.set_vertex_input_state(vertex_input_state);
-
-	// Blend state
-	vkb::ColorBlendAttachmentState color_attachment{};
-	color_attachment.blend_enable           = VK_TRUE;
-	color_attachment.color_write_mask       = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT;
-	color_attachment.src_color_blend_factor = VK_BLEND_FACTOR_SRC_ALPHA;
-	color_attachment.dst_color_blend_factor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-	color_attachment.src_alpha_blend_factor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-
-	vkb::ColorBlendState blend_state{};
-	blend_state.attachments = {color_attachment};
+	Timer draw_timer;
+	draw_timer.start();
 
-	command_buffer.set_color_blend_state(blend_state);
+	command_buffer.set_vertex_input_state(get_vertex_input_state());
+	command_buffer.set_color_blend_state(get_color_blend_state());
+	command_buffer.set_rasterization_state(get_rasterization_state());
+	command_buffer.set_depth_stencil_state(get_depth_stencil_state());
 
-	vkb::RasterizationState rasterization_state{};
-	rasterization_state.cull_mode = VK_CULL_MODE_NONE;
-	command_buffer.set_rasterization_state(rasterization_state);
-
-	vkb::DepthStencilState depth_state{};
-	depth_state.depth_test_enable  = VK_FALSE;
-	depth_state.depth_write_enable = VK_FALSE;
-	command_buffer.set_depth_stencil_state(depth_state);
+	// The GUI shaders do not declare the specialization constants set by the scene
+	command_buffer.clear_specialization_constants();
 
 	// Bind pipeline layout
 	command_buffer.bind_pipeline_layout(*pipeline_layout);
@@ -378,6 +454,9 @@ void Gui::draw(CommandBuffer &command_buffer)
 	int32_t     vertex_offset = 0;
 	uint32_t    index_offset  = 0;
 
+	// Consecutive commands often share the same clip rectangle
+	VkRect2D last_scissor_rect{{-1, -1}, {0, 0}};
+
 	if (draw_data->CmdListsCount > 0)
 	{
 		for (int32_t i = 0; i < draw_data->CmdListsCount; i++)
@@ -420,13 +499,34 @@ void Gui::draw(CommandBuffer &command_buffer)
 					}
 				}
 
-				command_buffer.set_scissor(0, {scissor_rect});
+				if (scissor_rect.offset.x != last_scissor_rect.offset.x || scissor_rect.offset.y != last_scissor_rect.offset.y ||
+				    scissor_rect.extent.width != last_scissor_rect.extent.width || scissor_rect.extent.height != last_scissor_rect.extent.height)
+				{
+					command_buffer.set_scissor(0, {scissor_rect});
+					last_scissor_rect = scissor_rect;
+				}
+
 				command_buffer.draw_indexed(cmd->ElemCount, 1, index_offset, vertex_offset, 0);
 				index_offset += cmd->ElemCount;
 			}
 			vertex_offset += cmd_list->VtxBuffer.Size;
 		}
 	}
+
+	cpu_time += static_cast<float>(draw_timer.stop<Timer::Milliseconds>());
+}
+
+void Gui::collect_pipeline_states(PipelineState &state, std::vector<PipelineState> &pipeline_states)
+{
+	// Same state as draw()
+	state.set_vertex_input_state(get_vertex_input_state());
+	state.set_color_blend_state(get_color_blend_state());
+	state.set_rasterization_state(get_rasterization_state());
+	state.set_depth_stencil_state(get_depth_stencil_state());
+	state.clear_specialization_constants();
+	state.set_pipeline_layout(*pipeline_layout);
+
+	pipeline_states.push_back(state);
 }
 
 Gui::~Gui()
@@ -461,6 +561,11 @@ Font &Gui::get_font(const std::string &font_name)
 	}
 }
 
+float Gui::get_cpu_time() const
+{
+	return cpu_time;
+}
+
 bool Gui::is_debug_view_active() const
 {
 	return debug_view.active;
@@ -642,7 +747,8 @@ void Gui::show_stats(const Stats &stats)
 
 		// Draw graph
 		auto &      graph_data     = pr->second;
-		const auto &graph_elements = stats.get_data(stat_index);
+		const auto &graph_buffer   = stats.get_data(stat_index);
+		const auto &graph_elements = graph_buffer.values;
 		float       graph_min      = 0.0f;
 		float &     graph_max      = graph_data.max_value;
 
@@ -673,7 +779,7 @@ void Gui::show_stats(const Stats &stats)
 		}
 
 		ImGui::PushItemFlag(ImGuiItemFlags_Disabled, true);
-		ImGui::PlotLines("", &graph_elements[0], static_cast<int>(graph_elements.size()), 0, graph_label.str().c_str(), graph_min, graph_max, graph_size);
+		ImGui::PlotLines("", &graph_elements[0], static_cast<int>(graph_elements.size()), static_cast<int>(graph_buffer.head), graph_label.str().c_str(), graph_min, graph_max, graph_size);
 		ImGui::PopItemFlag();
 	}
 }
@@ -708,6 +814,26 @@ void Gui::show_options_window(std::function<void()> body, const uint32_t lines)
 	ImGui::PopStyleVar();
 }
 
+void Gui::show_histogram_window(const std::string &title, const std::vector<float> &values, const std::string &overlay)
+{
+	const auto &display_size = ImGui::GetIO().DisplaySize;
+
+	const ImVec2 size{display_size.x / 3.0f, display_size.y / 4.0f};
+	ImGui::SetNextWindowBgAlpha(overlay_alpha);
+	ImGui::SetNextWindowSize(size, ImGuiCond_Always);
+	ImGui::SetNextWindowPos(ImVec2{display_size.x - size.x, (display_size.y - size.y) / 2.0f}, ImGuiSetCond_Always);
+	const ImGuiWindowFlags flags   = (ImGuiWindowFlags_NoMove |
+                                    ImGuiWindowFlags_NoScrollbar |
+                                    ImGuiWindowFlags_NoResize |
+                                    ImGuiWindowFlags_NoSavedSettings |
+                                    ImGuiWindowFlags_NoFocusOnAppearing |
+                                    ImGuiWindowFlags_NoNav);
+	bool                   is_open = true;
+	ImGui::Begin(title.c_str(), &is_open, flags);
+	ImGui::PlotHistogram("##histogram", values.data(), static_cast<int>(values.size()), 0, overlay.c_str(), 0.0f, FLT_MAX, ImGui::GetContentRegionAvail());
+	ImGui::End();
+}
+
 bool Gui::input_event(const InputEvent &input_event)
 {
 	auto &io                 = ImGui::GetIO();
@@ -192,6 +192,18 @@ class Gui
 		          /* scale_factor = */ 1.0f / (1024.0f * 1024.0f)}},
 		        {StatIndex::l2_ext_write_bytes,
 		         {/* name = */ "External Write Bytes",
+		          /* format = */ "{:4.1f} MiB/s",
+		          /* scale_factor = */ 1.0f / (1024.0f * 1024.0f)}},
+		        {StatIndex::script_times,
+		         {/* name = */ "Script Update Times",
+		          /* format = */ "{:3.2f} ms",
+		          /* scale_factor = */ 1000.0f}},
+		        {StatIndex::attachment_load_bytes,
+		         {/* name = */ "Attachment Loads (Estimated)",
+		          /* format = */ "{:4.1f} MiB/s",
+		          /* scale_factor = */ 1.0f / (1024.0f * 1024.0f)}},
+		        {StatIndex::attachment_store_bytes,
+		         {/* name = */ "Attachment Stores (Estimated)",
 		          /* format = */ "{:4.1f} MiB/s",
 		          /* scale_factor = */ 1.0f / (1024.0f * 1024.0f)}}};
 
@@ -255,6 +267,13 @@ class Gui
 	 */
 	void draw(CommandBuffer &command_buffer);
 
+	/**
+	 * @brief Appends the state of the pipeline requested by draw(), so that it can be created before the first frame
+	 * @param state State of the command buffer when the GUI is drawn, usually after the last subpass
+	 * @param pipeline_states Vector where the pipeline state is appended
+	 */
+	void collect_pipeline_states(PipelineState &state, std::vector<PipelineState> &pipeline_states);
+
 	/**
 	 * @brief Shows an overlay top window with app info and maybe stats
 	 * @param app_name Application name
@@ -296,6 +315,14 @@ class Gui
 	 */
 	void show_options_window(std::function<void()> body, const uint32_t lines = 3);
 
+	/**
+	 * @brief Shows a histogram in a window positioned on the right side of the screen
+	 * @param title Name of the window, also shown above the histogram
+	 * @param values Height of each bar of the histogram
+	 * @param overlay Text drawn over the histogram
+	 */
+	void show_histogram_window(const std::string &title, const std::vector<float> &values, const std::string &overlay);
+
 	bool input_event(const InputEvent &input_event);
 
 	/**
@@ -307,10 +334,28 @@ class Gui
 
 	bool is_debug_view_active() const;
 
+	/**
+	 * @return CPU time spent by the last update and draw of the GUI in milliseconds
+	 */
+	float get_cpu_time() const;
+
   private:
 	/**
-	 * @brief Updates Vulkan buffers
-	 * @param frame Frame to render into
+	 * @brief Geometry uploaded for one of the frames in flight
+	 */
+	struct GeometrySlot
+	{
+		std::unique_ptr<core::Buffer> vertex_buffer;
+
+		std::unique_ptr<core::Buffer> index_buffer;
+
+		/// Hash of the geometry stored in the buffers, 0 when they hold none
+		uint64_t geometry_hash{0};
+	};
+
+	/**
+	 * @brief Writes the draw data to the Vulkan buffers of the active frame unless they already hold it, and binds them
+	 * @param command_buffer Command buffer to bind the buffers to
 	 */
 	void update_buffers(CommandBuffer &command_buffer);
 
@@ -351,6 +396,11 @@ class Gui
 	/// Whether or not the GUI has detected a multi touch gesture
 	bool two_finger_tap = false;
 
+	/// Buffers indexed by the active frame index, persistently mapped
+	std::vector<GeometrySlot> geometry_slots;
+
+	float cpu_time{0.0f};
+
 	bool show_graph_file_output = false;
 };
 
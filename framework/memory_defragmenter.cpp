@@ -0,0 +1,188 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "memory_defragmenter.h"
+
+#include <limits>
+
+#include "common/error.h"
+#include "common/logging.h"
+#include "core/device.h"
+#include "rendering/render_context.h"
+#include "scene_graph/components/sub_mesh.h"
+#include "scene_graph/scene.h"
+
+namespace vkb
+{
+MemoryDefragmenter::MemoryDefragmenter(Device &device, float fragmentation_threshold, VkDeviceSize max_bytes_per_step) :
+    device{device},
+    queue{device.get_transfer_queue()},
+    command_pool{device, queue.get_family_index()},
+    fence_pool{device},
+    fragmentation_threshold{fragmentation_threshold},
+    max_bytes_per_step{max_bytes_per_step}
+{
+}
+
+MemoryDefragmenter::~MemoryDefragmenter()
+{
+	LOGI("Memory defragmentation moved {} bytes in {} allocations", total_bytes_moved, total_allocations_moved);
+}
+
+bool MemoryDefragmenter::update(sg::Scene &scene, RenderContext &render_context)
+{
+	if (frame_count++ % CHECK_INTERVAL != 0)
+	{
+		return false;
+	}
+
+	fragmentation_ratio = calculate_fragmentation_ratio();
+
+	if (fragmentation_ratio <= fragmentation_threshold)
+	{
+		return false;
+	}
+
+	// Gather the buffers which can be moved
+	std::vector<core::Buffer *> buffers;
+	std::vector<VmaAllocation>  allocations;
+
+	for (auto sub_mesh : scene.get_components<sg::SubMesh>())
+	{
+		for (auto &it : sub_mesh->vertex_buffers)
+		{
+			buffers.push_back(&it.second);
+		}
+
+		if (sub_mesh->index_buffer)
+		{
+			buffers.push_back(sub_mesh->index_buffer.get());
+		}
+	}
+
+	for (auto buffer : buffers)
+	{
+		allocations.push_back(buffer->get_memory());
+	}
+
+	if (allocations.empty())
+	{
+		return false;
+	}
+
+	std::vector<VkBool32> allocations_changed(allocations.size(), VK_FALSE);
+
+	VK_CHECK(command_pool.reset_pool());
+	VK_CHECK(fence_pool.reset());
+
+	auto &command_buffer = command_pool.request_command_buffer();
+	command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+	VmaDefragmentationInfo2 defrag_info{};
+	defrag_info.allocationCount         = to_u32(allocations.size());
+	defrag_info.pAllocations            = allocations.data();
+	defrag_info.pAllocationsChanged     = allocations_changed.data();
+	defrag_info.maxGpuBytesToMove       = max_bytes_per_step;
+	defrag_info.maxGpuAllocationsToMove = std::numeric_limits<uint32_t>::max();
+	defrag_info.commandBuffer           = command_buffer.get_handle();
+
+	VmaDefragmentationStats   defrag_stats{};
+	VmaDefragmentationContext defrag_context{VK_NULL_HANDLE};
+
+	VkResult result = vmaDefragmentationBegin(device.get_memory_allocator(), &defrag_info, &defrag_stats, &defrag_context);
+
+	if (result < 0)
+	{
+		throw VulkanException{result, "Cannot defragment memory"};
+	}
+
+	command_buffer.end();
+
+	// The copies only read the old locations, so they run alongside the frames in flight
+	VK_CHECK(queue.submit(command_buffer, fence_pool.request_fence()));
+	VK_CHECK(fence_pool.wait());
+
+	// VMA releases the old locations and any emptied block when the step ends,
+	// so the frames already submitted must be done reading them
+	for (auto &frame : render_context.get_render_frames())
+	{
+		VK_CHECK(frame.get_fence_pool().wait());
+	}
+
+	VK_CHECK(vmaDefragmentationEnd(device.get_memory_allocator(), defrag_context));
+
+	// Recreate the buffers bound to moved allocations
+	std::vector<VkBuffer> old_buffers;
+	std::vector<VkBuffer> new_buffers;
+
+	for (size_t i = 0; i < buffers.size(); ++i)
+	{
+		if (allocations_changed[i])
+		{
+			old_buffers.push_back(buffers[i]->get_handle());
+
+			buffers[i]->rebind();
+
+			new_buffers.push_back(buffers[i]->get_handle());
+		}
+	}
+
+	device.get_resource_cache().update_descriptor_sets(old_buffers, new_buffers);
+
+	total_bytes_moved += defrag_stats.bytesMoved;
+	total_allocations_moved += defrag_stats.allocationsMoved;
+
+	LOGI("Memory fragmentation {:.2f}: moved {} bytes in {} allocations, freed {} bytes in {} blocks",
+	     fragmentation_ratio, defrag_stats.bytesMoved, defrag_stats.allocationsMoved,
+	     defrag_stats.bytesFreed, defrag_stats.deviceMemoryBlocksFreed);
+
+	return !old_buffers.empty();
+}
+
+float MemoryDefragmenter::get_fragmentation_ratio() const
+{
+	return fragmentation_ratio;
+}
+
+VkDeviceSize MemoryDefragmenter::get_total_bytes_moved() const
+{
+	return total_bytes_moved;
+}
+
+uint32_t MemoryDefragmenter::get_total_allocations_moved() const
+{
+	return total_allocations_moved;
+}
+
+float MemoryDefragmenter::calculate_fragmentation_ratio() const
+{
+	VmaStats stats;
+	vmaCalculateStats(device.get_memory_allocator(), &stats);
+
+	if (stats.total.unusedBytes == 0)
+	{
+		return 0.0f;
+	}
+
+	// With no fragmentation all the free memory is a single range
+	return 1.0f - static_cast<float>(stats.total.unusedRangeSizeMax) / static_cast<float>(stats.total.unusedBytes);
+}
+}        // namespace vkb
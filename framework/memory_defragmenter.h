@@ -0,0 +1,126 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+#include "core/command_pool.h"
+#include "fence_pool.h"
+
+namespace vkb
+{
+class Device;
+class Queue;
+class RenderContext;
+
+namespace sg
+{
+class Scene;
+}
+
+/**
+ * @brief Opt-in compaction of the device memory used by scene buffers.
+ *
+ * Every few frames the ratio between the largest free range and the total
+ * free memory is measured. When memory is fragmented above a threshold, the
+ * buffers of the scene meshes are compacted with VMA defragmentation, a bounded
+ * number of bytes per step, and every descriptor referring to them is patched.
+ *
+ * Moves are copies recorded by VMA and submitted to a transfer queue, so device local
+ * buffers can be moved too. A step waits for the fence of its copies and for the fences
+ * of the frames in flight, which read the old locations, instead of the whole device.
+ * Images are never moved.
+ */
+class MemoryDefragmenter
+{
+  public:
+	/**
+	 * @brief Number of frames between two fragmentation checks
+	 */
+	static constexpr uint32_t CHECK_INTERVAL = 30;
+
+	/**
+	 * @param device A valid device
+	 * @param fragmentation_threshold Ratio above which a defragmentation step is run
+	 * @param max_bytes_per_step Maximum amount of memory moved by a single step
+	 */
+	MemoryDefragmenter(Device &device, float fragmentation_threshold = 0.25f, VkDeviceSize max_bytes_per_step = 4 * 1024 * 1024);
+
+	MemoryDefragmenter(const MemoryDefragmenter &) = delete;
+
+	MemoryDefragmenter(MemoryDefragmenter &&) = delete;
+
+	~MemoryDefragmenter();
+
+	MemoryDefragmenter &operator=(const MemoryDefragmenter &) = delete;
+
+	MemoryDefragmenter &operator=(MemoryDefragmenter &&) = delete;
+
+	/**
+	 * @brief Checks fragmentation and runs a defragmentation step if needed
+	 * @param scene Scene whose mesh buffers can be moved
+	 * @param render_context Context whose submitted frames may still read the buffers
+	 * @return Whether any buffer was moved, in which case cached descriptor sets
+	 *         of render frames referring to those buffers need to be cleared
+	 */
+	bool update(sg::Scene &scene, RenderContext &render_context);
+
+	/**
+	 * @return Fragmentation ratio measured by the last check, 0 means no fragmentation
+	 */
+	float get_fragmentation_ratio() const;
+
+	/**
+	 * @return Total number of bytes moved since creation
+	 */
+	VkDeviceSize get_total_bytes_moved() const;
+
+	/**
+	 * @return Total number of allocations moved since creation
+	 */
+	uint32_t get_total_allocations_moved() const;
+
+  private:
+	float calculate_fragmentation_ratio() const;
+
+	Device &device;
+
+	const Queue &queue;
+
+	/// Pool of the command buffers recording the moves, reset by each step
+	CommandPool command_pool;
+
+	FencePool fence_pool;
+
+	float fragmentation_threshold{0.0f};
+
+	VkDeviceSize max_bytes_per_step{0};
+
+	float fragmentation_ratio{0.0f};
+
+	VkDeviceSize total_bytes_moved{0};
+
+	uint32_t total_allocations_moved{0};
+
+	uint32_t frame_count{0};
+};
+}        // namespace vkb
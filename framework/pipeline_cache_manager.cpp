@@ -0,0 +1,347 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "pipeline_cache_manager.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "common/error.h"
+#include "common/logging.h"
+#include "core/device.h"
+#include "platform/filesystem.h"
+
+namespace vkb
+{
+namespace
+{
+/**
+ * @brief Header written by the framework in front of the cache data
+ */
+struct FileHeader
+{
+	uint32_t magic;
+
+	uint32_t version;
+
+	uint32_t data_size;
+
+	float cold_creation_time;
+};
+
+constexpr uint32_t FILE_MAGIC = 0x50424B56;        // "VKBP"
+
+constexpr uint32_t FILE_VERSION = 1;
+
+/**
+ * @brief Layout of VkPipelineCacheHeaderVersionOne, the header the driver writes at the beginning of the cache data
+ */
+struct CacheHeader
+{
+	uint32_t header_size;
+
+	uint32_t header_version;
+
+	uint32_t vendor_id;
+
+	uint32_t device_id;
+
+	uint8_t pipeline_cache_uuid[VK_UUID_SIZE];
+};
+}        // namespace
+
+const char *const PipelineCacheManager::DEFAULT_FILENAME = "pipeline_cache.data";
+
+PipelineCacheManager::PipelineCacheManager(Device &device, const std::string &filename, size_t max_file_size) :
+    device{device},
+    filename{filename},
+    max_file_size{max_file_size}
+{
+	auto data = load();
+
+	warm = !data.empty();
+
+	VkPipelineCacheCreateInfo create_info{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+	create_info.initialDataSize = data.size();
+	create_info.pInitialData    = data.data();
+
+	VkResult result = vkCreatePipelineCache(device.get_handle(), &create_info, nullptr, &handle);
+
+	if (result != VK_SUCCESS)
+	{
+		throw VulkanException{result, "Cannot create pipeline cache"};
+	}
+
+	saved_size = data.size();
+}
+
+PipelineCacheManager::~PipelineCacheManager()
+{
+	if (handle != VK_NULL_HANDLE)
+	{
+		save();
+	}
+
+	for (auto thread_cache : thread_caches)
+	{
+		if (thread_cache != VK_NULL_HANDLE)
+		{
+			vkDestroyPipelineCache(device.get_handle(), thread_cache, nullptr);
+		}
+	}
+
+	if (handle != VK_NULL_HANDLE)
+	{
+		vkDestroyPipelineCache(device.get_handle(), handle, nullptr);
+	}
+}
+
+VkPipelineCache PipelineCacheManager::get_handle() const
+{
+	return handle;
+}
+
+VkPipelineCache PipelineCacheManager::get_thread_cache(size_t thread_index)
+{
+	std::lock_guard<std::mutex> guard(thread_caches_mutex);
+
+	if (thread_index >= thread_caches.size())
+	{
+		thread_caches.resize(thread_index + 1, VK_NULL_HANDLE);
+	}
+
+	auto &thread_cache = thread_caches[thread_index];
+
+	if (thread_cache == VK_NULL_HANDLE)
+	{
+		VkPipelineCacheCreateInfo create_info{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+
+		VkResult result = vkCreatePipelineCache(device.get_handle(), &create_info, nullptr, &thread_cache);
+
+		if (result != VK_SUCCESS)
+		{
+			throw VulkanException{result, "Cannot create pipeline cache"};
+		}
+	}
+
+	return thread_cache;
+}
+
+std::shared_lock<std::shared_timed_mutex> PipelineCacheManager::lock_creation()
+{
+	return std::shared_lock<std::shared_timed_mutex>(creation_mutex);
+}
+
+void PipelineCacheManager::merge()
+{
+	// The main cache is externally synchronized while it is the destination of a merge
+	std::unique_lock<std::shared_timed_mutex> creation_lock(creation_mutex);
+
+	std::lock_guard<std::mutex> guard(thread_caches_mutex);
+
+	std::vector<VkPipelineCache> src_caches;
+
+	for (auto thread_cache : thread_caches)
+	{
+		if (thread_cache != VK_NULL_HANDLE)
+		{
+			src_caches.push_back(thread_cache);
+		}
+	}
+
+	if (!src_caches.empty())
+	{
+		VK_CHECK(vkMergePipelineCaches(device.get_handle(), handle, to_u32(src_caches.size()), src_caches.data()));
+	}
+}
+
+bool PipelineCacheManager::save()
+{
+	merge();
+
+	size_t size{0};
+	VK_CHECK(vkGetPipelineCacheData(device.get_handle(), handle, &size, nullptr));
+
+	if (size > max_file_size)
+	{
+		LOGW("Pipeline cache is too big to be saved ({} of {} bytes)", size, max_file_size);
+		return false;
+	}
+
+	std::vector<uint8_t> file(sizeof(FileHeader) + size);
+
+	VK_CHECK(vkGetPipelineCacheData(device.get_handle(), handle, &size, file.data() + sizeof(FileHeader)));
+
+	FileHeader header{FILE_MAGIC, FILE_VERSION, to_u32(size), cold_creation_time};
+	std::memcpy(file.data(), &header, sizeof(FileHeader));
+
+	file.resize(sizeof(FileHeader) + size);
+
+	// Write to a temporary file first, so that the previous cache stays valid until the new one is complete
+	const std::string temp_filename = filename + ".tmp";
+
+	try
+	{
+		fs::write_temp(file, temp_filename);
+	}
+	catch (std::runtime_error &ex)
+	{
+		LOGE("Cannot save pipeline cache. {}", ex.what());
+		return false;
+	}
+
+	const std::string temp_path = fs::path::get(fs::path::Type::Temp) + temp_filename;
+	const std::string path      = fs::path::get(fs::path::Type::Temp) + filename;
+
+	if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+	{
+		// Some platforms do not replace existing files on rename
+		std::remove(path.c_str());
+
+		if (std::rename(temp_path.c_str(), path.c_str()) != 0)
+		{
+			LOGE("Cannot replace pipeline cache file {}", path);
+			return false;
+		}
+	}
+
+	saved_size = size;
+
+	return true;
+}
+
+void PipelineCacheManager::update(float delta_time)
+{
+	if (first_frame)
+	{
+		first_frame = false;
+
+		std::lock_guard<std::mutex> guard(creation_time_mutex);
+
+		if (!warm)
+		{
+			cold_creation_time = static_cast<float>(creation_time);
+
+			LOGI("Pipeline creation time until first frame: {:.1f} ms (no pipeline cache)", creation_time);
+		}
+		else if (cold_creation_time > 0.0f)
+		{
+			LOGI("Pipeline creation time until first frame: {:.1f} ms (pipeline cache saved {:.1f} ms)", creation_time, cold_creation_time - creation_time);
+		}
+		else
+		{
+			LOGI("Pipeline creation time until first frame: {:.1f} ms (pipeline cache)", creation_time);
+		}
+	}
+
+	time_since_save += delta_time;
+
+	if (time_since_save < SAVE_INTERVAL)
+	{
+		return;
+	}
+
+	time_since_save = 0.0f;
+
+	merge();
+
+	size_t size{0};
+	VK_CHECK(vkGetPipelineCacheData(device.get_handle(), handle, &size, nullptr));
+
+	// Only save if new pipelines have been added
+	if (size != saved_size)
+	{
+		save();
+	}
+}
+
+void PipelineCacheManager::add_creation_time(double time)
+{
+	std::lock_guard<std::mutex> guard(creation_time_mutex);
+
+	creation_time += time;
+}
+
+bool PipelineCacheManager::is_warm() const
+{
+	return warm;
+}
+
+std::vector<uint8_t> PipelineCacheManager::load()
+{
+	std::vector<uint8_t> file;
+
+	try
+	{
+		file = fs::read_temp(filename);
+	}
+	catch (std::runtime_error &ex)
+	{
+		LOGI("No pipeline cache found. {}", ex.what());
+		return {};
+	}
+
+	FileHeader header{};
+
+	if (file.size() >= sizeof(FileHeader))
+	{
+		std::memcpy(&header, file.data(), sizeof(FileHeader));
+	}
+
+	if (header.magic != FILE_MAGIC || header.version != FILE_VERSION || header.data_size != file.size() - sizeof(FileHeader))
+	{
+		LOGW("Discarding pipeline cache: {} is corrupted or from an older version", filename);
+		return {};
+	}
+
+	std::vector<uint8_t> data{file.begin() + sizeof(FileHeader), file.end()};
+
+	if (!is_compatible(data))
+	{
+		LOGW("Discarding pipeline cache: {} was created by a different device or driver", filename);
+		return {};
+	}
+
+	cold_creation_time = header.cold_creation_time;
+
+	return data;
+}
+
+bool PipelineCacheManager::is_compatible(const std::vector<uint8_t> &data) const
+{
+	CacheHeader header{};
+
+	if (data.size() < sizeof(CacheHeader))
+	{
+		return false;
+	}
+
+	std::memcpy(&header, data.data(), sizeof(CacheHeader));
+
+	const auto &properties = device.get_properties();
+
+	return header.header_size >= sizeof(CacheHeader) &&
+	       header.header_version == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+	       header.vendor_id == properties.vendorID &&
+	       header.device_id == properties.deviceID &&
+	       std::memcmp(header.pipeline_cache_uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+}        // namespace vkb
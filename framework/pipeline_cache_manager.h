@@ -0,0 +1,166 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "common/helpers.h"
+#include "common/vk_common.h"
+
+namespace vkb
+{
+class Device;
+
+/**
+ * @brief Owns the pipeline caches of a device and persists them across runs.
+ *
+ * On creation the cache file is loaded from temporary storage and validated
+ * against the properties of the physical device, an invalid file is discarded.
+ * Worker threads can request their own cache to avoid contention, those are
+ * merged into the main cache before saving. Pipelines are created under a shared
+ * lock and merges take it exclusively, so the render thread can save while other
+ * threads are creating pipelines. Saves happen periodically and on
+ * destruction, writing to a temporary file which is then renamed, so that a
+ * crash never leaves a truncated cache behind.
+ */
+class PipelineCacheManager
+{
+  public:
+	/**
+	 * @brief Default maximum size of the cache file in megabytes
+	 */
+	static constexpr uint32_t MAX_FILE_SIZE = 32;
+
+	/**
+	 * @brief Default interval between two saves in seconds
+	 */
+	static constexpr float SAVE_INTERVAL = 30.0f;
+
+	/**
+	 * @brief Name of the cache file of devices which are not given one
+	 */
+	static const char *const DEFAULT_FILENAME;
+
+	/**
+	 * @param device A valid device
+	 * @param filename Name of the cache file, relative to the temporary storage directory
+	 * @param max_file_size Caches bigger than this size in bytes are not saved
+	 */
+	PipelineCacheManager(Device &device, const std::string &filename = DEFAULT_FILENAME, size_t max_file_size = MAX_FILE_SIZE * 1024 * 1024);
+
+	PipelineCacheManager(const PipelineCacheManager &) = delete;
+
+	PipelineCacheManager(PipelineCacheManager &&) = delete;
+
+	~PipelineCacheManager();
+
+	PipelineCacheManager &operator=(const PipelineCacheManager &) = delete;
+
+	PipelineCacheManager &operator=(PipelineCacheManager &&) = delete;
+
+	/**
+	 * @return The main pipeline cache
+	 */
+	VkPipelineCache get_handle() const;
+
+	/**
+	 * @brief Requests the cache of a worker thread, created on first use
+	 * @param thread_index Index of the thread
+	 * @return A pipeline cache only used by that thread, merged into the main cache on save
+	 */
+	VkPipelineCache get_thread_cache(size_t thread_index);
+
+	/**
+	 * @brief Must be held while creating a pipeline with one of the caches,
+	 *        merges wait until every pipeline being created is done
+	 * @return A lock shared with the other threads creating pipelines
+	 */
+	std::shared_lock<std::shared_timed_mutex> lock_creation();
+
+	/**
+	 * @brief Merges the caches of the worker threads into the main cache
+	 */
+	void merge();
+
+	/**
+	 * @brief Merges the caches and writes the main cache to disk
+	 * @return Whether the file was written
+	 */
+	bool save();
+
+	/**
+	 * @brief Saves the cache periodically if it has grown, and reports the
+	 *        pipeline creation time of the first frame
+	 * @param delta_time Time passed since the last update
+	 */
+	void update(float delta_time);
+
+	/**
+	 * @brief Accounts the time spent creating a pipeline
+	 * @param time Creation time in milliseconds
+	 */
+	void add_creation_time(double time);
+
+	/**
+	 * @return Whether a valid cache was loaded from disk
+	 */
+	bool is_warm() const;
+
+  private:
+	std::vector<uint8_t> load();
+
+	bool is_compatible(const std::vector<uint8_t> &data) const;
+
+	Device &device;
+
+	std::string filename;
+
+	size_t max_file_size{0};
+
+	VkPipelineCache handle{VK_NULL_HANDLE};
+
+	std::vector<VkPipelineCache> thread_caches;
+
+	std::mutex thread_caches_mutex;
+
+	/// Shared by pipeline creations, exclusive for merges which write to the main cache
+	std::shared_timed_mutex creation_mutex;
+
+	bool warm{false};
+
+	size_t saved_size{0};
+
+	float time_since_save{0.0f};
+
+	bool first_frame{true};
+
+	std::mutex creation_time_mutex;
+
+	double creation_time{0.0};
+
+	/// Pipeline creation time until the end of the first frame of a run without a valid cache
+	float cold_creation_time{0.0f};
+};
+}        // namespace vkb
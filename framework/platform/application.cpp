@@ -147,6 +147,16 @@ void Application::set_headless(bool headless)
 	this->headless = headless;
 }
 
+bool Application::uses_null_driver() const
+{
+	return null_driver;
+}
+
+void Application::set_null_driver(bool null_driver)
+{
+	this->null_driver = null_driver;
+}
+
 void Application::set_focus(bool flag)
 {
 	focus = flag;
@@ -93,6 +93,10 @@ class Application
 
 	void set_headless(bool headless);
 
+	bool uses_null_driver() const;
+
+	void set_null_driver(bool null_driver);
+
 	bool is_focused() const;
 
 	void set_focus(bool flag);
@@ -123,6 +127,8 @@ class Application
 
 	bool headless{false};
 
+	bool null_driver{false};
+
 	bool benchmark_mode{false};
 
 	// The debug info of the app
@@ -20,6 +20,9 @@
 
 #include "platform/filesystem.h"
 
+#include <memory>
+
+#include "asset_pack.h"
 #include "common/error.h"
 
 VKBP_DISABLE_WARNINGS()
@@ -109,6 +112,44 @@ void create_path(const std::string &root, const std::string &path)
 	}
 }
 
+static std::vector<std::unique_ptr<AssetPack>> mounted_packs;
+
+/**
+ * @brief Reads a file from the mounted packs
+ * @param name The name of the file, relative to the root of the application
+ * @return False if no mounted pack contains the file
+ */
+static bool read_packed_file(const std::string &name, std::vector<uint8_t> &data, const uint32_t count)
+{
+	for (auto pack = mounted_packs.rbegin(); pack != mounted_packs.rend(); ++pack)
+	{
+		if ((*pack)->read(name, data, count))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool mount_pack(const std::string &path)
+{
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0)
+	{
+		return false;
+	}
+
+	mounted_packs.push_back(std::make_unique<AssetPack>(path));
+
+	return true;
+}
+
+void unmount_packs()
+{
+	mounted_packs.clear();
+}
+
 static std::vector<uint8_t> read_binary_file(const std::string &filename, const uint32_t count)
 {
 	std::vector<uint8_t> data;
@@ -158,13 +199,43 @@ static void write_binary_file(const std::vector<uint8_t> &data, const std::strin
 	file.close();
 }
 
+bool asset_exists(const std::string &filename)
+{
+	auto name = path::relative_paths.at(path::Type::Assets) + filename;
+
+	for (auto &pack : mounted_packs)
+	{
+		if (pack->contains(name))
+		{
+			return true;
+		}
+	}
+
+	struct stat info;
+	return stat((path::get(path::Type::Assets) + filename).c_str(), &info) == 0;
+}
+
 std::vector<uint8_t> read_asset(const std::string &filename, const uint32_t count)
 {
+	std::vector<uint8_t> data;
+
+	if (read_packed_file(path::relative_paths.at(path::Type::Assets) + filename, data, count))
+	{
+		return data;
+	}
+
 	return read_binary_file(path::get(path::Type::Assets) + filename, count);
 }
 
 std::vector<uint8_t> read_shader(const std::string &filename)
 {
+	std::vector<uint8_t> data;
+
+	if (read_packed_file(path::relative_paths.at(path::Type::Shaders) + filename, data, 0))
+	{
+		return data;
+	}
+
 	return read_binary_file(path::get(path::Type::Shaders) + filename, 0);
 }
 
@@ -85,6 +85,30 @@ void create_directory(const std::string &path);
  */
 void create_path(const std::string &root, const std::string &path);
 
+/**
+ * @brief Mounts an asset pack built by the asset_packer tool
+ *
+ * Assets and shaders found in a mounted pack are read from it rather than from their
+ * directories, packs mounted last are searched first. Packs must not be mounted or
+ * unmounted while files are being read.
+ *
+ * @param path The path to the pack
+ * @return False if there is no file at the path
+ * @throws runtime_error if the file is not a valid pack
+ */
+bool mount_pack(const std::string &path);
+
+/**
+ * @brief Unmounts every mounted asset pack
+ */
+void unmount_packs();
+
+/**
+ * @brief Helper to tell if an asset exists, in a mounted pack or in the assets directory
+ * @param filename The path to the file (relative to the assets directory)
+ */
+bool asset_exists(const std::string &filename);
+
 /**
  * @brief Helper to read an asset file into a byte-array
  *
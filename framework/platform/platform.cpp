@@ -24,8 +24,7 @@
 #include <mutex>
 #include <vector>
 
-#include <spdlog/async_logger.h>
-#include <spdlog/details/thread_pool.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
 
@@ -34,6 +33,15 @@
 
 namespace vkb
 {
+namespace
+{
+// Number of messages the asynchronous logger can hold before overwriting the oldest ones
+constexpr size_t LOG_QUEUE_SIZE = 8192;
+
+// Name of the asset pack mounted from the external storage directory when it exists
+const char DEFAULT_PACK_NAME[] = "vkb.pack";
+}        // namespace
+
 std::vector<std::string> Platform::arguments = {};
 
 std::string Platform::external_storage_directory = "";
@@ -47,15 +55,24 @@ bool Platform::initialize(std::unique_ptr<Application> &&app)
 
 	auto sinks = get_platform_sinks();
 
+#ifdef VKB_ASYNC_LOGGING
+	// Messages are formatted by the caller and written to the sinks by a background thread,
+	// a full queue drops the oldest message rather than blocking the thread that logs
+	spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+	auto logger = std::make_shared<spdlog::async_logger>("logger", sinks.begin(), sinks.end(),
+	                                                     spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+#else
 	auto logger = std::make_shared<spdlog::logger>("logger", sinks.begin(), sinks.end());
+#endif
 
-#ifdef VKB_DEBUG
+#if VKB_LOG_LEVEL <= VKB_LOG_LEVEL_DEBUG
 	logger->set_level(spdlog::level::debug);
 #else
 	logger->set_level(spdlog::level::info);
 #endif
 
 	logger->set_pattern(LOGGER_FORMAT);
+	logger->flush_on(spdlog::level::err);
 	spdlog::set_default_logger(logger);
 
 	LOGI("Logger initialized");
@@ -72,6 +89,24 @@ bool Platform::initialize(std::unique_ptr<Application> &&app)
 	// Set the app as headless
 	active_app->set_headless(active_app->get_options().contains("--headless"));
 
+	// Set the app to run without a GPU
+	active_app->set_null_driver(active_app->get_options().contains("--null-driver"));
+
+	// Read assets and shaders from a pack, one file mapped instead of a file opened per asset
+	if (active_app->get_options().contains("--pack"))
+	{
+		auto pack_path = active_app->get_options().get_string("--pack");
+
+		if (!fs::mount_pack(pack_path))
+		{
+			LOGW("Asset pack {} not found, reading files from the assets and shaders directories", pack_path);
+		}
+	}
+	else
+	{
+		fs::mount_pack(external_storage_directory + DEFAULT_PACK_NAME);
+	}
+
 	create_window();
 
 	if (!window)
@@ -135,7 +170,10 @@ void Platform::terminate(ExitCode code)
 	active_app.reset();
 	window.reset();
 
-	spdlog::drop_all();
+	fs::unmount_packs();
+
+	// Flushes pending messages and joins the thread of the asynchronous logger
+	spdlog::shutdown();
 }
 
 void Platform::close() const
@@ -0,0 +1,243 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rendering/compute_skinning.h"
+
+#include "common/error.h"
+
+VKBP_DISABLE_WARNINGS()
+#include <glm/glm.hpp>
+VKBP_ENABLE_WARNINGS()
+
+#include "common/utils.h"
+#include "core/command_buffer.h"
+#include "platform/filesystem.h"
+#include "rendering/render_context.h"
+#include "scene_graph/components/mesh.h"
+#include "scene_graph/components/skin.h"
+#include "scene_graph/components/sub_mesh.h"
+#include "scene_graph/node.h"
+#include "scene_graph/scene.h"
+#include "timer.h"
+
+namespace vkb
+{
+namespace
+{
+// Matches local_size_x in skinning.comp
+constexpr uint32_t WORKGROUP_SIZE = 64;
+
+/**
+ * @brief Push constants of the skinning shader, strides are in floats
+ */
+struct SkinningUniform
+{
+	uint32_t vertex_count;
+
+	uint32_t position_stride;
+
+	uint32_t normal_stride;
+};
+
+uint32_t get_float_stride(const sg::SubMesh &sub_mesh, const std::string &attribute_name)
+{
+	sg::VertexAttribute attribute;
+	sub_mesh.get_attribute(attribute_name, attribute);
+
+	return attribute.stride / to_u32(sizeof(float));
+}
+}        // namespace
+
+ComputeSkinning::ComputeSkinning(RenderContext &render_context, sg::Scene &scene) :
+    render_context{render_context},
+    shader_source{fs::read_shader("skinning.comp")}
+{
+	auto &device = render_context.get_device();
+
+	for (auto mesh : scene.get_components<sg::Mesh>())
+	{
+		for (auto node : mesh->get_nodes())
+		{
+			if (!node->has_component<sg::Skin>())
+			{
+				continue;
+			}
+
+			for (auto sub_mesh : mesh->get_submeshes())
+			{
+				auto &vertex_buffers = sub_mesh->vertex_buffers;
+
+				if (vertex_buffers.count("position") == 0 || vertex_buffers.count("joints_0") == 0 || vertex_buffers.count("weights_0") == 0)
+				{
+					continue;
+				}
+
+				Instance instance;
+				instance.node     = node;
+				instance.sub_mesh = sub_mesh;
+				instance.skin     = &node->get_component<sg::Skin>();
+
+				// Outputs have the layout of the inputs, so the vertex input state of the submesh still applies
+				instance.output.position = std::make_unique<core::Buffer>(device,
+				                                                          vertex_buffers.at("position").get_size(),
+				                                                          VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				                                                          VMA_MEMORY_USAGE_GPU_ONLY);
+
+				auto normal_it = vertex_buffers.find("normal");
+				if (normal_it != vertex_buffers.end())
+				{
+					instance.output.normal = std::make_unique<core::Buffer>(device,
+					                                                        normal_it->second.get_size(),
+					                                                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+					                                                        VMA_MEMORY_USAGE_GPU_ONLY);
+				}
+
+				instance_indices[node][sub_mesh] = instances.size();
+				instances.push_back(std::move(instance));
+			}
+		}
+	}
+
+	LOGI("Compute skinning prepared {} skinned instances", instances.size());
+}
+
+void ComputeSkinning::dispatch(CommandBuffer &command_buffer)
+{
+	Timer timer;
+	timer.start();
+
+	auto &render_frame   = render_context.get_active_frame();
+	auto &resource_cache = render_context.get_device().get_resource_cache();
+
+	// The outputs may still be read by the vertex input of the previous frame
+	BufferMemoryBarrier write_barrier{};
+	write_barrier.src_stage_mask  = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+	write_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	write_barrier.src_access_mask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+	write_barrier.dst_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+
+	BufferMemoryBarrier read_barrier{};
+	read_barrier.src_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	read_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+	read_barrier.src_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+	read_barrier.dst_access_mask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+
+	// Joint matrices are uploaded once per skin, even if several instances share it
+	std::unordered_map<const sg::Skin *, BufferAllocation> joint_palettes;
+
+	std::vector<glm::mat4> joint_matrices;
+
+	for (auto &instance : instances)
+	{
+		auto &sub_mesh = *instance.sub_mesh;
+		auto &output   = instance.output;
+
+		auto palette_it = joint_palettes.find(instance.skin);
+
+		if (palette_it == joint_palettes.end())
+		{
+			instance.skin->compute_joint_matrices(joint_matrices, render_frame.get_scene_snapshot());
+
+			auto data = reinterpret_cast<const uint8_t *>(joint_matrices.data());
+
+			auto allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, joint_matrices.size() * sizeof(glm::mat4));
+			allocation.update(std::vector<uint8_t>{data, data + joint_matrices.size() * sizeof(glm::mat4)});
+
+			palette_it = joint_palettes.emplace(instance.skin, std::move(allocation)).first;
+		}
+
+		auto &palette = palette_it->second;
+
+		ShaderVariant variant;
+		if (output.normal)
+		{
+			variant.add_define("HAS_NORMAL");
+		}
+
+		auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, shader_source, variant);
+		auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
+
+		command_buffer.bind_pipeline_layout(pipeline_layout);
+
+		command_buffer.buffer_memory_barrier(*output.position, 0, VK_WHOLE_SIZE, write_barrier);
+
+		auto &position = sub_mesh.vertex_buffers.at("position");
+		auto &joints   = sub_mesh.vertex_buffers.at("joints_0");
+		auto &weights  = sub_mesh.vertex_buffers.at("weights_0");
+
+		command_buffer.bind_buffer(position, 0, position.get_size(), 0, 0, 0);
+		command_buffer.bind_buffer(joints, 0, joints.get_size(), 0, 2, 0);
+		command_buffer.bind_buffer(weights, 0, weights.get_size(), 0, 3, 0);
+		command_buffer.bind_buffer(palette.get_buffer(), palette.get_offset(), palette.get_size(), 0, 4, 0);
+		command_buffer.bind_buffer(*output.position, 0, output.position->get_size(), 0, 5, 0);
+
+		SkinningUniform skinning_uniform{};
+		skinning_uniform.vertex_count    = sub_mesh.vertices_count;
+		skinning_uniform.position_stride = get_float_stride(sub_mesh, "position");
+
+		if (output.normal)
+		{
+			auto &normal = sub_mesh.vertex_buffers.at("normal");
+
+			command_buffer.buffer_memory_barrier(*output.normal, 0, VK_WHOLE_SIZE, write_barrier);
+
+			command_buffer.bind_buffer(normal, 0, normal.get_size(), 0, 1, 0);
+			command_buffer.bind_buffer(*output.normal, 0, output.normal->get_size(), 0, 6, 0);
+
+			skinning_uniform.normal_stride = get_float_stride(sub_mesh, "normal");
+		}
+
+		command_buffer.push_constants(0, skinning_uniform);
+
+		command_buffer.dispatch((sub_mesh.vertices_count + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+		command_buffer.buffer_memory_barrier(*output.position, 0, VK_WHOLE_SIZE, read_barrier);
+
+		if (output.normal)
+		{
+			command_buffer.buffer_memory_barrier(*output.normal, 0, VK_WHOLE_SIZE, read_barrier);
+		}
+	}
+
+	skinning_time = timer.stop<Timer::Milliseconds>();
+}
+
+const ComputeSkinning::Output *ComputeSkinning::get_output(const sg::Node &node, const sg::SubMesh &sub_mesh) const
+{
+	auto node_it = instance_indices.find(&node);
+	if (node_it == instance_indices.end())
+	{
+		return nullptr;
+	}
+
+	auto sub_mesh_it = node_it->second.find(&sub_mesh);
+	if (sub_mesh_it == node_it->second.end())
+	{
+		return nullptr;
+	}
+
+	return &instances[sub_mesh_it->second].output;
+}
+
+double ComputeSkinning::get_skinning_time() const
+{
+	return skinning_time;
+}
+}        // namespace vkb
@@ -0,0 +1,120 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "core/buffer.h"
+#include "core/shader_module.h"
+
+namespace vkb
+{
+class CommandBuffer;
+class RenderContext;
+
+namespace sg
+{
+class Node;
+class Scene;
+class Skin;
+class SubMesh;
+}        // namespace sg
+
+/**
+ * @brief Deforms the skinned meshes of a scene in a compute dispatch, once per frame
+ *
+ * The positions and normals of every skinned instance are written to buffers in world space,
+ * which any pass drawing the scene can use as vertex buffers (depth pre-pass, shadows, main pass),
+ * instead of each of them skinning the vertices again in its vertex shader.
+ * Set it to a SceneSubpass with SceneSubpass::set_compute_skinning().
+ */
+class ComputeSkinning
+{
+  public:
+	/**
+	 * @brief Deformed vertices of a skinned submesh drawn by a node
+	 */
+	struct Output
+	{
+		std::unique_ptr<core::Buffer> position;
+
+		/// Empty if the submesh has no normals
+		std::unique_ptr<core::Buffer> normal;
+	};
+
+	/**
+	 * @brief Creates the output buffers of all the skinned instances of a scene
+	 */
+	ComputeSkinning(RenderContext &render_context, sg::Scene &scene);
+
+	ComputeSkinning(const ComputeSkinning &) = delete;
+
+	ComputeSkinning(ComputeSkinning &&) = delete;
+
+	~ComputeSkinning() = default;
+
+	ComputeSkinning &operator=(const ComputeSkinning &) = delete;
+
+	ComputeSkinning &operator=(ComputeSkinning &&) = delete;
+
+	/**
+	 * @brief Uploads the joint matrices of the frame and records the dispatches
+	 *        followed by a barrier for the vertex input stage
+	 * @param command_buffer Command buffer of the active frame, outside of a render pass
+	 */
+	void dispatch(CommandBuffer &command_buffer);
+
+	/**
+	 * @return The deformed vertices of a submesh drawn by a node, nullptr if it is not skinned
+	 */
+	const Output *get_output(const sg::Node &node, const sg::SubMesh &sub_mesh) const;
+
+	/**
+	 * @return The CPU time spent by the last dispatch() in milliseconds
+	 */
+	double get_skinning_time() const;
+
+  private:
+	struct Instance
+	{
+		sg::Node *node{nullptr};
+
+		sg::SubMesh *sub_mesh{nullptr};
+
+		sg::Skin *skin{nullptr};
+
+		Output output;
+	};
+
+	RenderContext &render_context;
+
+	ShaderSource shader_source;
+
+	std::vector<Instance> instances;
+
+	/// Index of each instance, by node and submesh
+	std::unordered_map<const sg::Node *, std::unordered_map<const sg::SubMesh *, size_t>> instance_indices;
+
+	double skinning_time{0.0};
+};
+}        // namespace vkb
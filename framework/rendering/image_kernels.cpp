@@ -0,0 +1,292 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rendering/image_kernels.h"
+
+#include <algorithm>
+
+#include "common/error.h"
+#include "common/utils.h"
+#include "core/command_buffer.h"
+#include "core/device.h"
+#include "platform/filesystem.h"
+
+namespace vkb
+{
+namespace
+{
+// Matches TILE_SIZE and LEVEL_COUNT in downsample.comp
+constexpr uint32_t TILE_SIZE = 8;
+
+constexpr uint32_t LEVELS_PER_DISPATCH = 4;
+
+// Matches local_size_x and local_size_y in convert.comp
+constexpr uint32_t CONVERT_GROUP_SIZE = 8;
+
+/**
+ * @brief Push constants of the reduction shader
+ */
+struct DownsampleUniform
+{
+	int32_t src_width;
+
+	int32_t src_height;
+
+	int32_t dst_width;
+
+	int32_t dst_height;
+
+	int32_t level_count;
+};
+
+/**
+ * @brief Push constants of the conversion shader
+ */
+struct ConvertUniform
+{
+	int32_t width;
+
+	int32_t height;
+};
+
+/**
+ * @return The GLSL format qualifier of a storage image format, nullptr if there is none
+ */
+const char *get_format_qualifier(VkFormat format)
+{
+	switch (format)
+	{
+		case VK_FORMAT_R8G8B8A8_UNORM:
+			return "rgba8";
+		case VK_FORMAT_R8G8B8A8_SNORM:
+			return "rgba8_snorm";
+		case VK_FORMAT_R16G16B16A16_SFLOAT:
+			return "rgba16f";
+		case VK_FORMAT_R32G32B32A32_SFLOAT:
+			return "rgba32f";
+		case VK_FORMAT_R32_SFLOAT:
+			return "r32f";
+		default:
+			return nullptr;
+	}
+}
+
+/**
+ * @return The extent of the first mip level of a view
+ */
+VkExtent3D get_extent(const core::ImageView &view)
+{
+	auto extent = view.get_image().get_extent();
+	auto level  = view.get_subresource_range().baseMipLevel;
+
+	return {std::max(1u, extent.width >> level), std::max(1u, extent.height >> level), 1u};
+}
+
+VkSamplerCreateInfo get_sampler_info()
+{
+	VkSamplerCreateInfo sampler_info{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
+
+	sampler_info.magFilter    = VK_FILTER_NEAREST;
+	sampler_info.minFilter    = VK_FILTER_NEAREST;
+	sampler_info.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+	return sampler_info;
+}
+
+/**
+ * @brief Makes the writes of a dispatch visible to the next one, the layout stays general
+ */
+void compute_barrier(CommandBuffer &command_buffer, const core::ImageView &view)
+{
+	ImageMemoryBarrier memory_barrier{};
+	memory_barrier.old_layout      = VK_IMAGE_LAYOUT_GENERAL;
+	memory_barrier.new_layout      = VK_IMAGE_LAYOUT_GENERAL;
+	memory_barrier.src_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+	memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
+	memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+	memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+	command_buffer.image_memory_barrier(view, memory_barrier);
+}
+}        // namespace
+
+ImageKernels::ImageKernels(Device &device) :
+    device{device},
+    downsample_source{fs::read_shader("downsample.comp")},
+    convert_source{fs::read_shader("convert.comp")},
+    sampler{device, get_sampler_info()}
+{
+}
+
+bool ImageKernels::is_format_supported(VkFormat format) const
+{
+	return get_format_qualifier(format) != nullptr &&
+	       (device.get_format_properties(format).optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+}
+
+std::vector<core::ImageView> ImageKernels::create_level_views(core::Image &image, uint32_t array_layer)
+{
+	auto level_count = image.get_subresource().mipLevel;
+
+	std::vector<core::ImageView> level_views;
+	level_views.reserve(level_count);
+
+	for (uint32_t level = 0; level < level_count; ++level)
+	{
+		level_views.emplace_back(image, VK_IMAGE_VIEW_TYPE_2D, VK_FORMAT_UNDEFINED, level, array_layer, 1, 1);
+	}
+
+	return level_views;
+}
+
+void ImageKernels::generate_mipmaps(CommandBuffer &command_buffer, const std::vector<core::ImageView> &level_views)
+{
+	for (uint32_t level = 1; level < to_u32(level_views.size()); level += LEVELS_PER_DISPATCH)
+	{
+		// The first level of a dispatch is reduced from the last level of the previous one
+		if (level > 1)
+		{
+			compute_barrier(command_buffer, level_views[level - 1]);
+		}
+
+		downsample(command_buffer, level_views[level - 1], false, level_views, level, false);
+	}
+}
+
+void ImageKernels::convert(CommandBuffer &command_buffer, const core::ImageView &src, const core::ImageView &dst)
+{
+	auto format_qualifier = get_format_qualifier(dst.get_format());
+	assert(format_qualifier && "Format cannot be written by the kernels");
+
+	auto extent = get_extent(dst);
+	assert(extent.width == get_extent(src).width && extent.height == get_extent(src).height && "Images must have the same size");
+
+	ShaderVariant variant;
+	variant.add_define(std::string{"FORMAT="} + format_qualifier);
+
+	auto &resource_cache  = device.get_resource_cache();
+	auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, convert_source, variant);
+	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
+
+	command_buffer.bind_pipeline_layout(pipeline_layout);
+
+	command_buffer.bind_image(src, sampler, 0, 0, 0);
+	command_buffer.bind_input(dst, 0, 1, 0);
+
+	ConvertUniform convert_uniform{};
+	convert_uniform.width  = static_cast<int32_t>(extent.width);
+	convert_uniform.height = static_cast<int32_t>(extent.height);
+
+	command_buffer.push_constants(0, convert_uniform);
+
+	command_buffer.dispatch((extent.width + CONVERT_GROUP_SIZE - 1) / CONVERT_GROUP_SIZE, (extent.height + CONVERT_GROUP_SIZE - 1) / CONVERT_GROUP_SIZE, 1);
+}
+
+VkExtent3D ImageKernels::get_depth_pyramid_extent(const VkExtent3D &depth_extent)
+{
+	auto previous_power_of_two = [](uint32_t value) {
+		uint32_t result = 1;
+		while (result * 2 <= value)
+		{
+			result *= 2;
+		}
+		return result;
+	};
+
+	return {previous_power_of_two(depth_extent.width), previous_power_of_two(depth_extent.height), 1u};
+}
+
+void ImageKernels::build_depth_pyramid(CommandBuffer &command_buffer, const core::ImageView &depth, const std::vector<core::ImageView> &pyramid_views)
+{
+	assert(!pyramid_views.empty() && pyramid_views.front().get_format() == VK_FORMAT_R32_SFLOAT && "Depth pyramid must be a R32_SFLOAT image");
+
+	// The first levels are reduced from the depth image, the others from the last level of the previous dispatch
+	downsample(command_buffer, depth, true, pyramid_views, 0, true);
+
+	for (uint32_t level = LEVELS_PER_DISPATCH; level < to_u32(pyramid_views.size()); level += LEVELS_PER_DISPATCH)
+	{
+		compute_barrier(command_buffer, pyramid_views[level - 1]);
+
+		downsample(command_buffer, pyramid_views[level - 1], false, pyramid_views, level, true);
+	}
+}
+
+void ImageKernels::downsample(CommandBuffer &command_buffer, const core::ImageView &src, bool sampled,
+                              const std::vector<core::ImageView> &level_views, uint32_t level, bool reduce_max)
+{
+	auto &dst = level_views.at(level);
+
+	auto format_qualifier = get_format_qualifier(dst.get_format());
+	assert(format_qualifier && "Format cannot be written by the kernels");
+
+	ShaderVariant variant;
+	variant.add_define(std::string{"FORMAT="} + format_qualifier);
+
+	if (sampled)
+	{
+		variant.add_define("SAMPLED_SOURCE");
+	}
+
+	if (reduce_max)
+	{
+		variant.add_define("REDUCE_MAX");
+	}
+
+	auto &resource_cache  = device.get_resource_cache();
+	auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, downsample_source, variant);
+	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
+
+	command_buffer.bind_pipeline_layout(pipeline_layout);
+
+	if (sampled)
+	{
+		command_buffer.bind_image(src, sampler, 0, 0, 0);
+	}
+	else
+	{
+		command_buffer.bind_input(src, 0, 0, 0);
+	}
+
+	auto level_count = std::min(LEVELS_PER_DISPATCH, to_u32(level_views.size()) - level);
+
+	for (uint32_t i = 0; i < LEVELS_PER_DISPATCH; ++i)
+	{
+		// Every element of the array needs a valid descriptor, the shader does not write the extra ones
+		command_buffer.bind_input(level_views[level + std::min(i, level_count - 1)], 0, 1, i);
+	}
+
+	auto src_extent = get_extent(src);
+	auto dst_extent = get_extent(dst);
+
+	DownsampleUniform downsample_uniform{};
+	downsample_uniform.src_width   = static_cast<int32_t>(src_extent.width);
+	downsample_uniform.src_height  = static_cast<int32_t>(src_extent.height);
+	downsample_uniform.dst_width   = static_cast<int32_t>(dst_extent.width);
+	downsample_uniform.dst_height  = static_cast<int32_t>(dst_extent.height);
+	downsample_uniform.level_count = static_cast<int32_t>(level_count);
+
+	command_buffer.push_constants(0, downsample_uniform);
+
+	command_buffer.dispatch((dst_extent.width + TILE_SIZE - 1) / TILE_SIZE, (dst_extent.height + TILE_SIZE - 1) / TILE_SIZE, 1);
+}
+}        // namespace vkb
@@ -0,0 +1,119 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "core/image_view.h"
+#include "core/sampler.h"
+#include "core/shader_module.h"
+
+namespace vkb
+{
+class CommandBuffer;
+class Device;
+
+/**
+ * @brief Compute kernels processing images on the GPU: mip chain generation,
+ *        format conversion and Hi-Z depth pyramids
+ *
+ * Each dispatch of the reduction kernel writes up to four mip levels, the levels after
+ * the first one are reduced in shared memory instead of being read back from memory.
+ * Storage images are bound with one 2D view per mip level, see create_level_views().
+ */
+class ImageKernels
+{
+  public:
+	ImageKernels(Device &device);
+
+	ImageKernels(const ImageKernels &) = delete;
+
+	ImageKernels(ImageKernels &&) = delete;
+
+	~ImageKernels() = default;
+
+	ImageKernels &operator=(const ImageKernels &) = delete;
+
+	ImageKernels &operator=(ImageKernels &&) = delete;
+
+	/**
+	 * @return Whether the kernels can write images of a format, which must have a GLSL format qualifier
+	 *         and support storage images with optimal tiling
+	 */
+	bool is_format_supported(VkFormat format) const;
+
+	/**
+	 * @brief Creates a 2D view of each mip level of a layer of an image, to bind them as storage images
+	 */
+	static std::vector<core::ImageView> create_level_views(core::Image &image, uint32_t array_layer = 0);
+
+	/**
+	 * @brief Records the dispatches generating every mip level of an image from its first level
+	 * @param command_buffer Command buffer outside of a render pass
+	 * @param level_views Views of the levels, their image in VK_IMAGE_LAYOUT_GENERAL
+	 *                    with the first level visible to compute shaders
+	 */
+	void generate_mipmaps(CommandBuffer &command_buffer, const std::vector<core::ImageView> &level_views);
+
+	/**
+	 * @brief Records the dispatch copying an image into another of the same size and of a different format
+	 * @param command_buffer Command buffer outside of a render pass
+	 * @param src View sampled by the kernel, in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+	 * @param dst View of a single level written by the kernel, in VK_IMAGE_LAYOUT_GENERAL
+	 */
+	void convert(CommandBuffer &command_buffer, const core::ImageView &src, const core::ImageView &dst);
+
+	/**
+	 * @return The extent of the first level of the Hi-Z pyramid of a depth image,
+	 *         the previous power of two so that every following level is an exact half
+	 */
+	static VkExtent3D get_depth_pyramid_extent(const VkExtent3D &depth_extent);
+
+	/**
+	 * @brief Records the dispatches building a Hi-Z pyramid, where each texel holds the farthest depth of its footprint
+	 * @param command_buffer Command buffer outside of a render pass
+	 * @param depth View of the depth aspect, in VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL
+	 * @param pyramid_views Views of the levels of a VK_FORMAT_R32_SFLOAT image with the extent of
+	 *                      get_depth_pyramid_extent(), in VK_IMAGE_LAYOUT_GENERAL
+	 */
+	void build_depth_pyramid(CommandBuffer &command_buffer, const core::ImageView &depth, const std::vector<core::ImageView> &pyramid_views);
+
+  private:
+	/**
+	 * @brief Records a dispatch of the reduction kernel, writing up to four levels
+	 * @param src Source of the first level, the previous level if not sampled
+	 * @param sampled Whether the source is sampled instead of bound as a storage image
+	 * @param level First level written by the dispatch
+	 * @param reduce_max Whether texels are reduced to their maximum instead of their average
+	 */
+	void downsample(CommandBuffer &command_buffer, const core::ImageView &src, bool sampled,
+	                const std::vector<core::ImageView> &level_views, uint32_t level, bool reduce_max);
+
+	Device &device;
+
+	ShaderSource downsample_source;
+
+	ShaderSource convert_source;
+
+	/// Nearest sampler clamping to the edges, texels are fetched without filtering
+	core::Sampler sampler;
+};
+}        // namespace vkb
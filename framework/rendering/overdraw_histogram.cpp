@@ -0,0 +1,272 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rendering/overdraw_histogram.h"
+
+#include <cstring>
+
+#include "common/utils.h"
+#include "core/command_buffer.h"
+#include "core/device.h"
+#include "platform/filesystem.h"
+#include "rendering/render_context.h"
+#include "rendering/subpasses/overdraw_subpass.h"
+
+namespace vkb
+{
+namespace
+{
+// Matches local_size_x and local_size_y in overdraw_histogram.comp
+constexpr uint32_t WORKGROUP_SIZE = 8;
+
+bool is_blendable(Device &device, VkFormat format)
+{
+	VkFormatProperties properties;
+	vkGetPhysicalDeviceFormatProperties(device.get_physical_device(), format, &properties);
+
+	return (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BLEND_BIT) != 0;
+}
+}        // namespace
+
+OverdrawHistogram::OverdrawHistogram(RenderContext &render_context, sg::Scene &scene, sg::Camera &camera) :
+    render_context{render_context},
+    shader_source{fs::read_shader("overdraw_histogram.comp")}
+{
+	auto &device = render_context.get_device();
+
+	// Blending is optional for 32-bit floats, 16-bit floats still count up to 2048 exactly
+	if (!is_blendable(device, format))
+	{
+		format = VK_FORMAT_R16_SFLOAT;
+	}
+
+	render_pipeline.add_subpass(std::make_unique<OverdrawSubpass>(render_context, scene, camera));
+
+	std::vector<LoadStoreInfo> load_store(2);
+	load_store[1].store_op = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	render_pipeline.set_load_store(load_store);
+
+	std::vector<VkClearValue> clear_value(2);
+	clear_value[0].color        = {0.0f, 0.0f, 0.0f, 0.0f};
+	clear_value[1].depthStencil = {1.0f, ~0U};
+	render_pipeline.set_clear_value(clear_value);
+
+	VkSamplerCreateInfo sampler_info{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
+	sampler_info.magFilter    = VK_FILTER_NEAREST;
+	sampler_info.minFilter    = VK_FILTER_NEAREST;
+	sampler_info.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+	sampler = std::make_unique<core::Sampler>(device, sampler_info);
+
+	LOGI("Overdraw is counted in a {} target", format == VK_FORMAT_R32_SFLOAT ? "R32" : "R16");
+}
+
+void OverdrawHistogram::record(CommandBuffer &command_buffer)
+{
+	auto frame_index = render_context.get_active_frame_index();
+
+	if (frame_index >= count_buffers.size())
+	{
+		count_buffers.resize(frame_index + 1);
+		counts_recorded.resize(frame_index + 1, false);
+	}
+
+	read_back(frame_index);
+
+	auto &extent = render_context.get_active_frame().get_render_target().get_extent();
+
+	prepare_render_target(extent);
+
+	auto &views = render_target->get_views();
+
+	{
+		// The previous frame may still be reading the overdraw, its content is cleared
+		ImageMemoryBarrier memory_barrier{};
+		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		memory_barrier.dst_access_mask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+		command_buffer.image_memory_barrier(views.at(0), memory_barrier);
+	}
+
+	{
+		ImageMemoryBarrier memory_barrier{};
+		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		memory_barrier.src_access_mask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+
+		command_buffer.image_memory_barrier(views.at(1), memory_barrier);
+	}
+
+	VkViewport viewport{};
+	viewport.width    = static_cast<float>(extent.width);
+	viewport.height   = static_cast<float>(extent.height);
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	command_buffer.set_viewport(0, {viewport});
+
+	VkRect2D scissor{};
+	scissor.extent = extent;
+	command_buffer.set_scissor(0, {scissor});
+
+	render_pipeline.draw(command_buffer, *render_target);
+
+	command_buffer.end_render_pass();
+
+	{
+		ImageMemoryBarrier memory_barrier{};
+		memory_barrier.old_layout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		memory_barrier.src_access_mask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+		command_buffer.image_memory_barrier(views.at(0), memory_barrier);
+	}
+
+	auto &count_buffer = count_buffers[frame_index];
+
+	if (!count_buffer)
+	{
+		count_buffer = std::make_unique<core::Buffer>(render_context.get_device(),
+		                                              sizeof(Counts),
+		                                              VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		                                              VMA_MEMORY_USAGE_GPU_TO_CPU);
+	}
+
+	command_buffer.update_buffer(*count_buffer, 0, std::vector<uint8_t>(sizeof(Counts), 0));
+
+	{
+		BufferMemoryBarrier memory_barrier{};
+		memory_barrier.src_access_mask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+		command_buffer.buffer_memory_barrier(*count_buffer, 0, VK_WHOLE_SIZE, memory_barrier);
+	}
+
+	auto &resource_cache  = render_context.get_device().get_resource_cache();
+	auto &shader_module   = resource_cache.request_shader_module(VK_SHADER_STAGE_COMPUTE_BIT, shader_source);
+	auto &pipeline_layout = resource_cache.request_pipeline_layout({&shader_module});
+
+	command_buffer.bind_pipeline_layout(pipeline_layout);
+
+	command_buffer.bind_image(views.at(0), *sampler, 0, 0, 0);
+	command_buffer.bind_buffer(*count_buffer, 0, count_buffer->get_size(), 0, 1, 0);
+
+	command_buffer.push_constants(0, std::array<uint32_t, 2>{extent.width, extent.height});
+
+	command_buffer.dispatch((extent.width + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, (extent.height + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1);
+
+	{
+		BufferMemoryBarrier memory_barrier{};
+		memory_barrier.src_access_mask = VK_ACCESS_SHADER_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_HOST_READ_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_HOST_BIT;
+
+		command_buffer.buffer_memory_barrier(*count_buffer, 0, VK_WHOLE_SIZE, memory_barrier);
+	}
+
+	counts_recorded[frame_index] = true;
+}
+
+const std::array<uint32_t, OverdrawHistogram::BIN_COUNT> &OverdrawHistogram::get_histogram() const
+{
+	return histogram;
+}
+
+float OverdrawHistogram::get_average_overdraw() const
+{
+	return average_overdraw;
+}
+
+VkFormat OverdrawHistogram::get_format() const
+{
+	return format;
+}
+
+void OverdrawHistogram::prepare_render_target(const VkExtent2D &extent)
+{
+	if (render_target && render_target->get_extent().width == extent.width && render_target->get_extent().height == extent.height)
+	{
+		return;
+	}
+
+	auto &device = render_context.get_device();
+
+	// Frames in flight may still use the previous target
+	if (render_target)
+	{
+		device.wait_idle();
+	}
+
+	VkExtent3D image_extent{extent.width, extent.height, 1};
+
+	core::Image overdraw_image{device, image_extent, format,
+	                           VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+	                           VMA_MEMORY_USAGE_GPU_ONLY};
+
+	core::Image depth_image{device, image_extent, get_suitable_depth_format(device.get_physical_device()),
+	                        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+	                        VMA_MEMORY_USAGE_GPU_ONLY};
+
+	std::vector<core::Image> images;
+	images.push_back(std::move(overdraw_image));
+	images.push_back(std::move(depth_image));
+
+	render_target = std::make_unique<RenderTarget>(std::move(images));
+}
+
+void OverdrawHistogram::read_back(uint32_t frame_index)
+{
+	if (!counts_recorded[frame_index])
+	{
+		return;
+	}
+
+	counts_recorded[frame_index] = false;
+
+	// The frame was reset, so its previous submission completed
+	auto &count_buffer = *count_buffers[frame_index];
+
+	Counts counts;
+	std::memcpy(&counts, count_buffer.map(), sizeof(Counts));
+	count_buffer.unmap();
+
+	histogram = counts.bins;
+
+	uint64_t pixel_count = 0;
+	for (auto bin : counts.bins)
+	{
+		pixel_count += bin;
+	}
+
+	average_overdraw = pixel_count > 0 ? static_cast<float>(counts.fragment_count) / pixel_count : 0.0f;
+}
+}        // namespace vkb
@@ -0,0 +1,134 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "core/buffer.h"
+#include "core/sampler.h"
+#include "core/shader_module.h"
+#include "rendering/render_pipeline.h"
+#include "rendering/render_target.h"
+
+namespace vkb
+{
+class CommandBuffer;
+class RenderContext;
+
+namespace sg
+{
+class Camera;
+class Scene;
+}        // namespace sg
+
+/**
+ * @brief Renders the overdraw of a scene with an OverdrawSubpass and reduces it to a histogram
+ *
+ * The overdraw is rendered to a float target of the size of the swapchain, then a compute
+ * dispatch counts the pixels for each overdraw into a buffer of the active frame.
+ * The buffer is read back once the frame is reset, so the histogram lags behind
+ * by the number of frames in flight.
+ */
+class OverdrawHistogram
+{
+  public:
+	/**
+	 * @brief Number of bins, the last one also counts the pixels shaded more times
+	 */
+	static constexpr uint32_t BIN_COUNT = 16;
+
+	OverdrawHistogram(RenderContext &render_context, sg::Scene &scene, sg::Camera &camera);
+
+	OverdrawHistogram(const OverdrawHistogram &) = delete;
+
+	OverdrawHistogram(OverdrawHistogram &&) = delete;
+
+	~OverdrawHistogram() = default;
+
+	OverdrawHistogram &operator=(const OverdrawHistogram &) = delete;
+
+	OverdrawHistogram &operator=(OverdrawHistogram &&) = delete;
+
+	/**
+	 * @brief Reads back the histogram of the previous submission of the active frame,
+	 *        then records the overdraw pass and the reduction
+	 * @param command_buffer Command buffer of the active frame, outside of a render pass
+	 */
+	void record(CommandBuffer &command_buffer);
+
+	/**
+	 * @return The number of pixels shaded as many times as the index of each bin
+	 */
+	const std::array<uint32_t, BIN_COUNT> &get_histogram() const;
+
+	/**
+	 * @return The average number of fragments shaded per pixel
+	 */
+	float get_average_overdraw() const;
+
+	/**
+	 * @return The format of the overdraw target, R32 if it can be blended or R16 otherwise
+	 */
+	VkFormat get_format() const;
+
+  private:
+	/**
+	 * @brief Content of the buffers written by the histogram shader
+	 */
+	struct Counts
+	{
+		std::array<uint32_t, BIN_COUNT> bins;
+
+		uint32_t fragment_count;
+	};
+
+	/**
+	 * @brief Creates the overdraw target if the swapchain was resized
+	 */
+	void prepare_render_target(const VkExtent2D &extent);
+
+	void read_back(uint32_t frame_index);
+
+	RenderContext &render_context;
+
+	ShaderSource shader_source;
+
+	VkFormat format{VK_FORMAT_R32_SFLOAT};
+
+	RenderPipeline render_pipeline;
+
+	std::unique_ptr<RenderTarget> render_target;
+
+	std::unique_ptr<core::Sampler> sampler;
+
+	/// Counts written by each frame, in host visible memory
+	std::vector<std::unique_ptr<core::Buffer>> count_buffers;
+
+	/// Whether each frame recorded the histogram in its last submission
+	std::vector<bool> counts_recorded;
+
+	std::array<uint32_t, BIN_COUNT> histogram{};
+
+	float average_overdraw{0.0f};
+};
+}        // namespace vkb
@@ -107,6 +107,16 @@ void SpecializationConstantState::clear_dirty()
 	dirty = false;
 }
 
+void SpecializationConstantState::clear_constants()
+{
+	if (!specialization_constant_state.empty())
+	{
+		specialization_constant_state.clear();
+
+		dirty = true;
+	}
+}
+
 void SpecializationConstantState::set_constant(uint32_t constant_id, const std::vector<uint8_t> &value)
 {
 	auto data = specialization_constant_state.find(constant_id);
@@ -204,6 +214,11 @@ void PipelineState::set_specialization_constant(uint32_t constant_id, const std:
 	}
 }
 
+void PipelineState::clear_specialization_constants()
+{
+	specialization_constant_state.clear_constants();
+}
+
 void PipelineState::set_vertex_input_state(const VertexInputState &new_vertex_input_sate)
 {
 	if (vertex_input_sate != new_vertex_input_sate)
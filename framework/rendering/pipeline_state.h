@@ -145,6 +145,8 @@ class SpecializationConstantState
 
 	void clear_dirty();
 
+	void clear_constants();
+
 	template <class T>
 	void set_constant(uint32_t constant_id, const T &data);
 
@@ -191,6 +193,11 @@ class PipelineState
 
 	void set_specialization_constant(uint32_t constant_id, const std::vector<uint8_t> &data);
 
+	/**
+	 * @brief Removes every specialization constant, for shaders which do not declare the ones set by previous draws
+	 */
+	void clear_specialization_constants();
+
 	void set_vertex_input_state(const VertexInputState &vertex_input_sate);
 
 	void set_input_assembly_state(const InputAssemblyState &input_assembly_state);
@@ -37,6 +37,13 @@ RenderContext::RenderContext(Device &d, VkSurfaceKHR surface, uint32_t window_wi
 	}
 }
 
+RenderContext::RenderContext(Device &d, const Queue &queue, const VkExtent2D &extent) :
+    surface_extent{extent},
+    device{d},
+    queue{queue}
+{
+}
+
 void RenderContext::prepare(size_t thread_count, RenderTarget::CreateFunc create_render_target_func)
 {
 	device.wait_idle();
@@ -73,6 +80,7 @@ void RenderContext::prepare(size_t thread_count, RenderTarget::CreateFunc create
 	}
 
 	this->prepared                  = true;
+	this->thread_count              = thread_count;
 	this->create_render_target_func = create_render_target_func;
 }
 
@@ -328,6 +336,8 @@ void RenderContext::end_frame(VkSemaphore semaphore)
 {
 	assert(frame_active && "Frame is not active, please call begin_frame");
 
+	frames.at(active_frame_index).end_buffer_ring_frame();
+
 	if (swapchain)
 	{
 		VkSwapchainKHR vk_swapchain = swapchain->get_handle();
@@ -406,4 +416,47 @@ void RenderContext::set_pre_transform(VkSurfaceTransformFlagBitsKHR pre_transfor
 {
 	this->pre_transform = pre_transform;
 }
+
+void RenderContext::set_buffer_ring_size(VkDeviceSize size)
+{
+	assert(prepared && "RenderContext not prepared for rendering, call prepare()");
+	assert(!frame_active && "Frame is still active, please call end_frame");
+
+	// Allocations of in-flight frames may still be in use
+	device.wait_idle();
+
+	for (auto &frame : frames)
+	{
+		frame.set_buffer_ring(nullptr);
+	}
+
+	buffer_ring.reset();
+
+	if (size > 0)
+	{
+		buffer_ring = std::make_unique<BufferRing>(device, size, thread_count);
+
+		for (auto &frame : frames)
+		{
+			frame.set_buffer_ring(buffer_ring.get());
+		}
+	}
+}
+
+BufferRing *RenderContext::get_buffer_ring()
+{
+	return buffer_ring.get();
+}
+
+VkDeviceSize RenderContext::get_buffer_memory_size() const
+{
+	VkDeviceSize memory_size = buffer_ring ? buffer_ring->get_size() : 0;
+
+	for (auto &frame : frames)
+	{
+		memory_size += frame.get_buffer_pool_memory_size();
+	}
+
+	return memory_size;
+}
 }        // namespace vkb
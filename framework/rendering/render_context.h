@@ -67,6 +67,15 @@ class RenderContext
 	 */
 	RenderContext(Device &device, VkSurfaceKHR surface, uint32_t window_width, uint32_t window_height);
 
+	/**
+	 * @brief Constructor for headless rendering to a given queue, so that contexts used
+	 *        by different threads can submit to different queues of the graphics family
+	 * @param device A valid device
+	 * @param queue A queue of the family returned by Device::get_queue_by_flags for graphics
+	 * @param extent The size of the render targets
+	 */
+	RenderContext(Device &device, const Queue &queue, const VkExtent2D &extent);
+
 	RenderContext(const RenderContext &) = delete;
 
 	RenderContext(RenderContext &&) = default;
@@ -187,6 +196,23 @@ class RenderContext
 
 	void set_pre_transform(VkSurfaceTransformFlagBitsKHR pre_transform);
 
+	/**
+	 * @brief Replaces the per-frame buffer pools with a single ring buffer shared by all the frames
+	 *        It should be called after prepare()
+	 * @param size Size of the ring buffer in bytes, 0 to go back to the per-frame buffer pools
+	 */
+	void set_buffer_ring_size(VkDeviceSize size);
+
+	/**
+	 * @return The ring buffer used by the frames, nullptr if they use their buffer pools
+	 */
+	BufferRing *get_buffer_ring();
+
+	/**
+	 * @return The memory used for transient buffer allocations by all the frames
+	 */
+	VkDeviceSize get_buffer_memory_size() const;
+
   protected:
 	VkExtent2D surface_extent;
 
@@ -203,12 +229,17 @@ class RenderContext
 
 	std::unique_ptr<Swapchain> swapchain;
 
+	/// Shared by all frames when enabled, it must outlive them
+	std::unique_ptr<BufferRing> buffer_ring;
+
 	std::vector<RenderFrame> frames;
 
 	VkSemaphore acquired_semaphore;
 
 	bool prepared{false};
 
+	size_t thread_count{1};
+
 	/// Current active frame index
 	uint32_t active_frame_index{0};
 
@@ -0,0 +1,180 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rendering/render_farm.h"
+
+#include <ctpl_stl.h>
+
+#include "core/device.h"
+#include "scene_graph/scene.h"
+#include "timer.h"
+
+namespace vkb
+{
+RenderFarm::RenderFarm(Device &device, const VkExtent2D &extent) :
+    device{device},
+    extent{extent}
+{
+}
+
+RenderFarm::~RenderFarm()
+{
+	// Frames of every view may still be in flight
+	device.wait_idle();
+}
+
+size_t RenderFarm::add_view(sg::Scene &scene, const CreatePipelineFunc &create_pipeline)
+{
+	auto &first_queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+
+	// Each context submits to the next queue of the family, command pools are created for the family
+	auto  queue_count = first_queue.get_properties().queueCount;
+	auto &queue       = device.get_queue(first_queue.get_family_index(), to_u32(views.size() % queue_count));
+
+	auto view = std::make_unique<View>(scene);
+
+	view->render_context = std::make_unique<RenderContext>(device, queue, extent);
+	view->render_context->prepare();
+
+	view->render_pipeline = create_pipeline(*view->render_context);
+
+	views.push_back(std::move(view));
+
+	return views.size() - 1;
+}
+
+double RenderFarm::render(size_t view_count, uint32_t frame_count)
+{
+	assert(view_count <= views.size() && "Not enough views");
+
+	// Scenes are not accessed by the threads of the views, only their snapshots are
+	for (size_t i = 0; i < view_count; ++i)
+	{
+		views[i]->snapshot.capture(views[i]->scene);
+	}
+
+	if (!thread_pool)
+	{
+		thread_pool = std::make_unique<ctpl::thread_pool>(static_cast<int>(view_count));
+	}
+	else if (thread_pool->size() < static_cast<int>(view_count))
+	{
+		thread_pool->resize(static_cast<int>(view_count));
+	}
+
+	Timer timer;
+	timer.start();
+
+	std::vector<std::future<void>> futures;
+
+	for (size_t i = 0; i < view_count; ++i)
+	{
+		auto &view = *views[i];
+
+		futures.push_back(thread_pool->push([this, &view, frame_count](size_t) { render_view(view, frame_count); }));
+	}
+
+	for (auto &future : futures)
+	{
+		future.get();
+	}
+
+	return timer.stop();
+}
+
+size_t RenderFarm::get_view_count() const
+{
+	return views.size();
+}
+
+RenderContext &RenderFarm::get_render_context(size_t view_index)
+{
+	return *views.at(view_index)->render_context;
+}
+
+RenderPipeline &RenderFarm::get_render_pipeline(size_t view_index)
+{
+	return views.at(view_index)->render_pipeline;
+}
+
+void RenderFarm::render_view(View &view, uint32_t frame_count)
+{
+	auto &render_context = *view.render_context;
+
+	for (uint32_t i = 0; i < frame_count; ++i)
+	{
+		auto &command_buffer = render_context.begin();
+
+		render_context.get_active_frame().set_scene_snapshot(&view.snapshot);
+
+		command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+		draw(command_buffer, view);
+
+		command_buffer.end();
+
+		render_context.submit(command_buffer);
+	}
+}
+
+void RenderFarm::draw(CommandBuffer &command_buffer, View &view)
+{
+	auto &render_target = view.render_context->get_active_frame().get_render_target();
+	auto &image_views   = render_target.get_views();
+
+	{
+		// The content of the previous frame is discarded
+		ImageMemoryBarrier memory_barrier{};
+		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+		memory_barrier.src_access_mask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+
+		command_buffer.image_memory_barrier(image_views.at(0), memory_barrier);
+	}
+
+	{
+		ImageMemoryBarrier memory_barrier{};
+		memory_barrier.new_layout      = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		memory_barrier.src_access_mask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		memory_barrier.dst_access_mask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+		memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+
+		command_buffer.image_memory_barrier(image_views.at(1), memory_barrier);
+	}
+
+	VkViewport viewport{};
+	viewport.width    = static_cast<float>(extent.width);
+	viewport.height   = static_cast<float>(extent.height);
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	command_buffer.set_viewport(0, {viewport});
+
+	VkRect2D scissor{};
+	scissor.extent = extent;
+	command_buffer.set_scissor(0, {scissor});
+
+	view.render_pipeline.draw(command_buffer, render_target);
+
+	command_buffer.end_render_pass();
+}
+}        // namespace vkb
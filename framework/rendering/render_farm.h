@@ -0,0 +1,137 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "rendering/render_context.h"
+#include "rendering/render_pipeline.h"
+#include "scene_graph/scene_snapshot.h"
+
+namespace ctpl
+{
+class thread_pool;
+}        // namespace ctpl
+
+namespace vkb
+{
+class Device;
+
+namespace sg
+{
+class Scene;
+}        // namespace sg
+
+/**
+ * @brief Renders many independent headless views concurrently on one Device
+ *
+ * Each view owns a headless RenderContext and a RenderPipeline, and is recorded and
+ * submitted by its own thread, so views never wait on each other's fences. The views
+ * share the ResourceCache, the pipeline cache and the scenes of the device: several
+ * views can render the same scene, and its GPU data, from their own cameras.
+ *
+ * Scenes are read-only while the farm renders. Their state is copied into a snapshot
+ * per view before the threads start, so they can be updated between calls to render().
+ * Contexts are spread across the queues of the graphics family when there are several.
+ */
+class RenderFarm
+{
+  public:
+	using CreatePipelineFunc = std::function<RenderPipeline(RenderContext &)>;
+
+	/**
+	 * @param device A valid device
+	 * @param extent The size of the render targets of the views
+	 */
+	RenderFarm(Device &device, const VkExtent2D &extent);
+
+	RenderFarm(const RenderFarm &) = delete;
+
+	RenderFarm(RenderFarm &&) = delete;
+
+	~RenderFarm();
+
+	RenderFarm &operator=(const RenderFarm &) = delete;
+
+	RenderFarm &operator=(RenderFarm &&) = delete;
+
+	/**
+	 * @brief Creates a view, it must not be called while rendering
+	 * @param scene The scene drawn by the view, its cameras must be added before
+	 * @param create_pipeline Creates the pipeline of the view with its render context
+	 * @return The index of the view
+	 */
+	size_t add_view(sg::Scene &scene, const CreatePipelineFunc &create_pipeline);
+
+	/**
+	 * @brief Renders frames with the first views concurrently, one thread per view
+	 * @param view_count The number of views to render
+	 * @param frame_count The number of frames each view renders
+	 * @return The time spent recording and submitting the frames in seconds,
+	 *         which includes waiting for the GPU to finish the previous frame of each view
+	 */
+	double render(size_t view_count, uint32_t frame_count);
+
+	size_t get_view_count() const;
+
+	RenderContext &get_render_context(size_t view_index);
+
+	RenderPipeline &get_render_pipeline(size_t view_index);
+
+  private:
+	struct View
+	{
+		View(sg::Scene &scene) :
+		    scene{scene}
+		{}
+
+		sg::Scene &scene;
+
+		std::unique_ptr<RenderContext> render_context;
+
+		RenderPipeline render_pipeline;
+
+		/// Copy of the scene state read by the thread of the view
+		sg::SceneSnapshot snapshot;
+	};
+
+	/**
+	 * @brief Records and submits frames of a view, called by the thread of the view
+	 */
+	void render_view(View &view, uint32_t frame_count);
+
+	/**
+	 * @brief Records the render pass of a view to its render target
+	 */
+	void draw(CommandBuffer &command_buffer, View &view);
+
+	Device &device;
+
+	VkExtent2D extent;
+
+	std::vector<std::unique_ptr<View>> views;
+
+	/// One thread per view rendered concurrently, created on demand
+	std::unique_ptr<ctpl::thread_pool> thread_pool;
+};
+}        // namespace vkb
@@ -32,7 +32,7 @@ RenderFrame::RenderFrame(Device &device, RenderTarget &&render_target, size_t th
     swapchain_render_target{std::move(render_target)},
     thread_count{thread_count}
 {
-	const std::vector<VkBufferUsageFlags> supported_usages = {VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_BUFFER_USAGE_INDEX_BUFFER_BIT};
+	const std::vector<VkBufferUsageFlags> supported_usages = {VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_BUFFER_USAGE_INDEX_BUFFER_BIT};
 	for (auto &usage : supported_usages)
 	{
 		std::vector<std::pair<BufferPool, BufferBlock *>> usage_buffer_pools;
@@ -89,7 +89,19 @@ void RenderFrame::reset()
 		}
 	}
 
+	if (buffer_ring)
+	{
+		// The GPU is done with the previous submission of this frame
+		buffer_ring->retire(buffer_ring_marker);
+	}
+
 	semaphore_pool.reset();
+
+	scene_snapshot = nullptr;
+
+	attachment_bandwidth = {};
+
+	read_pipeline_statistics();
 }
 
 std::vector<std::unique_ptr<CommandPool>> &RenderFrame::get_command_pools(const Queue &queue, CommandBuffer::ResetMode reset_mode)
@@ -165,9 +177,23 @@ CommandBuffer &RenderFrame::request_command_buffer(const Queue &queue, CommandBu
 
 	auto &command_pools = get_command_pools(queue, reset_mode);
 
-	auto command_pool_it = std::find_if(command_pools.begin(), command_pools.end(), [&thread_index](std::unique_ptr<CommandPool> &cmd_pool) { return cmd_pool->get_thread_index() == thread_index; });
+	// Command pools are created in thread index order
+	return command_pools[thread_index]->request_command_buffer(level);
+}
+
+uint32_t RenderFrame::get_command_buffer_allocation_count() const
+{
+	uint32_t allocation_count = 0;
+
+	for (auto &command_pools_per_queue : command_pools)
+	{
+		for (auto &command_pool : command_pools_per_queue.second)
+		{
+			allocation_count += command_pool->get_allocation_count();
+		}
+	}
 
-	return (*command_pool_it)->request_command_buffer(level);
+	return allocation_count;
 }
 
 DescriptorSet &RenderFrame::request_descriptor_set(DescriptorSetLayout &descriptor_set_layout, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos, size_t thread_index)
@@ -199,10 +225,46 @@ void RenderFrame::set_buffer_allocation_strategy(BufferAllocationStrategy new_st
 	buffer_allocation_strategy = new_strategy;
 }
 
+void RenderFrame::set_buffer_ring(BufferRing *new_buffer_ring)
+{
+	buffer_ring        = new_buffer_ring;
+	buffer_ring_marker = 0;
+}
+
+void RenderFrame::end_buffer_ring_frame()
+{
+	if (buffer_ring)
+	{
+		buffer_ring_marker = buffer_ring->end_frame();
+	}
+}
+
+void RenderFrame::set_scene_snapshot(const sg::SceneSnapshot *snapshot)
+{
+	scene_snapshot = snapshot;
+}
+
+const sg::SceneSnapshot *RenderFrame::get_scene_snapshot() const
+{
+	return scene_snapshot;
+}
+
 BufferAllocation RenderFrame::allocate_buffer(const VkBufferUsageFlags usage, const VkDeviceSize size, size_t thread_index)
 {
 	assert(thread_index < thread_count && "Thread index is out of bounds");
 
+	if (buffer_ring)
+	{
+		auto data = buffer_ring->allocate(usage, size, thread_index);
+
+		if (!data.empty())
+		{
+			return data;
+		}
+
+		// The ring is full, fall back to the buffer pools of the frame
+	}
+
 	// Find a pool for this usage
 	auto buffer_pool_it = buffer_pools.find(usage);
 	if (buffer_pool_it == buffer_pools.end())
@@ -233,4 +295,146 @@ BufferAllocation RenderFrame::allocate_buffer(const VkBufferUsageFlags usage, co
 
 	return data;
 }
+
+VkDeviceSize RenderFrame::get_buffer_pool_memory_size() const
+{
+	VkDeviceSize memory_size = 0;
+
+	for (auto &buffer_pools_per_usage : buffer_pools)
+	{
+		for (auto &buffer_pool : buffer_pools_per_usage.second)
+		{
+			memory_size += buffer_pool.first.get_memory_size();
+		}
+	}
+
+	return memory_size;
+}
+
+void RenderFrame::add_attachment_bandwidth(const AttachmentBandwidth &bandwidth)
+{
+	attachment_bandwidth.load_bytes += bandwidth.load_bytes;
+	attachment_bandwidth.store_bytes += bandwidth.store_bytes;
+}
+
+const AttachmentBandwidth &RenderFrame::get_attachment_bandwidth() const
+{
+	return attachment_bandwidth;
+}
+
+void RenderFrame::set_pipeline_statistics_enabled(bool enabled)
+{
+	if (enabled == is_pipeline_statistics_enabled())
+	{
+		return;
+	}
+
+	pending_pipeline_statistics.clear();
+	pipeline_statistics.clear();
+
+	if (!enabled)
+	{
+		pipeline_statistics_pool.reset();
+		return;
+	}
+
+	if (!device.get_features().pipelineStatisticsQuery)
+	{
+		LOGW("Pipeline statistics queries are not supported by the device");
+		return;
+	}
+
+	VkQueryPoolCreateInfo create_info{VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO};
+	create_info.queryType  = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+	create_info.queryCount = MAX_PIPELINE_STATISTICS_QUERIES;
+
+	// Results are written in the order of the bits, as read by read_pipeline_statistics()
+	create_info.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+	                                 VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+	                                 VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+	                                 VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+	pipeline_statistics_pool = std::make_unique<QueryPool>(device, create_info);
+}
+
+bool RenderFrame::is_pipeline_statistics_enabled() const
+{
+	return pipeline_statistics_pool != nullptr;
+}
+
+QueryPool *RenderFrame::reserve_pipeline_statistics(CommandBuffer &command_buffer, uint32_t subpass_count, const VkExtent2D &extent, uint32_t &first_query)
+{
+	auto render_pass_index = render_pass_count++;
+
+	if (!pipeline_statistics_pool)
+	{
+		return nullptr;
+	}
+
+	first_query = to_u32(pending_pipeline_statistics.size());
+
+	if (first_query + subpass_count > MAX_PIPELINE_STATISTICS_QUERIES)
+	{
+		LOGW_RATE_LIMITED(1000, "Too many subpasses to query their pipeline statistics, the limit is {}", MAX_PIPELINE_STATISTICS_QUERIES);
+		return nullptr;
+	}
+
+	for (uint32_t i = 0; i < subpass_count; ++i)
+	{
+		PipelineStatistics statistics;
+		statistics.render_pass_index = render_pass_index;
+		statistics.subpass_index     = i;
+		statistics.pixel_count       = static_cast<uint64_t>(extent.width) * extent.height;
+
+		pending_pipeline_statistics.push_back(statistics);
+	}
+
+	command_buffer.reset_query_pool(*pipeline_statistics_pool, first_query, subpass_count);
+
+	return pipeline_statistics_pool.get();
+}
+
+const std::vector<PipelineStatistics> &RenderFrame::get_pipeline_statistics() const
+{
+	return pipeline_statistics;
+}
+
+void RenderFrame::read_pipeline_statistics()
+{
+	render_pass_count = 0;
+
+	if (pending_pipeline_statistics.empty())
+	{
+		return;
+	}
+
+	const uint32_t query_count = to_u32(pending_pipeline_statistics.size());
+
+	std::vector<uint64_t> results(query_count * PIPELINE_STATISTICS_COUNT);
+
+	// The fence of the frame was waited on, results of a submitted frame are available
+	auto result = pipeline_statistics_pool->get_results(0, query_count,
+	                                                    results.size() * sizeof(uint64_t), results.data(),
+	                                                    PIPELINE_STATISTICS_COUNT * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+	pipeline_statistics.clear();
+
+	if (result == VK_SUCCESS)
+	{
+		for (uint32_t i = 0; i < query_count; ++i)
+		{
+			auto statistics = pending_pipeline_statistics[i];
+			auto values     = &results[i * PIPELINE_STATISTICS_COUNT];
+
+			statistics.input_assembly_primitives   = values[0];
+			statistics.vertex_shader_invocations   = values[1];
+			statistics.clipping_primitives         = values[2];
+			statistics.fragment_shader_invocations = values[3];
+
+			pipeline_statistics.push_back(statistics);
+		}
+	}
+
+	pending_pipeline_statistics.clear();
+}
 }        // namespace vkb
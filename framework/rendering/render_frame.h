@@ -21,6 +21,7 @@
 #pragma once
 
 #include "buffer_pool.h"
+#include "buffer_ring.h"
 #include "common/helpers.h"
 #include "common/resource_caching.h"
 #include "common/vk_common.h"
@@ -29,19 +30,49 @@
 #include "core/command_pool.h"
 #include "core/device.h"
 #include "core/image.h"
+#include "core/query_pool.h"
 #include "core/queue.h"
+#include "core/render_pass.h"
 #include "fence_pool.h"
 #include "rendering/render_target.h"
 #include "semaphore_pool.h"
 
 namespace vkb
 {
+namespace sg
+{
+class SceneSnapshot;
+}        // namespace sg
+
 enum BufferAllocationStrategy
 {
 	OneAllocationPerBuffer,
 	MultipleAllocationsPerBuffer
 };
 
+/**
+ * @brief Vertex, primitive and fragment counts of a subpass, read from a pipeline statistics query
+ */
+struct PipelineStatistics
+{
+	/// Index of the render pass in the frame, in recording order
+	uint32_t render_pass_index{0};
+
+	uint32_t subpass_index{0};
+
+	/// Pixels of the render area, fragment invocations per pixel approximate the overdraw
+	uint64_t pixel_count{0};
+
+	uint64_t input_assembly_primitives{0};
+
+	uint64_t vertex_shader_invocations{0};
+
+	/// Primitives that reached the rasterizer, after clipping and before face culling
+	uint64_t clipping_primitives{0};
+
+	uint64_t fragment_shader_invocations{0};
+};
+
 /**
  * @brief RenderFrame is a container for per-frame data, including BufferPool objects,
  * synchronization primitives (semaphores, fences) and the swapchain RenderTarget.
@@ -63,6 +94,11 @@ class RenderFrame
 	 */
 	static constexpr uint32_t BUFFER_POOL_BLOCK_SIZE = 256;
 
+	/**
+	 * @brief Maximum number of subpasses whose pipeline statistics are queried in a frame
+	 */
+	static constexpr uint32_t MAX_PIPELINE_STATISTICS_QUERIES = 32;
+
 	RenderFrame(Device &device, RenderTarget &&render_target, size_t thread_count = 1);
 
 	RenderFrame(const RenderFrame &) = delete;
@@ -110,6 +146,12 @@ class RenderFrame
 	                                      VkCommandBufferLevel     level        = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
 	                                      size_t                   thread_index = 0);
 
+	/**
+	 * @return The number of calls to vkAllocateCommandBuffers made by the command pools of this frame
+	 *         since it was last reset, that is while recording it
+	 */
+	uint32_t get_command_buffer_allocation_count() const;
+
 	DescriptorSet &request_descriptor_set(DescriptorSetLayout &                     descriptor_set_layout,
 	                                      const BindingMap<VkDescriptorBufferInfo> &buffer_infos,
 	                                      const BindingMap<VkDescriptorImageInfo> & image_infos,
@@ -123,6 +165,19 @@ class RenderFrame
 	 */
 	void set_buffer_allocation_strategy(BufferAllocationStrategy new_strategy);
 
+	/**
+	 * @brief Makes the frame allocate buffers from a ring shared with the other frames,
+	 *        the buffer pools of the frame are only used if the ring is full
+	 * @param buffer_ring The ring buffer, nullptr to allocate from the buffer pools only
+	 */
+	void set_buffer_ring(BufferRing *buffer_ring);
+
+	/**
+	 * @brief Marks the end of the allocations of the frame in the buffer ring,
+	 *        they will be released when the frame is reset
+	 */
+	void end_buffer_ring_frame();
+
 	/**
 	 * @param usage Usage of the buffer
 	 * @param size Amount of memory required
@@ -131,6 +186,57 @@ class RenderFrame
 	 */
 	BufferAllocation allocate_buffer(VkBufferUsageFlags usage, VkDeviceSize size, size_t thread_index = 0);
 
+	/**
+	 * @return The memory owned by the buffer pools of the frame
+	 */
+	VkDeviceSize get_buffer_pool_memory_size() const;
+
+	/**
+	 * @brief Makes the subpasses read the scene state from a snapshot while recording the frame,
+	 *        it is cleared when the frame is reset
+	 * @param snapshot The snapshot, nullptr to read the scene directly
+	 */
+	void set_scene_snapshot(const sg::SceneSnapshot *snapshot);
+
+	const sg::SceneSnapshot *get_scene_snapshot() const;
+
+	/**
+	 * @brief Adds the estimated attachment traffic of a render pass recorded for the frame,
+	 *        render passes are begun by the thread recording the primary command buffers
+	 */
+	void add_attachment_bandwidth(const AttachmentBandwidth &bandwidth);
+
+	/**
+	 * @return The estimated attachment traffic of the render passes recorded since the frame was reset
+	 */
+	const AttachmentBandwidth &get_attachment_bandwidth() const;
+
+	/**
+	 * @brief Enables pipeline statistics queries around the subpasses recorded for the frame,
+	 *        it requires the pipelineStatisticsQuery feature
+	 * @param enabled Whether to query pipeline statistics
+	 */
+	void set_pipeline_statistics_enabled(bool enabled);
+
+	bool is_pipeline_statistics_enabled() const;
+
+	/**
+	 * @brief Reserves a query for each subpass of a render pass and records their reset,
+	 *        it must be called outside of the render pass by the thread recording the primary command buffers
+	 * @param command_buffer The primary command buffer the render pass will be recorded to
+	 * @param subpass_count The number of subpasses of the render pass
+	 * @param extent The extent of the render area
+	 * @param first_query Set to the query of the first subpass
+	 * @return The query pool, nullptr if statistics are disabled or too many subpasses were queried
+	 */
+	QueryPool *reserve_pipeline_statistics(CommandBuffer &command_buffer, uint32_t subpass_count, const VkExtent2D &extent, uint32_t &first_query);
+
+	/**
+	 * @return The statistics of the subpasses recorded by the previous submission of this frame,
+	 *         results are read back when the frame is reset, after its fence was waited on
+	 */
+	const std::vector<PipelineStatistics> &get_pipeline_statistics() const;
+
   private:
 	Device &device;
 
@@ -143,6 +249,14 @@ class RenderFrame
 	 */
 	std::vector<std::unique_ptr<CommandPool>> &get_command_pools(const Queue &queue, CommandBuffer::ResetMode reset_mode);
 
+	/// Number of statistics enabled in the query pool
+	static constexpr uint32_t PIPELINE_STATISTICS_COUNT = 4;
+
+	/**
+	 * @brief Reads back the results of the queries recorded by the previous submission
+	 */
+	void read_pipeline_statistics();
+
 	/// Commands pools associated to the frame
 	std::map<uint32_t, std::vector<std::unique_ptr<CommandPool>>> command_pools;
 
@@ -163,5 +277,23 @@ class RenderFrame
 	BufferAllocationStrategy buffer_allocation_strategy{BufferAllocationStrategy::MultipleAllocationsPerBuffer};
 
 	std::map<VkBufferUsageFlags, std::vector<std::pair<BufferPool, BufferBlock *>>> buffer_pools;
+
+	BufferRing *buffer_ring{nullptr};
+
+	/// Position of the buffer ring head when the frame was last submitted
+	VkDeviceSize buffer_ring_marker{0};
+
+	const sg::SceneSnapshot *scene_snapshot{nullptr};
+
+	AttachmentBandwidth attachment_bandwidth;
+
+	std::unique_ptr<QueryPool> pipeline_statistics_pool;
+
+	/// Queries recorded since the frame was reset, their counts are not available yet
+	std::vector<PipelineStatistics> pending_pipeline_statistics;
+
+	std::vector<PipelineStatistics> pipeline_statistics;
+
+	uint32_t render_pass_count{0};
 };
 }        // namespace vkb
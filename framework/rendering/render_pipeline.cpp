@@ -20,6 +20,9 @@
 
 #include "render_pipeline.h"
 
+#include "core/device.h"
+#include "rendering/render_context.h"
+
 #include "scene_graph/components/camera.h"
 #include "scene_graph/components/image.h"
 #include "scene_graph/components/material.h"
@@ -74,6 +77,17 @@ void RenderPipeline::draw(CommandBuffer &command_buffer, RenderTarget &render_ta
 {
 	assert(!subpasses.empty() && "Render pipeline should contain at least one sub-pass");
 
+	// Queries active in a primary command buffer cannot count the commands of secondary ones
+	QueryPool *query_pool  = nullptr;
+	uint32_t   first_query = 0;
+
+	if (contents == VK_SUBPASS_CONTENTS_INLINE)
+	{
+		auto &render_frame = subpasses[0]->get_render_context().get_active_frame();
+
+		query_pool = render_frame.reserve_pipeline_statistics(command_buffer, to_u32(subpasses.size()), render_target.get_extent(), first_query);
+	}
+
 	for (size_t i = 0; i < subpasses.size(); ++i)
 	{
 		active_subpass_index = i;
@@ -91,12 +105,59 @@ void RenderPipeline::draw(CommandBuffer &command_buffer, RenderTarget &render_ta
 			command_buffer.next_subpass();
 		}
 
+		if (query_pool)
+		{
+			command_buffer.begin_query(*query_pool, first_query + to_u32(i), 0);
+		}
+
 		subpass->draw(command_buffer);
+
+		if (query_pool)
+		{
+			command_buffer.end_query(*query_pool, first_query + to_u32(i));
+		}
 	}
 
 	active_subpass_index = 0;
 }
 
+PipelineState RenderPipeline::collect_pipeline_states(Device &device, const RenderTarget &render_target, std::vector<PipelineState> &pipeline_states)
+{
+	assert(!subpasses.empty() && "Render pipeline should contain at least one sub-pass");
+
+	// Request the same render pass as CommandBuffer::begin_render_pass
+	std::vector<SubpassInfo> subpass_infos(subpasses.size());
+	auto                     subpass_info_it = subpass_infos.begin();
+	for (auto &subpass : subpasses)
+	{
+		subpass_info_it->input_attachments  = subpass->get_input_attachments();
+		subpass_info_it->output_attachments = subpass->get_output_attachments();
+
+		++subpass_info_it;
+	}
+
+	auto &render_pass = device.get_resource_cache().request_render_pass(render_target.get_attachments(), load_store, subpass_infos);
+
+	// State of a command buffer at the beginning of the render pass
+	PipelineState state;
+	state.set_render_pass(render_pass);
+
+	for (size_t i = 0; i < subpasses.size(); ++i)
+	{
+		// Like CommandBuffer::next_subpass, the state left by the previous subpass is kept
+		// and only the blend attachments are resized to the outputs of this one
+		state.set_subpass_index(to_u32(i));
+
+		auto color_blend_state = state.get_color_blend_state();
+		color_blend_state.attachments.resize(render_pass.get_color_output_count(to_u32(i)));
+		state.set_color_blend_state(color_blend_state);
+
+		subpasses[i]->collect_pipeline_states(state, pipeline_states);
+	}
+
+	return state;
+}
+
 std::unique_ptr<Subpass> &RenderPipeline::get_active_subpass()
 {
 	return subpasses[active_subpass_index];
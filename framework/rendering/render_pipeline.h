@@ -85,6 +85,17 @@ class RenderPipeline
 	 */
 	void draw(CommandBuffer &command_buffer, RenderTarget &render_target, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
 
+	/**
+	 * @brief Collects the states of the graphics pipelines the subpasses will request
+	 *        when drawing to render targets with the same attachments
+	 * @param device Device used to request the render pass
+	 * @param render_target Render target the pipeline will draw to
+	 * @param pipeline_states Vector where the pipeline states are appended
+	 * @return The state of the command buffer after the last subpass, for anything
+	 *         drawn after it in the same render pass such as the GUI
+	 */
+	PipelineState collect_pipeline_states(Device &device, const RenderTarget &render_target, std::vector<PipelineState> &pipeline_states);
+
 	/**
 	 * @return Subpass currently being recorded, or the first one
 	 *         if drawing has not started
@@ -43,7 +43,7 @@ Attachment::Attachment(VkFormat format, VkSampleCountFlagBits samples, VkImageUs
 }
 const RenderTarget::CreateFunc RenderTarget::DEFAULT_CREATE_FUNC = [](core::Image &&swapchain_image) -> RenderTarget {
 	core::Image depth_image{swapchain_image.get_device(), swapchain_image.get_extent(),
-	                        VK_FORMAT_D32_SFLOAT,
+	                        get_suitable_depth_format(swapchain_image.get_device().get_physical_device()),
 	                        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
 	                        VMA_MEMORY_USAGE_GPU_ONLY};
 
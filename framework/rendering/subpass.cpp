@@ -63,6 +63,10 @@ const ShaderSource &Subpass::get_fragment_shader() const
 	return fragment_shader;
 }
 
+void Subpass::collect_pipeline_states(PipelineState & /*state*/, std::vector<PipelineState> & /*pipeline_states*/)
+{
+}
+
 DepthStencilState &Subpass::get_depth_stencil_state()
 {
 	return depth_stencil_state;
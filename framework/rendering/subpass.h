@@ -69,6 +69,15 @@ class Subpass
 	 */
 	virtual void draw(CommandBuffer &command_buffer) = 0;
 
+	/**
+	 * @brief Appends the pipeline states that draw() is expected to request, so that
+	 *        they can be created before the first frame. By default nothing is appended.
+	 * @param state State of the command buffer at the beginning of the subpass, updated
+	 *        with the state draw() leaves behind, which the next subpass starts from
+	 * @param pipeline_states Vector where the pipeline states are appended
+	 */
+	virtual void collect_pipeline_states(PipelineState &state, std::vector<PipelineState> &pipeline_states);
+
 	RenderContext &get_render_context();
 
 	const ShaderSource &get_vertex_shader() const;
@@ -22,6 +22,7 @@
 
 #include "rendering/render_context.h"
 #include "scene_graph/components/camera.h"
+#include "scene_graph/scene_snapshot.h"
 
 namespace vkb
 {
@@ -74,16 +75,24 @@ void LightingSubpass::draw(CommandBuffer &command_buffer)
 	light_uniform.inv_resolution.x = 1.0f / render_target.get_extent().width;
 	light_uniform.inv_resolution.y = 1.0f / render_target.get_extent().height;
 
+	auto &render_frame = get_render_context().get_active_frame();
+
 	// Inverse view projection
-	light_uniform.inv_view_proj = glm::inverse(vulkan_style_projection(camera.get_projection()) * camera.get_view());
+	if (auto snapshot = render_frame.get_scene_snapshot())
+	{
+		light_uniform.inv_view_proj = glm::inverse(vulkan_style_projection(snapshot->get_projection(camera)) * snapshot->get_view(camera));
+	}
+	else
+	{
+		light_uniform.inv_view_proj = glm::inverse(vulkan_style_projection(camera.get_projection()) * camera.get_view());
+	}
 
 	// Default light
 	light_uniform.light_pos   = glm::vec4(0.0f, 128.0f, -225.0f, 1.0);
 	light_uniform.light_color = glm::vec4(1.0, 1.0, 1.0, 1.0);
 
 	// Allocate a buffer using the buffer pool from the active frame to store uniform values and bind it
-	auto &render_frame = get_render_context().get_active_frame();
-	auto  allocation   = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(LightUniform));
+	auto allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(LightUniform));
 	allocation.update(light_uniform);
 	command_buffer.bind_buffer(allocation.get_buffer(), allocation.get_offset(), allocation.get_size(), 0, 3, 0);
 
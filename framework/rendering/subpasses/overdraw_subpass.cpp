@@ -0,0 +1,63 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "rendering/subpasses/overdraw_subpass.h"
+
+#include "core/command_buffer.h"
+#include "platform/filesystem.h"
+
+namespace vkb
+{
+OverdrawSubpass::OverdrawSubpass(RenderContext &render_context, sg::Scene &scene, sg::Camera &camera) :
+    SceneSubpass{render_context, ShaderSource{fs::read_shader("base.vert")}, ShaderSource{fs::read_shader("overdraw.frag")}, scene, camera}
+{
+}
+
+void OverdrawSubpass::draw(CommandBuffer &command_buffer)
+{
+	// Opaque objects are drawn with the blend state of the command buffer
+	command_buffer.set_color_blend_state(get_transparent_color_blend_state());
+
+	SceneSubpass::draw(command_buffer);
+}
+
+void OverdrawSubpass::collect_pipeline_states(PipelineState &state, std::vector<PipelineState> &pipeline_states)
+{
+	state.set_color_blend_state(get_transparent_color_blend_state());
+
+	SceneSubpass::collect_pipeline_states(state, pipeline_states);
+}
+
+ColorBlendState OverdrawSubpass::get_transparent_color_blend_state()
+{
+	ColorBlendAttachmentState color_blend_attachment{};
+	color_blend_attachment.blend_enable           = VK_TRUE;
+	color_blend_attachment.src_color_blend_factor = VK_BLEND_FACTOR_ONE;
+	color_blend_attachment.dst_color_blend_factor = VK_BLEND_FACTOR_ONE;
+	color_blend_attachment.src_alpha_blend_factor = VK_BLEND_FACTOR_ONE;
+	color_blend_attachment.dst_alpha_blend_factor = VK_BLEND_FACTOR_ONE;
+
+	ColorBlendState color_blend_state{};
+	color_blend_state.attachments.resize(get_output_attachments().size());
+	color_blend_state.attachments[0] = color_blend_attachment;
+
+	return color_blend_state;
+}
+}        // namespace vkb
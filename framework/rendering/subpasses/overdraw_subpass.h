@@ -0,0 +1,56 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "rendering/subpasses/scene_subpass.h"
+
+namespace vkb
+{
+/**
+ * @brief Draws a scene in the order of SceneSubpass, adding 1 for each fragment shaded
+ *        to a single float color attachment, which then holds the overdraw of each pixel
+ *
+ * Depth testing is kept, so fragments rejected before shading are not counted
+ * and the result reflects the front-to-back sorting of opaque objects.
+ */
+class OverdrawSubpass : public SceneSubpass
+{
+  public:
+	/**
+	 * @param render_context Render context
+	 * @param scene Scene to render on this subpass
+	 * @param camera Camera used to look at the scene
+	 */
+	OverdrawSubpass(RenderContext &render_context, sg::Scene &scene, sg::Camera &camera);
+
+	virtual ~OverdrawSubpass() = default;
+
+	virtual void draw(CommandBuffer &command_buffer) override;
+
+	virtual void collect_pipeline_states(PipelineState &state, std::vector<PipelineState> &pipeline_states) override;
+
+  protected:
+	/**
+	 * @return Additive blending, used for opaque objects too
+	 */
+	virtual ColorBlendState get_transparent_color_blend_state() override;
+};
+}        // namespace vkb
@@ -19,6 +19,10 @@
  */
 
 #include "rendering/subpasses/scene_subpass.h"
+
+#include <map>
+#include <set>
+
 #include "common/utils.h"
 #include "common/vk_common.h"
 #include "rendering/render_context.h"
@@ -27,43 +31,336 @@
 #include "scene_graph/components/material.h"
 #include "scene_graph/components/mesh.h"
 #include "scene_graph/components/pbr_material.h"
+#include "scene_graph/components/skin.h"
 #include "scene_graph/components/texture.h"
 #include "scene_graph/node.h"
 #include "scene_graph/scene.h"
+#include "scene_graph/scene_snapshot.h"
+#include "timer.h"
 
 namespace vkb
 {
+namespace
+{
+// Material textures enabled by specialization constants, the index is the constant_id used in the shaders.
+// base.frag and deferred/geometry.frag only sample the base color texture
+const std::array<const char *, 1> TEXTURE_CONSTANTS = {"base_color_texture"};
+
+std::vector<uint8_t> to_constant_data(bool value)
+{
+	VkBool32 data = value ? VK_TRUE : VK_FALSE;
+
+	return {reinterpret_cast<const uint8_t *>(&data), reinterpret_cast<const uint8_t *>(&data) + sizeof(VkBool32)};
+}
+
+std::string to_define(const std::string &texture_name)
+{
+	std::string define = texture_name;
+	std::transform(define.begin(), define.end(), define.begin(), ::toupper);
+
+	return "HAS_" + define;
+}
+
+bool has_define(const ShaderVariant &variant, const std::string &define)
+{
+	const auto &processes = variant.get_processes();
+
+	return std::find(processes.begin(), processes.end(), "D" + define) != processes.end();
+}
+}        // namespace
+
 SceneSubpass::SceneSubpass(RenderContext &render_context, ShaderSource &&vertex_source, ShaderSource &&fragment_source, sg::Scene &scene, sg::Camera &camera) :
     Subpass{render_context, std::move(vertex_source), std::move(fragment_source)},
     meshes{scene.get_components<sg::Mesh>()},
     camera{camera}
 {
+	prepare_shader_modules();
+}
+
+void SceneSubpass::set_specialization_constants_enabled(bool enable)
+{
+	if (enable == specialization_constants_enabled)
+	{
+		return;
+	}
+
+	if (enable && !fallback_image)
+	{
+		prepare_fallback_image();
+	}
+
+	specialization_constants_enabled = enable;
+
+	specialization_variants.clear();
+
+	prepare_shader_modules();
+}
+
+bool SceneSubpass::is_specialization_constants_enabled() const
+{
+	return specialization_constants_enabled;
+}
+
+void SceneSubpass::prepare_fallback_image()
+{
+	auto &device = render_context.get_device();
+
+	// Never sampled, so its content is left undefined
+	fallback_image            = std::make_unique<core::Image>(device, VkExtent3D{1, 1, 1}, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_SAMPLED_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+	fallback_image_view       = std::make_unique<core::ImageView>(*fallback_image, VK_IMAGE_VIEW_TYPE_2D);
+	fallback_array_image_view = std::make_unique<core::ImageView>(*fallback_image, VK_IMAGE_VIEW_TYPE_2D_ARRAY);
+
+	VkSamplerCreateInfo sampler_info{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
+	sampler_info.magFilter    = VK_FILTER_NEAREST;
+	sampler_info.minFilter    = VK_FILTER_NEAREST;
+	sampler_info.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	sampler_info.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	sampler_info.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+	sampler_info.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+
+	fallback_sampler = std::make_unique<core::Sampler>(device, sampler_info);
+
+	auto &command_buffer = device.request_command_buffer();
+
+	command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, 0);
+
+	ImageMemoryBarrier memory_barrier{};
+	memory_barrier.old_layout      = VK_IMAGE_LAYOUT_UNDEFINED;
+	memory_barrier.new_layout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	memory_barrier.src_access_mask = 0;
+	memory_barrier.dst_access_mask = VK_ACCESS_SHADER_READ_BIT;
+	memory_barrier.src_stage_mask  = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	memory_barrier.dst_stage_mask  = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
+	command_buffer.image_memory_barrier(*fallback_image_view, memory_barrier);
+
+	command_buffer.end();
+
+	auto &queue = device.get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
+
+	queue.submit(command_buffer, device.request_fence());
+
+	device.get_fence_pool().wait();
+	device.get_fence_pool().reset();
+	device.get_command_pool().reset_pool();
+}
+
+void SceneSubpass::set_bindless_textures_enabled(bool enable)
+{
+	if (enable == bindless_textures_enabled)
+	{
+		return;
+	}
+
+	auto &device = render_context.get_device();
+
+	if (enable)
+	{
+		if (!device.is_descriptor_indexing_enabled())
+		{
+			LOGW("Bindless textures require descriptor indexing, which is not supported by the device");
+			return;
+		}
+
+		bindless_indices.clear();
+
+		// Textures sampling layers of the same array with the same sampler share a descriptor
+		std::map<std::pair<const sg::Image *, const sg::Sampler *>, uint32_t> descriptor_indices;
+
+		for (auto &mesh : meshes)
+		{
+			for (auto &sub_mesh : mesh->get_submeshes())
+			{
+				for (auto &texture : sub_mesh->get_material()->textures)
+				{
+					std::pair<const sg::Image *, const sg::Sampler *> key{texture.second->get_image(), texture.second->get_sampler()};
+
+					bindless_indices.emplace(texture.second, descriptor_indices.emplace(key, to_u32(descriptor_indices.size())).first->second);
+				}
+			}
+		}
+
+		bindless_texture_count = to_u32(descriptor_indices.size());
+
+		const auto &properties   = device.get_descriptor_indexing_properties();
+		uint32_t    max_textures = std::min(properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+		                                    properties.maxPerStageDescriptorUpdateAfterBindSamplers);
+
+		if (bindless_texture_count == 0 || bindless_texture_count > max_textures)
+		{
+			LOGW("Bindless textures require between 1 and {} textures in the scene, found {}", max_textures, bindless_texture_count);
+			return;
+		}
+	}
+
+	bindless_textures_enabled = enable;
+
+	specialization_variants.clear();
+
+	prepare_shader_modules();
+
+	bindless_set.reset();
+	bindless_pool.reset();
+
+	if (!bindless_textures_enabled)
+	{
+		return;
+	}
+
+	// Every variant declares the same array, so any pipeline layout provides the set layout
+	auto &sub_mesh              = *meshes.front()->get_submeshes().front();
+	auto &descriptor_set_layout = request_pipeline_layout(sub_mesh).get_set_layout(1);
+
+	BindingMap<VkDescriptorImageInfo> image_infos;
+
+	for (auto &texture_it : bindless_indices)
+	{
+		auto &texture = *texture_it.first;
+
+		VkDescriptorImageInfo image_info{};
+		image_info.sampler     = texture.get_sampler()->vk_sampler.get_handle();
+		image_info.imageView   = texture.get_image()->get_vk_image_view().get_handle();
+		image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		image_infos[0][texture_it.second] = image_info;
+	}
+
+	bindless_pool = std::make_unique<DescriptorPool>(device, descriptor_set_layout, 1);
+	bindless_set  = std::make_unique<DescriptorSet>(device, descriptor_set_layout, *bindless_pool, BindingMap<VkDescriptorBufferInfo>{}, image_infos);
+}
+
+bool SceneSubpass::is_bindless_textures_enabled() const
+{
+	return bindless_textures_enabled;
+}
+
+void SceneSubpass::set_compute_skinning(ComputeSkinning *new_compute_skinning)
+{
+	if (new_compute_skinning == compute_skinning)
+	{
+		return;
+	}
+
+	compute_skinning = new_compute_skinning;
+
+	joint_palettes.clear();
+
+	specialization_variants.clear();
+
+	prepare_shader_modules();
+}
+
+double SceneSubpass::get_skinning_time() const
+{
+	return compute_skinning ? compute_skinning->get_skinning_time() : skinning_time;
+}
+
+double SceneSubpass::get_shader_compile_time() const
+{
+	return shader_compile_time;
+}
+
+uint32_t SceneSubpass::get_texture_binding_changes() const
+{
+	return texture_binding_changes;
+}
+
+sg::Camera &SceneSubpass::get_camera()
+{
+	return camera;
+}
+
+void SceneSubpass::prepare_shader_modules()
+{
+	Timer timer;
+	timer.start();
+
 	// Build all shader variance upfront
 	auto &device = render_context.get_device();
 	for (auto &mesh : meshes)
 	{
 		for (auto &sub_mesh : mesh->get_submeshes())
 		{
-			auto &variant     = sub_mesh->get_shader_variant();
+			if ((specialization_constants_enabled || bindless_textures_enabled || compute_skinning) && specialization_variants.find(sub_mesh) == specialization_variants.end())
+			{
+				// Keep the vertex attribute defines, textures may be enabled by specialization constants or push constants
+				const auto &textures = sub_mesh->get_material()->textures;
+
+				bool strip_textures = specialization_constants_enabled || bindless_textures_enabled;
+
+				ShaderVariant variant;
+
+				if (compute_skinning)
+				{
+					variant.add_define("COMPUTE_SKINNING");
+				}
+
+				if (bindless_textures_enabled)
+				{
+					variant.add_define("BINDLESS_TEXTURES");
+					variant.add_define("BINDLESS_TEXTURE_COUNT=" + std::to_string(bindless_texture_count));
+				}
+				else if (specialization_constants_enabled)
+				{
+					variant.add_define("SPECIALIZATION_CONSTANTS");
+				}
+
+				for (auto &process : sub_mesh->get_shader_variant().get_processes())
+				{
+					auto define = process.substr(1);
+
+					bool is_texture = std::any_of(textures.begin(), textures.end(), [&define](const auto &texture) {
+						return to_define(texture.first) == define;
+					});
+
+					if (process[0] == 'D' && !(strip_textures && is_texture))
+					{
+						variant.add_define(define);
+					}
+				}
+
+				specialization_variants.emplace(sub_mesh, std::move(variant));
+			}
+
+			auto &variant     = get_shader_variant(*sub_mesh);
 			auto &vert_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
 			auto &frag_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
 
 			vert_module.set_resource_dynamic("GlobalUniform");
 			frag_module.set_resource_dynamic("GlobalUniform");
+
+			if (bindless_textures_enabled)
+			{
+				frag_module.set_resource_update_after_bind("bindless_textures");
+			}
 		}
 	}
+
+	shader_compile_time = timer.stop<Timer::Milliseconds>();
+}
+
+const ShaderVariant &SceneSubpass::get_shader_variant(sg::SubMesh &sub_mesh)
+{
+	if (specialization_constants_enabled || bindless_textures_enabled || compute_skinning)
+	{
+		return specialization_variants.at(&sub_mesh);
+	}
+
+	return sub_mesh.get_shader_variant();
 }
 
 void SceneSubpass::get_sorted_nodes(std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &opaque_nodes,
                                     std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &transparent_nodes)
 {
-	auto camera_transform = camera.get_node()->get_transform().get_world_matrix();
+	auto snapshot = get_render_context().get_active_frame().get_scene_snapshot();
+
+	auto camera_transform = snapshot ? snapshot->get_world_matrix(*camera.get_node()) : camera.get_node()->get_transform().get_world_matrix();
 
 	for (auto &mesh : meshes)
 	{
 		for (auto &node : mesh->get_nodes())
 		{
-			auto node_transform = node->get_transform().get_world_matrix();
+			auto node_transform = snapshot ? snapshot->get_world_matrix(*node) : node->get_transform().get_world_matrix();
 
 			const sg::AABB &mesh_bounds = mesh->get_bounds();
 
@@ -94,20 +391,120 @@ void SceneSubpass::draw(CommandBuffer &command_buffer)
 
 	get_sorted_nodes(opaque_nodes, transparent_nodes);
 
+	if (!compute_skinning)
+	{
+		prepare_joint_palettes();
+	}
+
+	auto snapshot = get_render_context().get_active_frame().get_scene_snapshot();
+
+	texture_binding_changes = 0;
+
+	const sg::SubMesh *previous_sub_mesh = nullptr;
+
 	// Draw opaque objects in front-to-back order
 	for (auto node_it = opaque_nodes.begin(); node_it != opaque_nodes.end(); node_it++)
 	{
+		texture_binding_changes += count_texture_binding_changes(previous_sub_mesh, *node_it->second.second);
+		previous_sub_mesh = node_it->second.second;
+
 		update_uniform(command_buffer, *node_it->second.first);
 
 		// Invert the front face if the mesh was flipped
-		const auto &scale      = node_it->second.first->get_transform().get_scale();
-		bool        flipped    = scale.x * scale.y * scale.z < 0;
+		bool flipped = false;
+		if (snapshot)
+		{
+			flipped = snapshot->is_flipped(*node_it->second.first);
+		}
+		else
+		{
+			const auto &scale = node_it->second.first->get_transform().get_scale();
+			flipped           = scale.x * scale.y * scale.z < 0;
+		}
 		VkFrontFace front_face = flipped ? VK_FRONT_FACE_CLOCKWISE : VK_FRONT_FACE_COUNTER_CLOCKWISE;
 
-		draw_submesh(command_buffer, *node_it->second.second, front_face);
+		draw_submesh(command_buffer, *node_it->second.first, *node_it->second.second, front_face);
 	}
 
 	// Enable alpha blending
+	command_buffer.set_color_blend_state(get_transparent_color_blend_state());
+
+	command_buffer.set_depth_stencil_state(get_depth_stencil_state());
+
+	// Draw transparent objects in back-to-front order
+	for (auto node_it = transparent_nodes.rbegin(); node_it != transparent_nodes.rend(); node_it++)
+	{
+		texture_binding_changes += count_texture_binding_changes(previous_sub_mesh, *node_it->second.second);
+		previous_sub_mesh = node_it->second.second;
+
+		update_uniform(command_buffer, *node_it->second.first);
+
+		draw_submesh(command_buffer, *node_it->second.first, *node_it->second.second);
+	}
+}
+
+void SceneSubpass::collect_pipeline_states(PipelineState &state, std::vector<PipelineState> &pipeline_states)
+{
+	auto transparent_color_blend_state = get_transparent_color_blend_state();
+
+	const PipelineState base_state = state;
+
+	for (auto &mesh : meshes)
+	{
+		// Opaque objects invert the front face of flipped nodes
+		std::set<VkFrontFace> front_faces;
+
+		for (auto &node : mesh->get_nodes())
+		{
+			const auto &scale = node->get_transform().get_scale();
+			front_faces.insert(scale.x * scale.y * scale.z < 0 ? VK_FRONT_FACE_CLOCKWISE : VK_FRONT_FACE_COUNTER_CLOCKWISE);
+		}
+
+		for (auto &sub_mesh : mesh->get_submeshes())
+		{
+			auto &pipeline_layout = request_pipeline_layout(*sub_mesh);
+
+			PipelineState pipeline_state = base_state;
+			pipeline_state.set_pipeline_layout(pipeline_layout);
+			pipeline_state.set_vertex_input_state(get_vertex_input_state(pipeline_layout, *sub_mesh));
+
+			if (specialization_constants_enabled && !bindless_textures_enabled)
+			{
+				const auto &textures = sub_mesh->get_material()->textures;
+
+				for (uint32_t constant_id = 0; constant_id < to_u32(TEXTURE_CONSTANTS.size()); ++constant_id)
+				{
+					pipeline_state.set_specialization_constant(constant_id, to_constant_data(textures.count(TEXTURE_CONSTANTS[constant_id]) > 0));
+				}
+			}
+
+			if (sub_mesh->get_material()->alpha_mode == sg::AlphaMode::Blend)
+			{
+				pipeline_state.set_rasterization_state(get_rasterization_state(*sub_mesh, VK_FRONT_FACE_COUNTER_CLOCKWISE));
+				pipeline_state.set_color_blend_state(transparent_color_blend_state);
+				pipeline_state.set_depth_stencil_state(get_depth_stencil_state());
+
+				pipeline_states.push_back(pipeline_state);
+			}
+			else
+			{
+				for (auto front_face : front_faces)
+				{
+					pipeline_state.set_rasterization_state(get_rasterization_state(*sub_mesh, front_face));
+
+					pipeline_states.push_back(pipeline_state);
+				}
+			}
+		}
+	}
+
+	// draw() enables blending for transparent objects whether there are any or not
+	state.set_color_blend_state(transparent_color_blend_state);
+	state.set_depth_stencil_state(get_depth_stencil_state());
+}
+
+ColorBlendState SceneSubpass::get_transparent_color_blend_state()
+{
 	ColorBlendAttachmentState color_blend_attachment{};
 	color_blend_attachment.blend_enable           = VK_TRUE;
 	color_blend_attachment.src_color_blend_factor = VK_BLEND_FACTOR_SRC_ALPHA;
@@ -117,17 +514,8 @@ void SceneSubpass::draw(CommandBuffer &command_buffer)
 	ColorBlendState color_blend_state{};
 	color_blend_state.attachments.resize(get_output_attachments().size());
 	color_blend_state.attachments[0] = color_blend_attachment;
-	command_buffer.set_color_blend_state(color_blend_state);
 
-	command_buffer.set_depth_stencil_state(get_depth_stencil_state());
-
-	// Draw transparent objects in back-to-front order
-	for (auto node_it = transparent_nodes.rbegin(); node_it != transparent_nodes.rend(); node_it++)
-	{
-		update_uniform(command_buffer, *node_it->second.first);
-
-		draw_submesh(command_buffer, *node_it->second.second);
-	}
+	return color_blend_state;
 }
 
 void SceneSubpass::update_uniform(CommandBuffer &command_buffer, sg::Node &node, size_t thread_index)
@@ -138,50 +526,142 @@ void SceneSubpass::update_uniform(CommandBuffer &command_buffer, sg::Node &node,
 	global_uniform.light_pos   = glm::vec4(500.0f, 1550.0f, 0.0f, 1.0);
 	global_uniform.light_color = glm::vec4(1.0, 1.0, 1.0, 1.0);
 
-	global_uniform.camera_view_proj = vkb::vulkan_style_projection(camera.get_projection()) * camera.get_view();
-
 	auto &render_frame = get_render_context().get_active_frame();
 
+	auto snapshot = render_frame.get_scene_snapshot();
+
+	if (snapshot)
+	{
+		global_uniform.camera_view_proj = vkb::vulkan_style_projection(snapshot->get_projection(camera)) * snapshot->get_view(camera);
+	}
+	else
+	{
+		global_uniform.camera_view_proj = vkb::vulkan_style_projection(camera.get_projection()) * camera.get_view();
+	}
+
 	auto &transform = node.get_transform();
 
 	auto allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(GlobalUniform), thread_index);
 
-	global_uniform.model = transform.get_world_matrix();
+	// Skinned vertices are transformed by the joint matrices only
+	if (node.has_component<sg::Skin>())
+	{
+		global_uniform.model = glm::mat4(1.0f);
+	}
+	else
+	{
+		global_uniform.model = snapshot ? snapshot->get_world_matrix(node) : transform.get_world_matrix();
+	}
 
 	allocation.update(global_uniform);
 
 	command_buffer.bind_buffer(allocation.get_buffer(), allocation.get_offset(), allocation.get_size(), 0, 1, 0);
 }
 
-void SceneSubpass::draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &sub_mesh, VkFrontFace front_face)
+void SceneSubpass::prepare_joint_palettes()
 {
-	auto &device = command_buffer.get_device();
+	Timer timer;
+	timer.start();
 
-	RasterizationState rasterization_state{};
-	rasterization_state.front_face = front_face;
+	joint_palettes.clear();
 
-	if (sub_mesh.get_material()->double_sided)
+	auto &render_frame = render_context.get_active_frame();
+
+	std::vector<glm::mat4> joint_matrices;
+
+	for (auto &mesh : meshes)
 	{
-		rasterization_state.cull_mode = VK_CULL_MODE_NONE;
+		for (auto &node : mesh->get_nodes())
+		{
+			if (!node->has_component<sg::Skin>())
+			{
+				continue;
+			}
+
+			auto &skin = node->get_component<sg::Skin>();
+
+			if (joint_palettes.find(&skin) != joint_palettes.end())
+			{
+				continue;
+			}
+
+			skin.compute_joint_matrices(joint_matrices, render_frame.get_scene_snapshot());
+
+			auto data = reinterpret_cast<const uint8_t *>(joint_matrices.data());
+
+			auto allocation = render_frame.allocate_buffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, joint_matrices.size() * sizeof(glm::mat4));
+			allocation.update(std::vector<uint8_t>{data, data + joint_matrices.size() * sizeof(glm::mat4)});
+
+			joint_palettes.emplace(&skin, std::move(allocation));
+		}
 	}
 
-	command_buffer.set_rasterization_state(rasterization_state);
+	skinning_time = timer.stop<Timer::Milliseconds>();
+}
 
-	auto &vert_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), sub_mesh.get_shader_variant());
-	auto &frag_shader_module = device.get_resource_cache().request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), sub_mesh.get_shader_variant());
+void SceneSubpass::draw_submesh(CommandBuffer &command_buffer, sg::Node &node, sg::SubMesh &sub_mesh, VkFrontFace front_face)
+{
+	const ComputeSkinning::Output *skinned_output = nullptr;
 
-	std::vector<ShaderModule *> shader_modules{&vert_shader_module, &frag_shader_module};
+	if (node.has_component<sg::Skin>())
+	{
+		if (compute_skinning)
+		{
+			skinned_output = compute_skinning->get_output(node, sub_mesh);
+		}
+		else
+		{
+			auto palette_it = joint_palettes.find(&node.get_component<sg::Skin>());
+
+			if (palette_it != joint_palettes.end())
+			{
+				auto &palette = palette_it->second;
+
+				command_buffer.bind_buffer(palette.get_buffer(), palette.get_offset(), palette.get_size(), 0, 2, 0);
+			}
+		}
+	}
+
+	draw_submesh(command_buffer, sub_mesh, front_face, skinned_output);
+}
 
-	PipelineLayout &pipeline_layout = device.get_resource_cache().request_pipeline_layout(shader_modules);
+void SceneSubpass::draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &sub_mesh, VkFrontFace front_face)
+{
+	draw_submesh(command_buffer, sub_mesh, front_face, nullptr);
+}
+
+void SceneSubpass::draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &sub_mesh, VkFrontFace front_face, const ComputeSkinning::Output *skinned_output)
+{
+	command_buffer.set_rasterization_state(get_rasterization_state(sub_mesh, front_face));
+
+	PipelineLayout &pipeline_layout = request_pipeline_layout(sub_mesh);
 
 	command_buffer.bind_pipeline_layout(pipeline_layout);
 
+	if (bindless_textures_enabled)
+	{
+		command_buffer.bind_descriptor_set(*bindless_set, 1);
+	}
+
 	auto pbr_material = dynamic_cast<const sg::PBRMaterial *>(sub_mesh.get_material());
 
 	PBRMaterialUniform pbr_material_uniform{};
-	pbr_material_uniform.base_color_factor = pbr_material->base_color_factor;
-	pbr_material_uniform.metallic_factor   = pbr_material->metallic_factor;
-	pbr_material_uniform.roughness_factor  = pbr_material->roughness_factor;
+	pbr_material_uniform.base_color_factor        = pbr_material->base_color_factor;
+	pbr_material_uniform.metallic_factor          = pbr_material->metallic_factor;
+	pbr_material_uniform.roughness_factor         = pbr_material->roughness_factor;
+	pbr_material_uniform.base_color_texture_index = -1;
+	pbr_material_uniform.base_color_texture_layer = 0;
+
+	auto texture_it = pbr_material->textures.find("base_color_texture");
+	if (texture_it != pbr_material->textures.end())
+	{
+		if (bindless_textures_enabled)
+		{
+			pbr_material_uniform.base_color_texture_index = static_cast<int32_t>(bindless_indices.at(texture_it->second));
+		}
+
+		pbr_material_uniform.base_color_texture_layer = static_cast<int32_t>(texture_it->second->get_layer());
+	}
 
 	command_buffer.push_constants(0, pbr_material_uniform);
 
@@ -199,11 +679,123 @@ void SceneSubpass::draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &sub_
 		}
 	}
 
+	if (specialization_constants_enabled && !bindless_textures_enabled)
+	{
+		const auto &textures = sub_mesh.get_material()->textures;
+
+		for (uint32_t constant_id = 0; constant_id < to_u32(TEXTURE_CONSTANTS.size()); ++constant_id)
+		{
+			bool has_texture = textures.count(TEXTURE_CONSTANTS[constant_id]) > 0;
+
+			command_buffer.set_specialization_constant(constant_id, to_constant_data(has_texture));
+
+			VkDescriptorSetLayoutBinding layout_binding;
+
+			// Textures the material lacks are still declared by the shaders, but never sampled
+			if (!has_texture && descriptor_set_layout.has_layout_binding(TEXTURE_CONSTANTS[constant_id], layout_binding))
+			{
+				// The view type has to match the sampler declared by the shader variant
+				const auto &fallback_view = has_define(get_shader_variant(sub_mesh), "TEXTURE_ARRAYS") ? *fallback_array_image_view : *fallback_image_view;
+
+				command_buffer.bind_image(fallback_view, *fallback_sampler, 0, layout_binding.binding, 0);
+			}
+		}
+	}
+
+	command_buffer.set_vertex_input_state(get_vertex_input_state(pipeline_layout, sub_mesh));
+
 	auto vertex_input_resources = pipeline_layout.get_vertex_input_attributes();
 
+	// Find submesh vertex buffers matching the shader input attribute names
+	for (auto &input_resource : vertex_input_resources)
+	{
+		const auto &buffer_iter = sub_mesh.vertex_buffers.find(input_resource.name);
+
+		if (buffer_iter != sub_mesh.vertex_buffers.end())
+		{
+			const core::Buffer *buffer = &buffer_iter->second;
+
+			// Deformed vertices replace the ones of the submesh, with the same layout
+			if (skinned_output && input_resource.name == "position")
+			{
+				buffer = skinned_output->position.get();
+			}
+			else if (skinned_output && skinned_output->normal && input_resource.name == "normal")
+			{
+				buffer = skinned_output->normal.get();
+			}
+
+			std::vector<std::reference_wrapper<const core::Buffer>> buffers;
+			buffers.emplace_back(std::ref(*buffer));
+
+			// Bind vertex buffers only for the attribute locations defined
+			command_buffer.bind_vertex_buffers(input_resource.location, std::move(buffers), {0});
+		}
+	}
+
+	draw_submesh_command(command_buffer, sub_mesh);
+}
+
+uint32_t SceneSubpass::count_texture_binding_changes(const sg::SubMesh *previous_sub_mesh, const sg::SubMesh &sub_mesh)
+{
+	auto &textures = sub_mesh.get_material()->textures;
+
+	if (!previous_sub_mesh)
+	{
+		return to_u32(textures.size());
+	}
+
+	auto &previous_textures = previous_sub_mesh->get_material()->textures;
+
+	uint32_t changes = 0;
+
+	for (auto &texture : textures)
+	{
+		auto previous_it = previous_textures.find(texture.first);
+
+		// Layers of the same array are bound with the same image view
+		if (previous_it == previous_textures.end() ||
+		    previous_it->second->get_image() != texture.second->get_image() ||
+		    previous_it->second->get_sampler() != texture.second->get_sampler())
+		{
+			changes++;
+		}
+	}
+
+	return changes;
+}
+
+PipelineLayout &SceneSubpass::request_pipeline_layout(sg::SubMesh &sub_mesh)
+{
+	auto &resource_cache = render_context.get_device().get_resource_cache();
+
+	auto &variant            = get_shader_variant(sub_mesh);
+	auto &vert_shader_module = resource_cache.request_shader_module(VK_SHADER_STAGE_VERTEX_BIT, get_vertex_shader(), variant);
+	auto &frag_shader_module = resource_cache.request_shader_module(VK_SHADER_STAGE_FRAGMENT_BIT, get_fragment_shader(), variant);
+
+	std::vector<ShaderModule *> shader_modules{&vert_shader_module, &frag_shader_module};
+
+	return resource_cache.request_pipeline_layout(shader_modules);
+}
+
+RasterizationState SceneSubpass::get_rasterization_state(sg::SubMesh &sub_mesh, VkFrontFace front_face)
+{
+	RasterizationState rasterization_state{};
+	rasterization_state.front_face = front_face;
+
+	if (sub_mesh.get_material()->double_sided)
+	{
+		rasterization_state.cull_mode = VK_CULL_MODE_NONE;
+	}
+
+	return rasterization_state;
+}
+
+VertexInputState SceneSubpass::get_vertex_input_state(PipelineLayout &pipeline_layout, sg::SubMesh &sub_mesh)
+{
 	VertexInputState vertex_input_state;
 
-	for (auto &input_resource : vertex_input_resources)
+	for (auto &input_resource : pipeline_layout.get_vertex_input_attributes())
 	{
 		sg::VertexAttribute attribute;
 
@@ -227,24 +819,7 @@ void SceneSubpass::draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &sub_
 		vertex_input_state.bindings.push_back(vertex_binding);
 	}
 
-	command_buffer.set_vertex_input_state(vertex_input_state);
-
-	// Find submesh vertex buffers matching the shader input attribute names
-	for (auto &input_resource : vertex_input_resources)
-	{
-		const auto &buffer_iter = sub_mesh.vertex_buffers.find(input_resource.name);
-
-		if (buffer_iter != sub_mesh.vertex_buffers.end())
-		{
-			std::vector<std::reference_wrapper<const core::Buffer>> buffers;
-			buffers.emplace_back(std::ref(buffer_iter->second));
-
-			// Bind vertex buffers only for the attribute locations defined
-			command_buffer.bind_vertex_buffers(input_resource.location, std::move(buffers), {0});
-		}
-	}
-
-	draw_submesh_command(command_buffer, sub_mesh);
+	return vertex_input_state;
 }
 
 void SceneSubpass::draw_submesh_command(CommandBuffer &command_buffer, sg::SubMesh &sub_mesh)
@@ -26,6 +26,12 @@ VKBP_DISABLE_WARNINGS()
 #include <glm/glm.hpp>
 VKBP_ENABLE_WARNINGS()
 
+#include "core/descriptor_pool.h"
+#include "core/descriptor_set.h"
+#include "core/image.h"
+#include "core/image_view.h"
+#include "core/sampler.h"
+#include "rendering/compute_skinning.h"
 #include "rendering/subpass.h"
 
 namespace vkb
@@ -37,6 +43,8 @@ class Node;
 class Mesh;
 class SubMesh;
 class Camera;
+class Skin;
+class Texture;
 }        // namespace sg
 
 /**
@@ -63,6 +71,12 @@ struct PBRMaterialUniform
 	float metallic_factor;
 
 	float roughness_factor;
+
+	/// Index of the base color texture in the bindless textures, -1 if the material has none
+	int32_t base_color_texture_index;
+
+	/// Layer of the base color texture, if its image is an array
+	int32_t base_color_texture_layer;
 };
 
 /**
@@ -88,10 +102,77 @@ class SceneSubpass : public Subpass
 	 */
 	virtual void draw(CommandBuffer &command_buffer) override;
 
+	/**
+	 * @brief Appends a pipeline state for every submesh, front face and blending
+	 *        combination used by draw(), which leaves the blending and depth state
+	 *        of transparent objects behind
+	 */
+	virtual void collect_pipeline_states(PipelineState &state, std::vector<PipelineState> &pipeline_states) override;
+
 	void update_uniform(CommandBuffer &command_buffer, sg::Node &node, size_t thread_index = 0);
 
 	void draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &sub_mesh, VkFrontFace front_face = VK_FRONT_FACE_COUNTER_CLOCKWISE);
 
+	/**
+	 * @brief Draws a submesh deformed by the skin of the node, if it has one
+	 */
+	void draw_submesh(CommandBuffer &command_buffer, sg::Node &node, sg::SubMesh &sub_mesh, VkFrontFace front_face = VK_FRONT_FACE_COUNTER_CLOCKWISE);
+
+	/**
+	 * @brief Selects how the textures of a material are enabled in the shaders
+	 *
+	 * By default every combination of textures is a shader variant compiled separately.
+	 * With specialization constants, the shaders are compiled once with SPECIALIZATION_CONSTANTS
+	 * defined and each material sets its textures as constants when the pipeline is created.
+	 * Pipelines built in the other mode are not reused, clear them after switching.
+	 * @param enable Whether to use specialization constants
+	 */
+	void set_specialization_constants_enabled(bool enable);
+
+	bool is_specialization_constants_enabled() const;
+
+	/**
+	 * @brief Selects whether the base color textures are read from a single array of all the
+	 *        textures in the scene, indexed by a push constant, instead of a descriptor per material
+	 *
+	 * The array is bound once as set 1, so draws only update the descriptor set of the uniforms.
+	 * It requires descriptor indexing, see Device::is_descriptor_indexing_enabled().
+	 * The textures are written to the set immediately, the device must be idle when it is enabled.
+	 * Pipelines built in the other mode are not reused, clear them after switching.
+	 * @param enable Whether to use bindless textures
+	 */
+	void set_bindless_textures_enabled(bool enable);
+
+	bool is_bindless_textures_enabled() const;
+
+	/**
+	 * @brief Selects how skinned meshes are deformed
+	 *
+	 * By default the vertex shaders deform them with the joint matrices of the frame.
+	 * With compute skinning, they draw the vertices deformed by ComputeSkinning::dispatch(),
+	 * which must be recorded before the render pass.
+	 * Pipelines built in the other mode are not reused, clear them after switching.
+	 * @param compute_skinning The compute skinning of the scene, or nullptr for vertex skinning
+	 */
+	void set_compute_skinning(ComputeSkinning *compute_skinning);
+
+	/**
+	 * @return The CPU time spent on skinning by the last frame in milliseconds
+	 */
+	double get_skinning_time() const;
+
+	/**
+	 * @return The time spent compiling the shader modules of the scene in milliseconds
+	 */
+	double get_shader_compile_time() const;
+
+	/**
+	 * @return The number of material textures the last frame drawn by draw() bound to a different image than the previous draw call
+	 */
+	uint32_t get_texture_binding_changes() const;
+
+	sg::Camera &get_camera();
+
   protected:
 	/**
 	 * @brief Sorts objects based on distance from camera and classifies them
@@ -100,12 +181,90 @@ class SceneSubpass : public Subpass
 	void get_sorted_nodes(std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &opaque_nodes,
 	                      std::multimap<float, std::pair<sg::Node *, sg::SubMesh *>> &transparent_nodes);
 
+	/**
+	 * @return The color blend state used to draw transparent objects
+	 */
+	virtual ColorBlendState get_transparent_color_blend_state();
+
   private:
+	/**
+	 * @brief Compiles the shader modules of every submesh for the current mode
+	 */
+	void prepare_shader_modules();
+
+	/**
+	 * @brief Creates the image bound to the textures materials lack when specialization constants are enabled
+	 */
+	void prepare_fallback_image();
+
+	const ShaderVariant &get_shader_variant(sg::SubMesh &sub_mesh);
+
+	/**
+	 * @brief Uploads the joint matrices of every skin for vertex skinning
+	 */
+	void prepare_joint_palettes();
+
+	/**
+	 * @param skinned_output Vertices deformed by the compute skinning, nullptr if not skinned
+	 */
+	void draw_submesh(CommandBuffer &command_buffer, sg::SubMesh &sub_mesh, VkFrontFace front_face, const ComputeSkinning::Output *skinned_output);
+
 	void draw_submesh_command(CommandBuffer &command_buffer, sg::SubMesh &sub_mesh);
 
+	/**
+	 * @param previous_sub_mesh Submesh drawn before, nullptr if it is the first one
+	 * @return The number of textures of the submesh bound to another image or sampler than in the previous draw call
+	 */
+	uint32_t count_texture_binding_changes(const sg::SubMesh *previous_sub_mesh, const sg::SubMesh &sub_mesh);
+
+	PipelineLayout &request_pipeline_layout(sg::SubMesh &sub_mesh);
+
+	RasterizationState get_rasterization_state(sg::SubMesh &sub_mesh, VkFrontFace front_face);
+
+	VertexInputState get_vertex_input_state(PipelineLayout &pipeline_layout, sg::SubMesh &sub_mesh);
+
 	sg::Camera &camera;
 
 	std::vector<sg::Mesh *> meshes;
+
+	bool specialization_constants_enabled{false};
+
+	bool bindless_textures_enabled{false};
+
+	/// Variants built by the subpass instead of the submeshes, used with specialization constants,
+	/// bindless textures or compute skinning
+	std::unordered_map<const sg::SubMesh *, ShaderVariant> specialization_variants;
+
+	/// Array element of each texture in the bindless descriptor set
+	std::unordered_map<const sg::Texture *, uint32_t> bindless_indices;
+
+	/// Number of elements of the bindless descriptor set
+	uint32_t bindless_texture_count{0};
+
+	std::unique_ptr<DescriptorPool> bindless_pool;
+
+	std::unique_ptr<DescriptorSet> bindless_set;
+
+	/// 1x1 image bound to the textures a material does not have, the shaders never sample it
+	std::unique_ptr<core::Image> fallback_image;
+
+	std::unique_ptr<core::ImageView> fallback_image_view;
+
+	/// Same image for the shader variants which declare their textures as arrays
+	std::unique_ptr<core::ImageView> fallback_array_image_view;
+
+	std::unique_ptr<core::Sampler> fallback_sampler;
+
+	double shader_compile_time{0.0};
+
+	uint32_t texture_binding_changes{0};
+
+	ComputeSkinning *compute_skinning{nullptr};
+
+	/// Joint matrices of each skin for the current frame, used by vertex skinning
+	std::unordered_map<const sg::Skin *, BufferAllocation> joint_palettes;
+
+	double skinning_time{0.0};
 };
 
 }        // namespace vkb
@@ -20,6 +20,8 @@
 
 #include "resource_cache.h"
 
+#include <ctpl_stl.h>
+
 #include "common/resource_caching.h"
 #include "core/device.h"
 
@@ -45,9 +47,14 @@ ResourceCache::ResourceCache(Device &device) :
 
 void ResourceCache::warmup(const std::vector<uint8_t> &data)
 {
+	auto pipeline_count = on_demand_pipeline_count;
+
 	recorder.set_data(data);
 
 	replayer.play(*this, recorder);
+
+	// Pipelines created by the replay are not on demand
+	on_demand_pipeline_count = pipeline_count;
 }
 
 std::vector<uint8_t> ResourceCache::serialize()
@@ -78,7 +85,18 @@ DescriptorSetLayout &ResourceCache::request_descriptor_set_layout(const std::vec
 
 GraphicsPipeline &ResourceCache::request_graphics_pipeline(PipelineState &pipeline_state)
 {
-	return request_resource(device, recorder, graphics_pipeline_mutex, state.graphics_pipelines, pipeline_cache, pipeline_state);
+	std::lock_guard<std::mutex> guard(graphics_pipeline_mutex);
+
+	auto pipeline_count = state.graphics_pipelines.size();
+
+	auto &pipeline = vkb::request_resource(device, &recorder, state.graphics_pipelines, pipeline_cache, pipeline_state);
+
+	if (state.graphics_pipelines.size() != pipeline_count)
+	{
+		on_demand_pipeline_count++;
+	}
+
+	return pipeline;
 }
 
 ComputePipeline &ResourceCache::request_compute_pipeline(PipelineState &pipeline_state)
@@ -86,6 +104,79 @@ ComputePipeline &ResourceCache::request_compute_pipeline(PipelineState &pipeline
 	return request_resource(device, recorder, compute_pipeline_mutex, state.compute_pipelines, pipeline_cache, pipeline_state);
 }
 
+size_t ResourceCache::prebuild_graphics_pipelines(std::vector<PipelineState> &pipeline_states, size_t thread_count)
+{
+	// Find the states which are not cached yet, skipping duplicates
+	std::vector<std::pair<size_t, PipelineState *>> missing_states;
+
+	{
+		std::lock_guard<std::mutex> guard(graphics_pipeline_mutex);
+
+		std::set<size_t> hashes;
+
+		for (auto &pipeline_state : pipeline_states)
+		{
+			size_t hash{0U};
+			hash_param(hash, pipeline_cache, pipeline_state);
+
+			if (state.graphics_pipelines.find(hash) == state.graphics_pipelines.end() && hashes.insert(hash).second)
+			{
+				missing_states.emplace_back(hash, &pipeline_state);
+			}
+		}
+	}
+
+	if (missing_states.empty())
+	{
+		return 0;
+	}
+
+	// Pipeline creation is the expensive part, it happens outside of the lock
+	// and every thread uses its own pipeline cache to avoid contention
+	ctpl::thread_pool thread_pool(static_cast<int>(std::max<size_t>(std::min(thread_count, missing_states.size()), 1)));
+
+	std::vector<std::future<GraphicsPipeline>> futures;
+
+	for (auto &missing_state : missing_states)
+	{
+		auto pipeline_state = missing_state.second;
+
+		futures.push_back(thread_pool.push([this, pipeline_state](size_t thread_index) {
+			auto cache = pipeline_cache != VK_NULL_HANDLE ? device.get_pipeline_cache_manager().get_thread_cache(thread_index) : VK_NULL_HANDLE;
+
+			return GraphicsPipeline{device, cache, *pipeline_state};
+		}));
+	}
+
+	std::lock_guard<std::mutex> guard(graphics_pipeline_mutex);
+
+	size_t created_count = 0;
+
+	for (size_t i = 0; i < futures.size(); ++i)
+	{
+		auto &hash           = missing_states[i].first;
+		auto &pipeline_state = *missing_states[i].second;
+
+		auto res_ins_it = state.graphics_pipelines.emplace(hash, futures[i].get());
+
+		if (res_ins_it.second)
+		{
+			// Record pipelines like the ones requested individually, so that warmup can replay them
+			size_t index = recorder.register_graphics_pipeline(pipeline_cache, pipeline_state);
+			recorder.set_graphics_pipeline(index, res_ins_it.first->second);
+
+			created_count++;
+		}
+	}
+
+	return created_count;
+}
+
+uint32_t ResourceCache::get_on_demand_pipeline_count() const
+{
+	return on_demand_pipeline_count;
+}
+
 DescriptorSet &ResourceCache::request_descriptor_set(DescriptorSetLayout &descriptor_set_layout, const BindingMap<VkDescriptorBufferInfo> &buffer_infos, const BindingMap<VkDescriptorImageInfo> &image_infos)
 {
 	auto &descriptor_pool = request_resource(device, recorder, descriptor_set_mutex, state.descriptor_pools, descriptor_set_layout);
@@ -193,6 +284,83 @@ void ResourceCache::update_descriptor_sets(const std::vector<core::ImageView> &o
 	}
 }
 
+void ResourceCache::update_descriptor_sets(const std::vector<VkBuffer> &old_buffers, const std::vector<VkBuffer> &new_buffers)
+{
+	std::lock_guard<std::mutex> guard(descriptor_set_mutex);
+
+	// Find descriptor sets referring to the old buffers
+	std::vector<VkWriteDescriptorSet> set_updates;
+	std::set<size_t>                  matches;
+
+	for (auto &kd_pair : state.descriptor_sets)
+	{
+		auto &key            = kd_pair.first;
+		auto &descriptor_set = kd_pair.second;
+
+		for (auto &ba_pair : descriptor_set.get_buffer_infos())
+		{
+			auto &binding = ba_pair.first;
+			auto &array   = ba_pair.second;
+
+			for (auto &ai_pair : array)
+			{
+				auto &array_element = ai_pair.first;
+				auto &buffer_info   = ai_pair.second;
+
+				auto old_it = std::find(old_buffers.begin(), old_buffers.end(), buffer_info.buffer);
+
+				if (old_it == old_buffers.end())
+				{
+					continue;
+				}
+
+				VkDescriptorSetLayoutBinding binding_info;
+				if (!descriptor_set.get_layout().get_layout_binding(binding, binding_info))
+				{
+					LOGE("Shader layout set does not use buffer binding at #{}", binding);
+					continue;
+				}
+
+				// Save key to remove old descriptor set
+				matches.insert(key);
+
+				// Update buffer info with the new handle
+				buffer_info.buffer = new_buffers.at(std::distance(old_buffers.begin(), old_it));
+
+				VkWriteDescriptorSet write_descriptor_set{VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+
+				write_descriptor_set.dstBinding      = binding;
+				write_descriptor_set.descriptorType  = binding_info.descriptorType;
+				write_descriptor_set.pBufferInfo     = &buffer_info;
+				write_descriptor_set.dstSet          = descriptor_set.get_handle();
+				write_descriptor_set.dstArrayElement = array_element;
+				write_descriptor_set.descriptorCount = 1;
+
+				set_updates.push_back(write_descriptor_set);
+			}
+		}
+	}
+
+	if (!set_updates.empty())
+	{
+		vkUpdateDescriptorSets(device.get_handle(), to_u32(set_updates.size()), set_updates.data(),
+		                       0, nullptr);
+	}
+
+	// Re-hash the updated descriptor sets
+	for (auto &match : matches)
+	{
+		auto it             = state.descriptor_sets.find(match);
+		auto descriptor_set = std::move(it->second);
+		state.descriptor_sets.erase(match);
+
+		size_t new_key = 0U;
+		hash_param(new_key, descriptor_set.get_layout(), descriptor_set.get_buffer_infos(), descriptor_set.get_image_infos());
+
+		state.descriptor_sets.emplace(new_key, std::move(descriptor_set));
+	}
+}
+
 void ResourceCache::clear_framebuffers()
 {
 	state.framebuffers.clear();
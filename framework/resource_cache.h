@@ -107,6 +107,19 @@ class ResourceCache
 
 	ComputePipeline &request_compute_pipeline(PipelineState &pipeline_state);
 
+	/**
+	 * @brief Creates the graphics pipelines which are not cached yet, using multiple threads
+	 * @param pipeline_states States of the pipelines to create
+	 * @param thread_count Number of threads creating pipelines
+	 * @return The number of pipelines created
+	 */
+	size_t prebuild_graphics_pipelines(std::vector<PipelineState> &pipeline_states, size_t thread_count);
+
+	/**
+	 * @return The number of graphics pipelines created while requested, outside of warmup and prebuild
+	 */
+	uint32_t get_on_demand_pipeline_count() const;
+
 	DescriptorSet &request_descriptor_set(DescriptorSetLayout &                     descriptor_set_layout,
 	                                      const BindingMap<VkDescriptorBufferInfo> &buffer_infos,
 	                                      const BindingMap<VkDescriptorImageInfo> & image_infos);
@@ -125,6 +138,11 @@ class ResourceCache
 	/// @param new_views New image views to be referred
 	void update_descriptor_sets(const std::vector<core::ImageView> &old_views, const std::vector<core::ImageView> &new_views);
 
+	/// @brief Update those descriptor sets referring to old buffers
+	/// @param old_buffers Old buffer handles referred by descriptor sets
+	/// @param new_buffers New buffer handles to be referred
+	void update_descriptor_sets(const std::vector<VkBuffer> &old_buffers, const std::vector<VkBuffer> &new_buffers);
+
 	void clear_framebuffers();
 
 	void clear();
@@ -142,6 +160,8 @@ class ResourceCache
 
 	ResourceCacheState state;
 
+	uint32_t on_demand_pipeline_count{0};
+
 	std::mutex descriptor_set_mutex;
 
 	std::mutex pipeline_layout_mutex;
@@ -52,11 +52,15 @@ inline void write_processes(std::ostringstream &os, const std::vector<std::strin
 
 void ResourceRecord::set_data(const std::vector<uint8_t> &data)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	stream.str(std::string{data.begin(), data.end()});
 }
 
 std::vector<uint8_t> ResourceRecord::get_data()
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	std::string str = stream.str();
 
 	return std::vector<uint8_t>{str.begin(), str.end()};
@@ -69,6 +73,8 @@ const std::ostringstream &ResourceRecord::get_stream()
 
 size_t ResourceRecord::register_shader_module(VkShaderStageFlagBits stage, const ShaderSource &glsl_source, const std::string &entry_point, const ShaderVariant &shader_variant)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	shader_module_indices.push_back(shader_module_indices.size());
 
 	write(stream, ResourceType::ShaderModule, stage, glsl_source.get_data(), entry_point, shader_variant.get_preamble());
@@ -80,6 +86,8 @@ size_t ResourceRecord::register_shader_module(VkShaderStageFlagBits stage, const
 
 size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *> &shader_modules)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	pipeline_layout_indices.push_back(pipeline_layout_indices.size());
 
 	std::vector<size_t> shader_indices(shader_modules.size());
@@ -94,6 +102,8 @@ size_t ResourceRecord::register_pipeline_layout(const std::vector<ShaderModule *
 
 size_t ResourceRecord::register_render_pass(const std::vector<Attachment> &attachments, const std::vector<LoadStoreInfo> &load_store_infos, const std::vector<SubpassInfo> &subpasses)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	render_pass_indices.push_back(render_pass_indices.size());
 
 	write(stream,
@@ -108,6 +118,8 @@ size_t ResourceRecord::register_render_pass(const std::vector<Attachment> &attac
 
 size_t ResourceRecord::register_graphics_pipeline(VkPipelineCache /*pipeline_cache*/, PipelineState &pipeline_state)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	graphics_pipeline_indices.push_back(graphics_pipeline_indices.size());
 
 	auto &pipeline_layout = pipeline_state.get_pipeline_layout();
@@ -149,21 +161,29 @@ size_t ResourceRecord::register_graphics_pipeline(VkPipelineCache /*pipeline_cac
 
 void ResourceRecord::set_shader_module(size_t index, const ShaderModule &shader_module)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	shader_module_to_index[&shader_module] = index;
 }
 
 void ResourceRecord::set_pipeline_layout(size_t index, const PipelineLayout &pipeline_layout)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	pipeline_layout_to_index[&pipeline_layout] = index;
 }
 
 void ResourceRecord::set_render_pass(size_t index, const RenderPass &render_pass)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	render_pass_to_index[&render_pass] = index;
 }
 
 void ResourceRecord::set_graphics_pipeline(size_t index, const GraphicsPipeline &graphics_pipeline)
 {
+	std::lock_guard<std::mutex> guard(record_mutex);
+
 	graphics_pipeline_to_index[&graphics_pipeline] = index;
 }
 
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <vector>
 
 #include "rendering/pipeline_state.h"
@@ -41,6 +42,7 @@ enum class ResourceType
 
 /**
  * @brief Writes Vulkan objects in a memory stream.
+ *        Every method but get_stream() can be called from several threads.
  */
 class ResourceRecord
 {
@@ -88,5 +90,8 @@ class ResourceRecord
 	std::unordered_map<const RenderPass *, size_t> render_pass_to_index;
 
 	std::unordered_map<const GraphicsPipeline *, size_t> graphics_pipeline_to_index;
+
+	/// Resources of different types are requested under different locks of the ResourceCache
+	std::mutex record_mutex;
 };
 }        // namespace vkb
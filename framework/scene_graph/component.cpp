@@ -21,6 +21,8 @@
 #include "component.h"
 
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
 #include "node.h"
 
@@ -28,6 +30,16 @@ namespace vkb
 {
 namespace sg
 {
+size_t get_component_type_index(const std::type_index &type)
+{
+	static std::mutex                                 mutex;
+	static std::unordered_map<std::type_index, size_t> indices;
+
+	std::lock_guard<std::mutex> guard(mutex);
+
+	return indices.emplace(type, indices.size()).first->second;
+}
+
 Component::Component(const std::string &name) :
     name{name}
 {}
@@ -31,6 +31,22 @@ namespace sg
 {
 class Node;
 
+/**
+ * @brief Dense index of a component type, assigned the first time the type is seen,
+ *        so that nodes and scenes can keep their components in arrays instead of hash maps
+ */
+size_t get_component_type_index(const std::type_index &type);
+
+/**
+ * @brief Index of a component type, only looked up once per type
+ */
+template <class T>
+size_t get_component_type_index()
+{
+	static const size_t index = get_component_type_index(typeid(T));
+	return index;
+}
+
 /// @brief A generic class which can be used by nodes.
 class Component
 {
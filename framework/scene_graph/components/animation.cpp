@@ -0,0 +1,264 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "animation.h"
+
+#include <algorithm>
+#include <cmath>
+
+VKBP_DISABLE_WARNINGS()
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/quaternion.hpp>
+VKBP_ENABLE_WARNINGS()
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#	include <xmmintrin.h>
+#	define VKB_ANIMATION_SSE
+#endif
+
+#include "common/utils.h"
+#include "scene_graph/components/transform.h"
+
+namespace vkb
+{
+namespace sg
+{
+namespace
+{
+// Keyframe values are vec4s, the helpers below process the four components at once
+
+inline glm::vec4 blend(const glm::vec4 &a, float weight_a, const glm::vec4 &b, float weight_b)
+{
+#ifdef VKB_ANIMATION_SSE
+	__m128 result = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&a.x), _mm_set1_ps(weight_a)),
+	                           _mm_mul_ps(_mm_loadu_ps(&b.x), _mm_set1_ps(weight_b)));
+
+	glm::vec4 value;
+	_mm_storeu_ps(&value.x, result);
+	return value;
+#else
+	return a * weight_a + b * weight_b;
+#endif
+}
+
+inline float dot(const glm::vec4 &a, const glm::vec4 &b)
+{
+#ifdef VKB_ANIMATION_SSE
+	__m128 product = _mm_mul_ps(_mm_loadu_ps(&a.x), _mm_loadu_ps(&b.x));
+	__m128 sum     = _mm_add_ps(product, _mm_movehl_ps(product, product));
+	sum            = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+	return _mm_cvtss_f32(sum);
+#else
+	return glm::dot(a, b);
+#endif
+}
+
+inline glm::vec4 lerp(const glm::vec4 &a, const glm::vec4 &b, float t)
+{
+	return blend(a, 1.0f - t, b, t);
+}
+
+inline glm::vec4 normalize(const glm::vec4 &value)
+{
+	return blend(value, 1.0f / std::sqrt(dot(value, value)), value, 0.0f);
+}
+
+/**
+ * @brief Spherical interpolation of quaternions stored as (x, y, z, w), along the shortest path
+ */
+inline glm::vec4 slerp(const glm::vec4 &a, const glm::vec4 &b, float t)
+{
+	float cos_theta = dot(a, b);
+	float sign      = 1.0f;
+
+	if (cos_theta < 0.0f)
+	{
+		cos_theta = -cos_theta;
+		sign      = -1.0f;
+	}
+
+	// Close quaternions fall back to a normalized lerp, to avoid dividing by a small sine
+	if (cos_theta > 1.0f - glm::epsilon<float>())
+	{
+		return normalize(blend(a, 1.0f - t, b, sign * t));
+	}
+
+	float theta     = std::acos(cos_theta);
+	float sin_theta = std::sin(theta);
+
+	return blend(a, std::sin((1.0f - t) * theta) / sin_theta, b, sign * std::sin(t * theta) / sin_theta);
+}
+}        // namespace
+
+Animation::Animation(const std::string &name) :
+    Component{name}
+{}
+
+std::type_index Animation::get_type()
+{
+	return typeid(Animation);
+}
+
+uint32_t Animation::add_sampler(AnimationInterpolation interpolation, const std::vector<float> &times, const std::vector<glm::vec4> &values)
+{
+	size_t values_per_key = interpolation == AnimationInterpolation::CubicSpline ? 3 : 1;
+
+	assert(!times.empty() && "An animation sampler must have at least one key");
+	assert(values.size() == times.size() * values_per_key && "Animation sampler values do not match its keys");
+
+	AnimationSampler sampler;
+	sampler.interpolation = interpolation;
+	sampler.first_key     = to_u32(key_times.size());
+	sampler.key_count     = to_u32(times.size());
+	sampler.first_value   = to_u32(key_values.size());
+
+	key_times.insert(key_times.end(), times.begin(), times.end());
+	key_values.insert(key_values.end(), values.begin(), values.end());
+
+	duration = std::max(duration, times.back());
+
+	samplers.push_back(sampler);
+
+	return to_u32(samplers.size() - 1);
+}
+
+void Animation::add_channel(Transform &transform, AnimationTarget target, uint32_t sampler)
+{
+	assert(sampler < samplers.size() && "Animation sampler index is out of bounds");
+
+	AnimationChannel channel;
+	channel.transform = &transform;
+	channel.target    = target;
+	channel.sampler   = sampler;
+
+	channels.push_back(channel);
+}
+
+const std::vector<AnimationChannel> &Animation::get_channels() const
+{
+	return channels;
+}
+
+float Animation::get_duration() const
+{
+	return duration;
+}
+
+glm::vec4 Animation::sample(size_t channel_index, float time, uint32_t &last_key) const
+{
+	const auto &channel = channels[channel_index];
+	const auto &sampler = samplers[channel.sampler];
+
+	const float *    times  = &key_times[sampler.first_key];
+	const glm::vec4 *values = &key_values[sampler.first_value];
+
+	bool is_cubic_spline = sampler.interpolation == AnimationInterpolation::CubicSpline;
+
+	// Cubic splines store the value between the in-tangent and the out-tangent of a key
+	auto get_value = [values, is_cubic_spline](uint32_t key) -> const glm::vec4 & {
+		return is_cubic_spline ? values[key * 3 + 1] : values[key];
+	};
+
+	if (time <= times[0])
+	{
+		last_key = 0;
+		return get_value(0);
+	}
+
+	if (time >= times[sampler.key_count - 1])
+	{
+		last_key = sampler.key_count - 1;
+		return get_value(last_key);
+	}
+
+	uint32_t key = find_key(sampler, time, last_key);
+	last_key     = key;
+
+	float delta_time = times[key + 1] - times[key];
+	float t          = (time - times[key]) / delta_time;
+
+	switch (sampler.interpolation)
+	{
+		case AnimationInterpolation::Step:
+			return values[key];
+
+		case AnimationInterpolation::Linear:
+			return channel.target == AnimationTarget::Rotation ? slerp(values[key], values[key + 1], t) : lerp(values[key], values[key + 1], t);
+
+		case AnimationInterpolation::CubicSpline:
+		default:
+		{
+			// Hermite spline, tangents are scaled by the duration between the keys
+			float t2 = t * t;
+			float t3 = t2 * t;
+
+			const auto &out_tangent = values[key * 3 + 2];
+			const auto &in_tangent  = values[(key + 1) * 3];
+
+			auto value = blend(get_value(key), 2.0f * t3 - 3.0f * t2 + 1.0f, out_tangent, (t3 - 2.0f * t2 + t) * delta_time) +
+			             blend(get_value(key + 1), -2.0f * t3 + 3.0f * t2, in_tangent, (t3 - t2) * delta_time);
+
+			return channel.target == AnimationTarget::Rotation ? normalize(value) : value;
+		}
+	}
+}
+
+void Animation::apply(size_t channel_index, const glm::vec4 &value) const
+{
+	const auto &channel = channels[channel_index];
+
+	switch (channel.target)
+	{
+		case AnimationTarget::Translation:
+			channel.transform->set_translation(glm::vec3(value));
+			break;
+		case AnimationTarget::Rotation:
+			channel.transform->set_rotation(glm::quat(value.w, value.x, value.y, value.z));
+			break;
+		case AnimationTarget::Scale:
+			channel.transform->set_scale(glm::vec3(value));
+			break;
+	}
+}
+
+uint32_t Animation::find_key(const AnimationSampler &sampler, float time, uint32_t last_key) const
+{
+	const float *times = &key_times[sampler.first_key];
+
+	if (last_key + 1 < sampler.key_count && times[last_key] <= time)
+	{
+		if (time < times[last_key + 1])
+		{
+			return last_key;
+		}
+
+		if (last_key + 2 < sampler.key_count && time < times[last_key + 2])
+		{
+			return last_key + 1;
+		}
+	}
+
+	// The time is strictly between the first and the last key, so the result is a valid key
+	auto it = std::upper_bound(times, times + sampler.key_count, time);
+
+	return to_u32(std::distance(times, it) - 1);
+}
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,152 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "common/error.h"
+
+VKBP_DISABLE_WARNINGS()
+#include <glm/glm.hpp>
+VKBP_ENABLE_WARNINGS()
+
+#include "scene_graph/component.h"
+
+namespace vkb
+{
+namespace sg
+{
+class Transform;
+
+enum class AnimationTarget
+{
+	Translation,
+	Rotation,
+	Scale
+};
+
+enum class AnimationInterpolation
+{
+	Linear,
+	Step,
+	CubicSpline
+};
+
+/**
+ * @brief Range of keyframes in the storage of an Animation
+ */
+struct AnimationSampler
+{
+	AnimationInterpolation interpolation{AnimationInterpolation::Linear};
+
+	/// Index of the first key time
+	uint32_t first_key{0};
+
+	uint32_t key_count{0};
+
+	/// Index of the first value, cubic splines store an in-tangent, a value and an out-tangent per key
+	uint32_t first_value{0};
+};
+
+/**
+ * @brief Property of a transform animated by a sampler
+ */
+struct AnimationChannel
+{
+	Transform *transform{nullptr};
+
+	AnimationTarget target{AnimationTarget::Translation};
+
+	uint32_t sampler{0};
+};
+
+/**
+ * @brief An animation clip, as imported from glTF
+ *
+ * The keyframes of all the samplers are stored in two flat arrays, one for the times
+ * and one for the values, so that evaluating a channel touches contiguous memory only.
+ * Values are vec4s, rotations are quaternions stored as (x, y, z, w).
+ */
+class Animation : public Component
+{
+  public:
+	Animation(const std::string &name);
+
+	Animation(Animation &&other) = default;
+
+	virtual ~Animation() = default;
+
+	virtual std::type_index get_type() override;
+
+	/**
+	 * @brief Adds a sampler, its key times must be in increasing order
+	 * @param interpolation Interpolation between the keys
+	 * @param times Time of each key in seconds
+	 * @param values One value per key, or three per key for cubic splines
+	 * @return The index of the sampler
+	 */
+	uint32_t add_sampler(AnimationInterpolation interpolation, const std::vector<float> &times, const std::vector<glm::vec4> &values);
+
+	void add_channel(Transform &transform, AnimationTarget target, uint32_t sampler);
+
+	const std::vector<AnimationChannel> &get_channels() const;
+
+	/**
+	 * @return The time of the last key of all the samplers
+	 */
+	float get_duration() const;
+
+	/**
+	 * @brief Evaluates a channel at a given time
+	 * @param channel_index Index of the channel
+	 * @param time Time in seconds, clamped to the keys of the sampler
+	 * @param last_key Key found by the previous evaluation of this channel, updated with the new key
+	 * @return The interpolated value
+	 */
+	glm::vec4 sample(size_t channel_index, float time, uint32_t &last_key) const;
+
+	/**
+	 * @brief Writes a value produced by sample() into the transform of a channel
+	 */
+	void apply(size_t channel_index, const glm::vec4 &value) const;
+
+  private:
+	/**
+	 * @brief Finds the key preceding a time, starting from the previous key since
+	 *        playback mostly moves forward by less than one key per frame
+	 */
+	uint32_t find_key(const AnimationSampler &sampler, float time, uint32_t last_key) const;
+
+	std::vector<AnimationSampler> samplers;
+
+	std::vector<AnimationChannel> channels;
+
+	std::vector<float> key_times;
+
+	std::vector<glm::vec4> key_values;
+
+	float duration{0.0f};
+};
+}        // namespace sg
+}        // namespace vkb
@@ -110,18 +110,47 @@ const std::vector<Mipmap> &Image::get_mipmaps() const
 	return mipmaps;
 }
 
-void Image::create_vk_image(Device &device)
+uint32_t Image::get_layers() const
+{
+	return layers;
+}
+
+VkImageViewType Image::get_view_type() const
+{
+	return view_type;
+}
+
+void Image::create_vk_image(Device &device, uint32_t mip_levels)
 {
 	assert(!vk_image && !vk_image_view && "Vulkan image already constructed");
 
+	VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+	if (mip_levels == 0)
+	{
+		mip_levels = to_u32(mipmaps.size());
+	}
+	else if (mip_levels > mipmaps.size())
+	{
+		// Levels missing from the data are written by compute shaders
+		usage |= VK_IMAGE_USAGE_STORAGE_BIT;
+	}
+
 	vk_image = std::make_unique<core::Image>(device,
 	                                         get_extent(),
 	                                         format,
-	                                         VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+	                                         usage,
 	                                         VMA_MEMORY_USAGE_GPU_ONLY, VK_SAMPLE_COUNT_1_BIT,
-	                                         to_u32(mipmaps.size()));
+	                                         mip_levels,
+	                                         layers);
 
-	vk_image_view = std::make_unique<core::ImageView>(*vk_image, VK_IMAGE_VIEW_TYPE_2D);
+	vk_image_view = std::make_unique<core::ImageView>(*vk_image, view_type);
+}
+
+core::Image &Image::get_vk_image()
+{
+	assert(vk_image && "Vulkan image was not created");
+	return *vk_image;
 }
 
 const core::Image &Image::get_vk_image() const
@@ -223,7 +252,17 @@ void Image::set_depth(const uint32_t depth)
 	mipmaps.at(0).extent.depth = depth;
 }
 
-std::unique_ptr<Image> Image::load(const std::string &name, const std::string &uri)
+void Image::set_layers(const uint32_t l)
+{
+	layers = l;
+}
+
+void Image::set_view_type(const VkImageViewType type)
+{
+	view_type = type;
+}
+
+std::unique_ptr<Image> Image::load(const std::string &name, const std::string &uri, const AstcEncodeSettings *astc_settings)
 {
 	std::unique_ptr<Image> image{nullptr};
 
@@ -232,7 +271,11 @@ std::unique_ptr<Image> Image::load(const std::string &name, const std::string &u
 	// Get extension
 	auto extension = get_extension(uri);
 
-	if (extension == "png" || extension == "jpg")
+	if ((extension == "png" || extension == "jpg") && astc_settings)
+	{
+		image = AstcEncoded::load(name, data, *astc_settings);
+	}
+	else if (extension == "png" || extension == "jpg")
 	{
 		image = std::make_unique<Stb>(name, data);
 	}
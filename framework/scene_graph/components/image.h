@@ -35,6 +35,8 @@ namespace vkb
 {
 namespace sg
 {
+struct AstcEncodeSettings;
+
 /**
  * @param format Vulkan format
  * @return Whether the vulkan format is ASTC
@@ -61,7 +63,13 @@ class Image : public Component
   public:
 	Image(const std::string &name, std::vector<uint8_t> &&data = {}, std::vector<Mipmap> &&mipmaps = {{}});
 
-	static std::unique_ptr<Image> load(const std::string &name, const std::string &uri);
+	/**
+	 * @brief Loads an image from the assets
+	 * @param name Name of the component
+	 * @param uri Path to the image, relative to the assets directory
+	 * @param astc_settings If not null, PNG and JPG images are encoded to ASTC with these settings
+	 */
+	static std::unique_ptr<Image> load(const std::string &name, const std::string &uri, const AstcEncodeSettings *astc_settings = nullptr);
 
 	virtual ~Image() = default;
 
@@ -77,9 +85,23 @@ class Image : public Component
 
 	const std::vector<Mipmap> &get_mipmaps() const;
 
+	/**
+	 * @return Number of array layers, the data of each mipmap holds the layers one after the other
+	 */
+	uint32_t get_layers() const;
+
+	VkImageViewType get_view_type() const;
+
 	void generate_mipmaps();
 
-	void create_vk_image(Device &device);
+	/**
+	 * @param device A valid device
+	 * @param mip_levels Number of levels of the Vulkan image, 0 for the mipmaps of the data. If there are more,
+	 *                   the image can be used as storage so that ImageKernels generates the others
+	 */
+	void create_vk_image(Device &device, uint32_t mip_levels = 0);
+
+	core::Image &get_vk_image();
 
 	const core::Image &get_vk_image() const;
 
@@ -98,6 +120,10 @@ class Image : public Component
 
 	void set_depth(uint32_t depth);
 
+	void set_layers(uint32_t layers);
+
+	void set_view_type(VkImageViewType view_type);
+
 	Mipmap &get_mipmap(size_t index);
 
 	std::vector<Mipmap> &get_mut_mipmaps();
@@ -109,6 +135,10 @@ class Image : public Component
 
 	std::vector<Mipmap> mipmaps{{}};
 
+	uint32_t layers{1};
+
+	VkImageViewType view_type{VK_IMAGE_VIEW_TYPE_2D};
+
 	std::unique_ptr<core::Image> vk_image;
 
 	std::unique_ptr<core::ImageView> vk_image_view;
@@ -0,0 +1,123 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "scene_graph/components/image/array.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "common/error.h"
+#include "common/utils.h"
+
+namespace vkb
+{
+namespace sg
+{
+namespace
+{
+/**
+ * @return The size in bytes of each mipmap of an image, whatever the order of their offsets
+ */
+std::vector<size_t> get_mipmap_sizes(const Image &image)
+{
+	auto &mipmaps = image.get_mipmaps();
+
+	std::vector<size_t> order(mipmaps.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&mipmaps](size_t a, size_t b) { return mipmaps[a].offset < mipmaps[b].offset; });
+
+	std::vector<size_t> sizes(mipmaps.size());
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		size_t end = i + 1 < order.size() ? mipmaps[order[i + 1]].offset : image.get_data().size();
+
+		sizes[order[i]] = end - mipmaps[order[i]].offset;
+	}
+
+	return sizes;
+}
+}        // namespace
+
+ImageArray::ImageArray(const std::string &name, const std::vector<const Image *> &images) :
+    Image{name}
+{
+	assert(!images.empty() && "An image array needs at least one layer");
+
+	auto &first = *images.front();
+
+	set_format(first.get_format());
+	set_layers(to_u32(images.size()));
+	set_view_type(VK_IMAGE_VIEW_TYPE_2D_ARRAY);
+
+	auto mipmap_sizes = get_mipmap_sizes(first);
+	auto layer_size   = std::accumulate(mipmap_sizes.begin(), mipmap_sizes.end(), size_t{0});
+
+	auto &data = get_mut_data();
+	data.reserve(layer_size * images.size());
+
+	auto &mipmaps = get_mut_mipmaps();
+	mipmaps.clear();
+
+	// Layers of a mipmap are contiguous, so that a single copy region uploads all of them
+	for (size_t i = 0; i < first.get_mipmaps().size(); ++i)
+	{
+		Mipmap mipmap{first.get_mipmaps()[i]};
+		mipmap.offset = to_u32(data.size());
+
+		for (auto image : images)
+		{
+			assert(is_compatible(first, *image) && "Layers of an image array must have the same format, extent and mipmaps");
+
+			auto begin = image->get_data().begin() + image->get_mipmaps()[i].offset;
+			data.insert(data.end(), begin, begin + mipmap_sizes[i]);
+		}
+
+		mipmaps.push_back(mipmap);
+	}
+}
+
+bool ImageArray::is_compatible(const Image &image, const Image &other)
+{
+	auto &mipmaps       = image.get_mipmaps();
+	auto &other_mipmaps = other.get_mipmaps();
+
+	if (image.get_format() != other.get_format() || image.get_layers() != 1 || other.get_layers() != 1 ||
+	    mipmaps.size() != other_mipmaps.size() || image.get_data().size() != other.get_data().size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < mipmaps.size(); ++i)
+	{
+		auto &extent       = mipmaps[i].extent;
+		auto &other_extent = other_mipmaps[i].extent;
+
+		if (mipmaps[i].level != other_mipmaps[i].level || extent.width != other_extent.width ||
+		    extent.height != other_extent.height || extent.depth != other_extent.depth)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+}        // namespace sg
+}        // namespace vkb
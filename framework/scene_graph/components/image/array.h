@@ -0,0 +1,51 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "scene_graph/components/image.h"
+
+namespace vkb
+{
+namespace sg
+{
+/**
+ * @brief Images of the same format, size and mipmap count gathered as the layers
+ *        of a single image, sampled with a VK_IMAGE_VIEW_TYPE_2D_ARRAY view
+ */
+class ImageArray : public Image
+{
+  public:
+	/**
+	 * @brief Copies the data of the images into the layers of the array, in the same order
+	 * @param name Name of the component
+	 * @param images Images with the same format, extent and mipmaps
+	 */
+	ImageArray(const std::string &name, const std::vector<const Image *> &images);
+
+	virtual ~ImageArray() = default;
+
+	/**
+	 * @return Whether an image can be a layer of the same array as another
+	 */
+	static bool is_compatible(const Image &image, const Image &other);
+};
+}        // namespace sg
+}        // namespace vkb
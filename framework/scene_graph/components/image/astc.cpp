@@ -20,6 +20,9 @@
 
 #include "scene_graph/components/image/astc.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <mutex>
 
 #include "common/error.h"
@@ -33,6 +36,11 @@ VKBP_DISABLE_WARNINGS()
 #include <astc_codec_internals.h>
 VKBP_ENABLE_WARNINGS()
 
+#include "common/logging.h"
+#include "platform/filesystem.h"
+#include "scene_graph/components/image/stb.h"
+#include "timer.h"
+
 #define MAGIC_FILE_CONSTANT 0x5CA1AB13
 
 namespace vkb
@@ -90,20 +98,79 @@ BlockDim to_blockdim(const VkFormat format)
 	}
 }
 
-struct AstcHeader
+namespace
 {
-	uint8_t magic[4];
-	uint8_t blockdim_x;
-	uint8_t blockdim_y;
-	uint8_t blockdim_z;
-	uint8_t xsize[3];        // x-size = xsize[0] + xsize[1] + xsize[2]
-	uint8_t ysize[3];        // x-size, y-size and z-size are given in texels;
-	uint8_t zsize[3];        // block count is inferred
+/// "VKBA" read as a little endian integer
+constexpr uint32_t CACHE_MAGIC = 0x41424B56;
+
+/// To be incremented when the encoder or its parameters change, so that cached images are encoded again
+constexpr uint32_t CACHE_VERSION = 1;
+
+/**
+ * @brief Header of the files of the cache of encoded images, followed by the mipmaps and the blocks
+ */
+struct CacheHeader
+{
+	uint32_t magic{CACHE_MAGIC};
+
+	uint32_t version{CACHE_VERSION};
+
+	uint64_t key{0};
+
+	uint32_t format{VK_FORMAT_UNDEFINED};
+
+	uint32_t mipmap_count{0};
+
+	uint64_t data_size{0};
 };
 
-void Astc::init()
+/**
+ * @brief Parameters of the encoder, as chosen by the presets of the command line encoder of the codec
+ */
+struct PresetParameters
+{
+	int partition_search_limit;
+
+	float partition_1_to_2_limit;
+
+	float lowest_correlation_cutoff;
+
+	/// The quality limit in dB is the maximum of two lines decreasing with the number of texels of a block
+	float db_limit_base_a;
+
+	float db_limit_base_b;
+
+	float block_mode_cutoff;
+
+	int max_refinement_iters;
+};
+
+PresetParameters get_preset_parameters(AstcPreset preset)
+{
+	switch (preset)
+	{
+		case AstcPreset::VeryFast:
+			return {2, 1.0f, 0.5f, 70.0f, 53.0f, 0.25f, 1};
+		case AstcPreset::Fast:
+			return {4, 1.0f, 0.5f, 85.0f, 63.0f, 0.5f, 1};
+		case AstcPreset::Medium:
+			return {25, 1.2f, 0.75f, 95.0f, 70.0f, 0.75f, 2};
+		case AstcPreset::Thorough:
+			return {100, 2.5f, 0.95f, 105.0f, 77.0f, 0.95f, 4};
+		case AstcPreset::Exhaustive:
+		default:
+			return {PARTITION_COUNT, 1000.0f, 0.99f, 999.0f, 999.0f, 1.0f, 4};
+	}
+}
+
+/**
+ * @brief Initializes ASTC library
+ *
+ * The tables of each block size are built lazily by the codec, and images are encoded and
+ * decoded by several threads, so they are built here under the lock.
+ */
+void init_codec(const BlockDim &blockdim)
 {
-	// Initializes ASTC library
 	static bool                  initialized{false};
 	static std::mutex            initialization;
 	std::unique_lock<std::mutex> lock{initialization};
@@ -114,7 +181,106 @@ void Astc::init()
 		build_quantization_mode_table();
 		initialized = true;
 	}
+
+	get_block_size_descriptor(blockdim.x, blockdim.y, blockdim.z);
+
+	for (int partition_count = 1; partition_count <= 4; ++partition_count)
+	{
+		get_partition_table(blockdim.x, blockdim.y, blockdim.z, partition_count);
+	}
+}
+
+/**
+ * @brief Scratch memory of the encoder of a block, allocated once per image
+ */
+class EncodeBuffers
+{
+  public:
+	EncodeBuffers()
+	{
+		buffers.ewb        = &ewb;
+		buffers.ewbo       = &ewbo;
+		buffers.tempblocks = tempblocks;
+		buffers.temp       = &temp;
+		buffers.plane1     = &planes[0].buffers;
+		buffers.plane2     = &planes[1].buffers;
+	}
+
+	compress_symbolic_block_buffers *get()
+	{
+		return &buffers;
+	}
+
+  private:
+	struct Plane
+	{
+		Plane()
+		{
+			buffers.ei1                                       = &ei1;
+			buffers.ei2                                       = &ei2;
+			buffers.eix1                                      = eix1.data();
+			buffers.eix2                                      = eix2.data();
+			buffers.decimated_quantized_weights               = decimated_quantized_weights.data();
+			buffers.decimated_weights                         = decimated_weights.data();
+			buffers.flt_quantized_decimated_quantized_weights = flt_quantized_decimated_quantized_weights.data();
+			buffers.u8_quantized_decimated_quantized_weights  = u8_quantized_decimated_quantized_weights.data();
+		}
+
+		compress_fixed_partition_buffers buffers;
+
+		endpoints_and_weights ei1;
+
+		endpoints_and_weights ei2;
+
+		std::vector<endpoints_and_weights> eix1{MAX_DECIMATION_MODES};
+
+		std::vector<endpoints_and_weights> eix2{MAX_DECIMATION_MODES};
+
+		std::vector<float> decimated_quantized_weights = std::vector<float>(2 * MAX_DECIMATION_MODES * MAX_WEIGHTS_PER_BLOCK);
+
+		std::vector<float> decimated_weights = std::vector<float>(2 * MAX_DECIMATION_MODES * MAX_WEIGHTS_PER_BLOCK);
+
+		std::vector<float> flt_quantized_decimated_quantized_weights = std::vector<float>(2 * MAX_WEIGHT_MODES * MAX_WEIGHTS_PER_BLOCK);
+
+		std::vector<uint8_t> u8_quantized_decimated_quantized_weights = std::vector<uint8_t>(2 * MAX_WEIGHT_MODES * MAX_WEIGHTS_PER_BLOCK);
+	};
+
+	compress_symbolic_block_buffers buffers;
+
+	error_weight_block ewb;
+
+	error_weight_block_orig ewbo;
+
+	symbolic_compressed_block tempblocks[4];
+
+	imageblock temp;
+
+	Plane planes[2];
+};
+
+uint64_t hash_bytes(uint64_t hash, const uint8_t *data, size_t size)
+{
+	// 64-bit FNV-1a
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= data[i];
+		hash *= 0x100000001b3;
+	}
+
+	return hash;
 }
+}        // namespace
+
+struct AstcHeader
+{
+	uint8_t magic[4];
+	uint8_t blockdim_x;
+	uint8_t blockdim_y;
+	uint8_t blockdim_z;
+	uint8_t xsize[3];        // x-size = xsize[0] + xsize[1] + xsize[2]
+	uint8_t ysize[3];        // x-size, y-size and z-size are given in texels;
+	uint8_t zsize[3];        // block count is inferred
+};
 
 void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *data_)
 {
@@ -134,6 +300,8 @@ void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *data_)
 		throw std::runtime_error{"Error reading astc: invalid block"};
 	}
 
+	init_codec(blockdim);
+
 	int xsize = extent.width;
 	int ysize = extent.height;
 	int zsize = extent.depth;
@@ -182,15 +350,12 @@ void Astc::decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *data_)
 Astc::Astc(const Image &image) :
     Image{image.get_name()}
 {
-	init();
 	decode(to_blockdim(image.get_format()), image.get_extent(), image.get_data().data());
 }
 
 Astc::Astc(const std::string &name, const std::vector<uint8_t> &data) :
     Image{name}
 {
-	init();
-
 	// Read header
 	if (data.size() < sizeof(AstcHeader))
 	{
@@ -217,5 +382,226 @@ Astc::Astc(const std::string &name, const std::vector<uint8_t> &data) :
 	decode(blockdim, extent, data.data() + sizeof(AstcHeader));
 }
 
+VkFormat to_astc_format(const BlockDim &blockdim)
+{
+	static const VkFormat formats[] = {
+	    VK_FORMAT_ASTC_4x4_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_5x4_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_5x5_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_6x5_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_6x6_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_8x5_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_8x6_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_8x8_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_10x5_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_10x6_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_10x8_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_10x10_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_12x10_UNORM_BLOCK,
+	    VK_FORMAT_ASTC_12x12_UNORM_BLOCK};
+
+	for (auto format : formats)
+	{
+		auto format_blockdim = to_blockdim(format);
+
+		if (format_blockdim.x == blockdim.x && format_blockdim.y == blockdim.y && format_blockdim.z == blockdim.z)
+		{
+			return format;
+		}
+	}
+
+	return VK_FORMAT_UNDEFINED;
+}
+
+AstcEncoded::AstcEncoded(const std::string &name) :
+    Image{name}
+{
+}
+
+AstcEncoded::AstcEncoded(const Image &image, const AstcEncodeSettings &settings) :
+    Image{image.get_name()}
+{
+	assert(image.get_format() == VK_FORMAT_R8G8B8A8_UNORM && "Only RGBA8 images can be encoded");
+
+	auto format = to_astc_format(settings.blockdim);
+	if (format == VK_FORMAT_UNDEFINED)
+	{
+		throw std::runtime_error{"Error encoding astc: invalid block"};
+	}
+
+	init_codec(settings.blockdim);
+
+	int xdim = settings.blockdim.x;
+	int ydim = settings.blockdim.y;
+
+	auto preset = get_preset_parameters(settings.preset);
+
+	auto log10_texels = std::log10(static_cast<float>(xdim * ydim));
+	auto db_limit     = std::max(preset.db_limit_base_a - 35.0f * log10_texels, preset.db_limit_base_b - 19.0f * log10_texels);
+
+	// Every channel has the same weight, as the defaults of the command line encoder
+	error_weighting_params ewp{};
+	ewp.rgb_power                 = 1.0f;
+	ewp.rgb_base_weight           = 1.0f;
+	ewp.alpha_power               = 1.0f;
+	ewp.alpha_base_weight         = 1.0f;
+	ewp.rgba_weights[0]           = 1.0f;
+	ewp.rgba_weights[1]           = 1.0f;
+	ewp.rgba_weights[2]           = 1.0f;
+	ewp.rgba_weights[3]           = 1.0f;
+	ewp.partition_search_limit    = preset.partition_search_limit;
+	ewp.partition_1_to_2_limit    = preset.partition_1_to_2_limit;
+	ewp.lowest_correlation_cutoff = preset.lowest_correlation_cutoff;
+	ewp.block_mode_cutoff         = preset.block_mode_cutoff;
+	ewp.max_refinement_iters      = preset.max_refinement_iters;
+	ewp.texel_avg_error_limit     = std::pow(0.1f, db_limit * 0.1f) * 65535.0f * 65535.0f;
+
+	expand_block_artifact_suppression(xdim, ydim, 1, &ewp);
+
+	swizzlepattern swz_encode = {0, 1, 2, 3};
+
+	// Too large for the stacks of the threads of the loader
+	auto buffers = std::make_unique<EncodeBuffers>();
+
+	imageblock                pb;
+	symbolic_compressed_block scb;
+
+	auto &data    = get_mut_data();
+	auto &mipmaps = get_mut_mipmaps();
+	mipmaps.clear();
+
+	for (auto &source_mipmap : image.get_mipmaps())
+	{
+		int xsize = source_mipmap.extent.width;
+		int ysize = source_mipmap.extent.height;
+
+		int xblocks = (xsize + xdim - 1) / xdim;
+		int yblocks = (ysize + ydim - 1) / ydim;
+
+		auto astc_image = allocate_image(8, xsize, ysize, 1, 0);
+		std::memcpy(astc_image->imagedata8[0][0], image.get_data().data() + source_mipmap.offset, xsize * ysize * 4);
+
+		Mipmap mipmap = source_mipmap;
+		mipmap.offset = to_u32(data.size());
+		mipmaps.push_back(mipmap);
+
+		data.resize(data.size() + xblocks * yblocks * sizeof(physical_compressed_block));
+
+		auto blocks = reinterpret_cast<physical_compressed_block *>(data.data() + mipmap.offset);
+
+		for (int y = 0; y < yblocks; y++)
+		{
+			for (int x = 0; x < xblocks; x++)
+			{
+				fetch_imageblock(astc_image, &pb, xdim, ydim, 1, x * xdim, y * ydim, 0, swz_encode);
+				compress_symbolic_block(astc_image, DECODE_LDR, xdim, ydim, 1, &ewp, &pb, &scb, buffers->get());
+
+				blocks[y * xblocks + x] = symbolic_to_physical(xdim, ydim, 1, &scb);
+			}
+		}
+
+		destroy_image(astc_image);
+	}
+
+	set_format(format);
+}
+
+std::unique_ptr<Image> AstcEncoded::load(const std::string &name, const std::vector<uint8_t> &data, const AstcEncodeSettings &settings)
+{
+	// The key covers everything the encoded blocks depend on
+	uint32_t parameters[] = {CACHE_VERSION, settings.blockdim.x, settings.blockdim.y, static_cast<uint32_t>(settings.preset)};
+
+	auto key = hash_bytes(0xcbf29ce484222325, data.data(), data.size());
+	key      = hash_bytes(key, reinterpret_cast<const uint8_t *>(parameters), sizeof(parameters));
+
+	auto filename = fmt::format("astc_{:016x}.cache", key);
+
+	std::unique_ptr<AstcEncoded> image{new AstcEncoded{name}};
+
+	if (image->read_cache(filename, key))
+	{
+		LOGI("Loaded {} from the ASTC cache", name);
+
+		return std::unique_ptr<Image>{std::move(image)};
+	}
+
+	Timer timer;
+	timer.start();
+
+	image = std::make_unique<AstcEncoded>(Stb{name, data}, settings);
+
+	LOGI("Encoded {} to ASTC {}x{} in {:.2f} s", name, settings.blockdim.x, settings.blockdim.y, timer.stop());
+
+	image->write_cache(filename, key);
+
+	return std::unique_ptr<Image>{std::move(image)};
+}
+
+bool AstcEncoded::read_cache(const std::string &filename, uint64_t key)
+{
+	std::vector<uint8_t> file;
+
+	try
+	{
+		file = fs::read_temp(filename);
+	}
+	catch (const std::runtime_error &)
+	{
+		return false;
+	}
+
+	CacheHeader header{};
+
+	if (file.size() >= sizeof(CacheHeader))
+	{
+		std::memcpy(&header, file.data(), sizeof(CacheHeader));
+	}
+
+	auto mipmaps_size = header.mipmap_count * sizeof(Mipmap);
+
+	if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION || header.key != key ||
+	    !is_astc(static_cast<VkFormat>(header.format)) || header.mipmap_count == 0 ||
+	    file.size() != sizeof(CacheHeader) + mipmaps_size + header.data_size)
+	{
+		LOGW("Invalid ASTC cache file {}", filename);
+		return false;
+	}
+
+	auto &mipmaps = get_mut_mipmaps();
+	mipmaps.resize(header.mipmap_count);
+	std::memcpy(mipmaps.data(), file.data() + sizeof(CacheHeader), mipmaps_size);
+
+	set_data(file.data() + sizeof(CacheHeader) + mipmaps_size, static_cast<size_t>(header.data_size));
+	set_format(static_cast<VkFormat>(header.format));
+
+	return true;
+}
+
+void AstcEncoded::write_cache(const std::string &filename, uint64_t key) const
+{
+	CacheHeader header{};
+	header.key          = key;
+	header.format       = get_format();
+	header.mipmap_count = to_u32(get_mipmaps().size());
+	header.data_size    = get_data().size();
+
+	auto mipmaps_size = get_mipmaps().size() * sizeof(Mipmap);
+
+	std::vector<uint8_t> file(sizeof(CacheHeader) + mipmaps_size + get_data().size());
+	std::memcpy(file.data(), &header, sizeof(CacheHeader));
+	std::memcpy(file.data() + sizeof(CacheHeader), get_mipmaps().data(), mipmaps_size);
+	std::memcpy(file.data() + sizeof(CacheHeader) + mipmaps_size, get_data().data(), get_data().size());
+
+	try
+	{
+		fs::write_temp(file, filename);
+	}
+	catch (const std::runtime_error &ex)
+	{
+		// The image is encoded again by the next run
+		LOGW("Failed to write the ASTC cache of {}: {}", get_name(), ex.what());
+	}
+}
+
 }        // namespace sg
 }        // namespace vkb
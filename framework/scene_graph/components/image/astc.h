@@ -34,6 +34,35 @@ struct BlockDim
 	uint8_t z;
 };
 
+/**
+ * @brief Trade-offs between the quality of encoded images and the time spent encoding them,
+ *        with the parameters of the presets of the command line encoder of the codec
+ */
+enum class AstcPreset
+{
+	VeryFast,
+	Fast,
+	Medium,
+	Thorough,
+	Exhaustive
+};
+
+/**
+ * @brief Settings of the encoding of uncompressed images to ASTC at load time
+ */
+struct AstcEncodeSettings
+{
+	BlockDim blockdim{6, 6, 1};
+
+	AstcPreset preset{AstcPreset::Fast};
+};
+
+/**
+ * @param blockdim Dimensions of a 2D block
+ * @return The UNORM ASTC format with these block dimensions, VK_FORMAT_UNDEFINED if there is none
+ */
+VkFormat to_astc_format(const BlockDim &blockdim);
+
 class Astc : public Image
 {
   public:
@@ -60,11 +89,46 @@ class Astc : public Image
 	 * @param data Pointer to ASTC image data
 	 */
 	void decode(BlockDim blockdim, VkExtent3D extent, const uint8_t *data);
+};
+
+/**
+ * @brief An uncompressed image encoded to ASTC, which takes 128 bits per block
+ *        instead of 32 bits per texel in memory and texture bandwidth
+ */
+class AstcEncoded : public Image
+{
+  public:
+	/**
+	 * @brief Encodes every mipmap of an RGBA8 image
+	 * @param image Image to encode
+	 * @param settings Block dimensions and preset of the encoder
+	 */
+	AstcEncoded(const Image &image, const AstcEncodeSettings &settings);
+
+	virtual ~AstcEncoded() = default;
 
 	/**
-	 * @brief Initializes ASTC library
+	 * @brief Loads a PNG or JPG image encoded to ASTC
+	 *
+	 * Encoded images are cached in temporary storage, addressed by a hash of the content of
+	 * the file and of the settings, so that later runs skip both decoding and encoding.
+	 *
+	 * @param name Name of the component
+	 * @param data Content of the PNG or JPG file
+	 * @param settings Block dimensions and preset of the encoder
 	 */
-	void init();
+	static std::unique_ptr<Image> load(const std::string &name, const std::vector<uint8_t> &data, const AstcEncodeSettings &settings);
+
+  private:
+	AstcEncoded(const std::string &name);
+
+	/**
+	 * @brief Reads an encoded image from the cache
+	 * @return False if the image is not in the cache
+	 */
+	bool read_cache(const std::string &filename, uint64_t key);
+
+	void write_cache(const std::string &filename, uint64_t key) const;
 };
 }        // namespace sg
 }        // namespace vkb
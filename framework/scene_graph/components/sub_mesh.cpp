@@ -20,7 +20,9 @@
 
 #include "sub_mesh.h"
 
+#include "image.h"
 #include "material.h"
+#include "texture.h"
 
 namespace vkb
 {
@@ -75,12 +77,26 @@ void SubMesh::compute_shader_variant()
 
 	if (material != nullptr)
 	{
+		bool texture_arrays = false;
+
 		for (auto &texture : material->textures)
 		{
 			std::string tex_name = texture.first;
 			std::transform(tex_name.begin(), tex_name.end(), tex_name.begin(), ::toupper);
 
 			shader_variant.add_define("HAS_" + tex_name);
+
+			auto image = texture.second->get_image();
+			if (image && image->get_view_type() == VK_IMAGE_VIEW_TYPE_2D_ARRAY)
+			{
+				texture_arrays = true;
+			}
+		}
+
+		// Textures are layers of arrays, selected by the layer in the push constants
+		if (texture_arrays)
+		{
+			shader_variant.add_define("TEXTURE_ARRAYS");
 		}
 	}
 
@@ -33,9 +33,10 @@ std::type_index Texture::get_type()
 	return typeid(Texture);
 }
 
-void Texture::set_image(Image &i)
+void Texture::set_image(Image &i, uint32_t l)
 {
 	image = &i;
+	layer = l;
 }
 
 Image *Texture::get_image()
@@ -43,6 +44,11 @@ Image *Texture::get_image()
 	return image;
 }
 
+uint32_t Texture::get_layer() const
+{
+	return layer;
+}
+
 void Texture::set_sampler(Sampler &s)
 {
 	sampler = &s;
@@ -45,10 +45,16 @@ class Texture : public Component
 
 	virtual std::type_index get_type() override;
 
-	void set_image(Image &image);
+	/**
+	 * @param image Image sampled by the texture
+	 * @param layer Layer of the image, if it is an array
+	 */
+	void set_image(Image &image, uint32_t layer = 0);
 
 	Image *get_image();
 
+	uint32_t get_layer() const;
+
 	void set_sampler(Sampler &sampler);
 
 	Sampler *get_sampler();
@@ -56,6 +62,8 @@ class Texture : public Component
   private:
 	Image *image{nullptr};
 
+	uint32_t layer{0};
+
 	Sampler *sampler{nullptr};
 };
 }        // namespace sg
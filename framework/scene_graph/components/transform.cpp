@@ -112,6 +112,11 @@ void Transform::invalidate_world_matrix()
 	update_world_matrix = true;
 }
 
+bool Transform::is_world_matrix_outdated() const
+{
+	return update_world_matrix;
+}
+
 void Transform::update_world_transform()
 {
 	if (!update_world_matrix)
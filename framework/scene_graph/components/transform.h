@@ -76,6 +76,11 @@ class Transform : public Component
 	 */
 	void invalidate_world_matrix();
 
+	/**
+	 * @return Whether the world matrix needs to be computed again
+	 */
+	bool is_world_matrix_outdated() const;
+
   private:
 	Node &node;
 
@@ -20,6 +20,8 @@
 
 #include "node.h"
 
+#include <stdexcept>
+
 #include "component.h"
 #include "components/transform.h"
 
@@ -39,6 +41,16 @@ const std::string &Node::get_name() const
 	return name;
 }
 
+size_t Node::get_index() const
+{
+	return index;
+}
+
+void Node::set_index(size_t i)
+{
+	index = i;
+}
+
 void Node::set_parent(Node &p)
 {
 	parent = &p;
@@ -63,27 +75,41 @@ const std::vector<Node *> &Node::get_children() const
 
 void Node::set_component(Component &component)
 {
-	auto it = components.find(component.get_type());
+	size_t type_index = get_component_type_index(component.get_type());
 
-	if (it != components.end())
+	if (type_index >= components.size())
 	{
-		it->second = &component;
-	}
-	else
-	{
-		components.insert(std::make_pair(component.get_type(), &component));
+		components.resize(type_index + 1, nullptr);
 	}
+
+	components[type_index] = &component;
 }
 
 Component &Node::get_component(const std::type_index index)
 {
-	return *components.at(index);
+	return get_component(get_component_type_index(index));
+}
+
+Component &Node::get_component(size_t type_index)
+{
+	Component *component = type_index < components.size() ? components[type_index] : nullptr;
+
+	if (!component)
+	{
+		throw std::out_of_range("Node " + name + " does not have the requested component");
+	}
+
+	return *component;
 }
 
 bool Node::has_component(const std::type_index index)
 {
-	return components.count(index) > 0;
+	return has_component(get_component_type_index(index));
 }
 
+bool Node::has_component(size_t type_index)
+{
+	return type_index < components.size() && components[type_index] != nullptr;
+}
 }        // namespace sg
 }        // namespace vkb
@@ -20,12 +20,13 @@
 
 #pragma once
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <typeindex>
-#include <unordered_map>
 #include <vector>
 
+#include "scene_graph/component.h"
 #include "scene_graph/components/transform.h"
 
 namespace vkb
@@ -44,6 +45,13 @@ class Node
 
 	const std::string &get_name() const;
 
+	/**
+	 * @brief Position of the node in the list of nodes of its scene, its state is found by it in a SceneSnapshot
+	 */
+	size_t get_index() const;
+
+	void set_index(size_t index);
+
 	Transform &get_transform()
 	{
 		return transform;
@@ -59,32 +67,45 @@ class Node
 
 	void set_component(Component &component);
 
+	/**
+	 * @brief The component of a type is found by its index, without hashing or RTTI
+	 */
 	template <class T>
 	inline T &get_component()
 	{
-		return dynamic_cast<T &>(get_component(typeid(T)));
+		return static_cast<T &>(get_component(get_component_type_index<T>()));
 	}
 
 	Component &get_component(const std::type_index index);
 
+	/**
+	 * @param type_index Index of the type, as given by get_component_type_index()
+	 */
+	Component &get_component(size_t type_index);
+
 	template <class T>
 	bool has_component()
 	{
-		return has_component(typeid(T));
+		return has_component(get_component_type_index<T>());
 	}
 
 	bool has_component(const std::type_index index);
 
+	bool has_component(size_t type_index);
+
   private:
 	std::string name;
 
+	size_t index{std::numeric_limits<size_t>::max()};
+
 	Transform transform;
 
 	Node *parent{nullptr};
 
 	std::vector<Node *> children;
 
-	std::unordered_map<std::type_index, Component *> components;
+	/// Component of each type, indexed by the index of the type
+	std::vector<Component *> components;
 };
 }        // namespace sg
 }        // namespace vkb
@@ -30,9 +30,16 @@ namespace vkb
 {
 namespace sg
 {
+Scene::Scene()
+{
+	resize_components(get_component_view_factories().size());
+}
+
 Scene::Scene(const std::string &name) :
     name{name}
-{}
+{
+	resize_components(get_component_view_factories().size());
+}
 
 void Scene::set_name(const std::string &new_name)
 {
@@ -48,13 +55,24 @@ void Scene::set_nodes(std::vector<std::unique_ptr<Node>> &&n)
 {
 	assert(nodes.empty() && "Scene nodes were already set");
 	nodes = std::move(n);
+
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		nodes[i]->set_index(i);
+	}
 }
 
 void Scene::add_node(std::unique_ptr<Node> &&n)
 {
+	n->set_index(nodes.size());
 	nodes.emplace_back(std::move(n));
 }
 
+const std::vector<std::unique_ptr<Node>> &Scene::get_nodes() const
+{
+	return nodes;
+}
+
 void Scene::add_child(Node &child)
 {
 	children.push_back(&child);
@@ -69,33 +87,103 @@ void Scene::add_component(std::unique_ptr<Component> &&component, Node &node)
 {
 	node.set_component(*component);
 
-	if (component)
-	{
-		components[component->get_type()].push_back(std::move(component));
-	}
+	add_component(std::move(component));
 }
 
 void Scene::add_component(std::unique_ptr<Component> &&component)
 {
 	if (component)
 	{
-		components[component->get_type()].push_back(std::move(component));
+		auto &storage = get_storage(component->get_type());
+
+		if (storage.view)
+		{
+			storage.view->push_back(*component);
+		}
+
+		storage.components.push_back(std::move(component));
 	}
 }
 
 void Scene::set_components(const std::type_index &type_info, std::vector<std::unique_ptr<Component>> &&new_components)
 {
-	components[type_info] = std::move(new_components);
+	auto &storage = get_storage(type_info);
+
+	storage.components = std::move(new_components);
+
+	if (storage.view)
+	{
+		storage.view->clear();
+
+		for (auto &component : storage.components)
+		{
+			storage.view->push_back(*component);
+		}
+	}
 }
 
 const std::vector<std::unique_ptr<Component>> &Scene::get_components(const std::type_index &type_info) const
 {
-	return components.at(type_info);
+	return components.at(get_component_type_index(type_info)).components;
 }
 
 bool Scene::has_component(const std::type_index &type_info) const
 {
-	return components.count(type_info) != 0 ? true : false;
+	return has_component(get_component_type_index(type_info));
+}
+
+bool Scene::has_component(size_t type_index) const
+{
+	return type_index < components.size() && !components[type_index].components.empty();
+}
+
+size_t Scene::register_component_view(const std::type_index &type_info, ComponentViewFactory factory)
+{
+	size_t type_index = get_component_type_index(type_info);
+
+	auto &factories = get_component_view_factories();
+
+	if (type_index >= factories.size())
+	{
+		factories.resize(type_index + 1, nullptr);
+	}
+
+	factories[type_index] = factory;
+
+	return type_index;
+}
+
+std::vector<Scene::ComponentViewFactory> &Scene::get_component_view_factories()
+{
+	static std::vector<ComponentViewFactory> factories;
+	return factories;
+}
+
+void Scene::resize_components(size_t count)
+{
+	const auto &factories = get_component_view_factories();
+
+	for (size_t type_index = components.size(); type_index < count; ++type_index)
+	{
+		components.emplace_back();
+
+		if (type_index < factories.size() && factories[type_index])
+		{
+			components.back().view = factories[type_index]();
+		}
+	}
+}
+
+Scene::ComponentStorage &Scene::get_storage(const std::type_index &type_info)
+{
+	size_t type_index = get_component_type_index(type_info);
+
+	if (type_index >= components.size())
+	{
+		resize_components(type_index + 1);
+	}
+
+	return components[type_index];
 }
 
 Node *Scene::find_node(const std::string &node_name)
@@ -124,5 +212,40 @@ Node *Scene::find_node(const std::string &node_name)
 
 	return nullptr;
 }
+
+void Scene::update_world_transforms()
+{
+	// Each node is paired with whether the world matrix of its parent has changed
+	std::queue<std::pair<sg::Node *, bool>> traverse_nodes{};
+
+	for (auto root_node : children)
+	{
+		traverse_nodes.emplace(root_node, false);
+	}
+
+	while (!traverse_nodes.empty())
+	{
+		auto node           = traverse_nodes.front().first;
+		auto parent_changed = traverse_nodes.front().second;
+		traverse_nodes.pop();
+
+		auto &transform = node->get_transform();
+
+		if (parent_changed)
+		{
+			transform.invalidate_world_matrix();
+		}
+
+		bool changed = transform.is_world_matrix_outdated();
+
+		// The parent has already been resolved, so only this node is computed
+		transform.get_world_matrix();
+
+		for (auto child_node : node->get_children())
+		{
+			traverse_nodes.emplace(child_node, changed);
+		}
+	}
+}
 }        // namespace sg
 }        // namespace vkb
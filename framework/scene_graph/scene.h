@@ -21,12 +21,14 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
 #include <memory>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
 #include <vector>
 
+#include "scene_graph/component.h"
 #include "scene_graph/components/texture.h"
 
 namespace vkb
@@ -41,7 +43,7 @@ class Component;
 class Scene
 {
   public:
-	Scene() = default;
+	Scene();
 
 	Scene(const std::string &name);
 
@@ -53,6 +55,8 @@ class Scene
 
 	void add_node(std::unique_ptr<Node> &&node);
 
+	const std::vector<std::unique_ptr<Node>> &get_nodes() const;
+
 	void add_child(Node &child);
 
 	const std::vector<Node *> &get_children() const;
@@ -83,19 +87,20 @@ class Scene
 	}
 
 	/**
+	 * @brief Typed view of the components of a type, kept up to date by add_component() and
+	 *        set_components(), so calls neither allocate nor cast. The reference stays valid
+	 *        for the lifetime of the scene. It is not thread-safe with calls that modify the
+	 *        components of the same type.
 	 * @return List of pointers to components casted to the given template type
 	 */
 	template <class T>
-	std::vector<T *> get_components() const
+	const std::vector<T *> &get_components() const
 	{
-		auto &scene_components = get_components(typeid(T));
+		size_t type_index = ComponentViewRegistration<T>::type_index;
 
-		std::vector<T *> result(scene_components.size());
-		std::transform(scene_components.begin(), scene_components.end(), result.begin(),
-		               [](const std::unique_ptr<Component> &component) -> T * {
-			               return dynamic_cast<T *>(component.get());
-		               });
-		return result;
+		assert(type_index < components.size() && components[type_index].view && "Component view registered after the scene was created");
+
+		return static_cast<const ComponentView<T> &>(*components[type_index].view).components;
 	}
 
 	/**
@@ -106,13 +111,22 @@ class Scene
 	template <class T>
 	bool has_component() const
 	{
-		return has_component(typeid(T));
+		return has_component(get_component_type_index<T>());
 	}
 
 	bool has_component(const std::type_index &type_info) const;
 
+	bool has_component(size_t type_index) const;
+
 	Node *find_node(const std::string &name);
 
+	/**
+	 * @brief Computes the outdated world matrices, parents first, so that a node
+	 *        whose local transform changed also invalidates all its descendants.
+	 *        Called after the scripts have been updated.
+	 */
+	void update_world_transforms();
+
   private:
 	std::string name;
 
@@ -121,7 +135,87 @@ class Scene
 
 	std::vector<Node *> children;
 
-	std::unordered_map<std::type_index, std::vector<std::unique_ptr<Component>>> components;
+	/**
+	 * @brief Components of a type, typed by the template subclass
+	 */
+	class ComponentViewBase
+	{
+	  public:
+		virtual ~ComponentViewBase() = default;
+
+		virtual void push_back(Component &component) = 0;
+
+		virtual void clear() = 0;
+	};
+
+	template <class T>
+	class ComponentView : public ComponentViewBase
+	{
+	  public:
+		virtual void push_back(Component &component) override
+		{
+			// Components are stored by the type they return from get_type(), so the cast is safe
+			components.push_back(static_cast<T *>(&component));
+		}
+
+		virtual void clear() override
+		{
+			components.clear();
+		}
+
+		std::vector<T *> components;
+	};
+
+	using ComponentViewFactory = std::unique_ptr<ComponentViewBase> (*)();
+
+	template <class T>
+	static std::unique_ptr<ComponentViewBase> create_component_view()
+	{
+		return std::make_unique<ComponentView<T>>();
+	}
+
+	/**
+	 * @brief Registers the typed view of a component type, every scene then maintains one
+	 * @return The index of the type
+	 */
+	static size_t register_component_view(const std::type_index &type_info, ComponentViewFactory factory);
+
+	/**
+	 * @return Factory of the view of each registered type, indexed by the index of the type
+	 */
+	static std::vector<ComponentViewFactory> &get_component_view_factories();
+
+	/**
+	 * @brief Registers the view of every type used with get_components<T>(), during static
+	 *        initialization, so that the views exist before any scene is created
+	 */
+	template <class T>
+	struct ComponentViewRegistration
+	{
+		static const size_t type_index;
+	};
+
+	struct ComponentStorage
+	{
+		/// The addresses of the components never change, they can be used as handles
+		std::vector<std::unique_ptr<Component>> components;
+
+		/// Allocated separately so that references to it survive the resizing of the storages
+		std::unique_ptr<ComponentViewBase> view;
+	};
+
+	/**
+	 * @brief Adds storages up to a type index, with the views of the registered types
+	 */
+	void resize_components(size_t count);
+
+	ComponentStorage &get_storage(const std::type_index &type_info);
+
+	/// Components of each type, indexed by the index of the type
+	std::vector<ComponentStorage> components;
 };
+
+template <class T>
+const size_t Scene::ComponentViewRegistration<T>::type_index = Scene::register_component_view(typeid(T), &Scene::create_component_view<T>);
 }        // namespace sg
 }        // namespace vkb
@@ -0,0 +1,83 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "scene_snapshot.h"
+
+#include "scene_graph/components/camera.h"
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+#include "scene_graph/scene.h"
+
+namespace vkb
+{
+namespace sg
+{
+void SceneSnapshot::capture(Scene &scene)
+{
+	auto &nodes = scene.get_nodes();
+
+	// Storage is only reallocated when nodes are added to the scene
+	world_matrices.resize(nodes.size());
+	flipped.resize(nodes.size());
+
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		auto &transform = nodes[i]->get_transform();
+
+		const auto &scale = transform.get_scale();
+
+		world_matrices[i] = transform.get_world_matrix();
+		flipped[i]        = scale.x * scale.y * scale.z < 0;
+	}
+
+	for (auto camera : scene.get_components<Camera>())
+	{
+		auto &state = cameras[camera];
+
+		state.view       = camera->get_view();
+		state.projection = camera->get_projection();
+	}
+}
+
+const glm::mat4 &SceneSnapshot::get_world_matrix(const Node &node) const
+{
+	assert(node.get_index() < world_matrices.size() && "Node was not captured in the snapshot");
+
+	return world_matrices[node.get_index()];
+}
+
+bool SceneSnapshot::is_flipped(const Node &node) const
+{
+	assert(node.get_index() < flipped.size() && "Node was not captured in the snapshot");
+
+	return flipped[node.get_index()];
+}
+
+const glm::mat4 &SceneSnapshot::get_view(const Camera &camera) const
+{
+	return cameras.at(&camera).view;
+}
+
+const glm::mat4 &SceneSnapshot::get_projection(const Camera &camera) const
+{
+	return cameras.at(&camera).projection;
+}
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,86 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "common/error.h"
+
+VKBP_DISABLE_WARNINGS()
+#include <glm/glm.hpp>
+VKBP_ENABLE_WARNINGS()
+
+namespace vkb
+{
+namespace sg
+{
+class Camera;
+class Node;
+class Scene;
+
+/**
+ * @brief Copy of the state of a scene needed to record a frame: the world matrices
+ *        of its nodes and the view and projection matrices of its cameras.
+ *
+ * With frame pipelining the scene is updated for the next frame while the current one
+ * is recorded on a render thread, which reads the scene state from a snapshot instead.
+ * Two snapshots are used in turns, so the one being captured is never the one being read,
+ * and their storage is reused from frame to frame.
+ */
+class SceneSnapshot
+{
+  public:
+	/**
+	 * @brief Copies the state of a scene, whose world transforms must have been resolved
+	 * @param scene The scene, nodes are found by their index in it
+	 */
+	void capture(Scene &scene);
+
+	const glm::mat4 &get_world_matrix(const Node &node) const;
+
+	/**
+	 * @return Whether the local scale of the node is negative, which inverts its front face
+	 */
+	bool is_flipped(const Node &node) const;
+
+	const glm::mat4 &get_view(const Camera &camera) const;
+
+	const glm::mat4 &get_projection(const Camera &camera) const;
+
+  private:
+	struct CameraState
+	{
+		glm::mat4 view{1.0f};
+
+		glm::mat4 projection{1.0f};
+	};
+
+	/// World matrices indexed by node index
+	std::vector<glm::mat4> world_matrices;
+
+	/// Whether each node is flipped, indexed by node index
+	std::vector<bool> flipped;
+
+	std::unordered_map<const Camera *, CameraState> cameras;
+};
+}        // namespace sg
+}        // namespace vkb
@@ -50,6 +50,13 @@ class Script : public Component
 	 */
 	virtual void update(float delta_time) = 0;
 
+	/**
+	 * @brief Whether update() can run on a worker thread at the same time as other scripts.
+	 *        A parallel-safe script only modifies the local transform of its own node,
+	 *        and it does not read world matrices, which are resolved after all scripts ran.
+	 */
+	virtual bool is_parallel_safe() const;
+
 	virtual void input_event(const InputEvent &input_event);
 
 	virtual void resize(uint32_t width, uint32_t height);
@@ -0,0 +1,158 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "animation_player.h"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
+
+#include <ctpl_stl.h>
+
+#include "scene_graph/components/animation.h"
+#include "timer.h"
+
+namespace vkb
+{
+namespace sg
+{
+AnimationPlayer::AnimationPlayer(Node &node) :
+    Script{node, "animation_player"}
+{
+	thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+	thread_pool  = std::make_unique<ctpl::thread_pool>(static_cast<int>(thread_count));
+}
+
+AnimationPlayer::~AnimationPlayer() = default;
+
+void AnimationPlayer::play(Animation &animation, bool loop)
+{
+	stop(animation);
+
+	Playback playback;
+	playback.animation = &animation;
+	playback.loop      = loop;
+	playback.last_keys.resize(animation.get_channels().size(), 0);
+
+	playbacks.push_back(std::move(playback));
+}
+
+void AnimationPlayer::stop(Animation &animation)
+{
+	playbacks.erase(std::remove_if(playbacks.begin(), playbacks.end(),
+	                               [&animation](const Playback &playback) { return playback.animation == &animation; }),
+	                playbacks.end());
+}
+
+size_t AnimationPlayer::get_channel_count() const
+{
+	return values.size();
+}
+
+double AnimationPlayer::get_update_time() const
+{
+	return update_time;
+}
+
+void AnimationPlayer::update(float delta_time)
+{
+	Timer timer;
+	timer.start();
+
+	size_t channel_count = 0;
+
+	channel_offsets.resize(playbacks.size());
+
+	for (size_t i = 0; i < playbacks.size(); ++i)
+	{
+		auto &playback = playbacks[i];
+
+		float duration = playback.animation->get_duration();
+
+		playback.time += delta_time;
+
+		if (playback.loop && duration > 0.0f && playback.time > duration)
+		{
+			playback.time = std::fmod(playback.time, duration);
+		}
+
+		channel_offsets[i] = channel_count;
+		channel_count += playback.last_keys.size();
+	}
+
+	values.resize(channel_count);
+
+	if (channel_count < PARALLEL_CHANNEL_COUNT || thread_count == 1)
+	{
+		evaluate(0, channel_count);
+	}
+	else
+	{
+		size_t batch_size = (channel_count + thread_count - 1) / thread_count;
+
+		std::vector<std::future<void>> futures;
+
+		for (size_t begin = 0; begin < channel_count; begin += batch_size)
+		{
+			size_t end = std::min(begin + batch_size, channel_count);
+
+			futures.push_back(thread_pool->push([this, begin, end](size_t) { evaluate(begin, end); }));
+		}
+
+		for (auto &future : futures)
+		{
+			future.get();
+		}
+	}
+
+	for (size_t i = 0; i < playbacks.size(); ++i)
+	{
+		auto &animation = *playbacks[i].animation;
+
+		for (size_t channel = 0; channel < playbacks[i].last_keys.size(); ++channel)
+		{
+			animation.apply(channel, values[channel_offsets[i] + channel]);
+		}
+	}
+
+	update_time = timer.stop<Timer::Milliseconds>();
+}
+
+void AnimationPlayer::evaluate(size_t begin, size_t end)
+{
+	// Playback containing the first channel of the range
+	size_t playback_index = std::upper_bound(channel_offsets.begin(), channel_offsets.end(), begin) - channel_offsets.begin() - 1;
+
+	for (size_t index = begin; index < end; ++playback_index)
+	{
+		auto &playback = playbacks[playback_index];
+
+		size_t offset      = channel_offsets[playback_index];
+		size_t channel_end = std::min(end, offset + playback.last_keys.size());
+
+		for (; index < channel_end; ++index)
+		{
+			values[index] = playback.animation->sample(index - offset, playback.time, playback.last_keys[index - offset]);
+		}
+	}
+}
+}        // namespace sg
+}        // namespace vkb
@@ -0,0 +1,121 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "common/error.h"
+
+VKBP_DISABLE_WARNINGS()
+#include <glm/glm.hpp>
+VKBP_ENABLE_WARNINGS()
+
+#include "scene_graph/script.h"
+
+namespace ctpl
+{
+class thread_pool;
+}        // namespace ctpl
+
+namespace vkb
+{
+namespace sg
+{
+class Animation;
+
+/**
+ * @brief Plays Animation clips and writes their channels into the transforms of the scene
+ *
+ * All the channels of the active clips are evaluated as one flat list, which is
+ * split across worker threads when it is large enough to amortize the dispatch.
+ * The results are written to the transforms afterwards on the calling thread,
+ * because changing a transform invalidates the world matrices of its children.
+ */
+class AnimationPlayer : public Script
+{
+  public:
+	/**
+	 * @brief Minimum number of channels for the evaluation to run on worker threads
+	 */
+	static constexpr size_t PARALLEL_CHANNEL_COUNT = 1024;
+
+	AnimationPlayer(Node &node);
+
+	virtual ~AnimationPlayer();
+
+	virtual void update(float delta_time) override;
+
+	/**
+	 * @brief Starts playing a clip from the beginning
+	 * @param animation The clip to play
+	 * @param loop Whether to restart the clip when it ends, otherwise it holds the last keys
+	 */
+	void play(Animation &animation, bool loop = true);
+
+	void stop(Animation &animation);
+
+	/**
+	 * @return The number of channels evaluated by the last update
+	 */
+	size_t get_channel_count() const;
+
+	/**
+	 * @return The time spent by the last update in milliseconds
+	 */
+	double get_update_time() const;
+
+  private:
+	struct Playback
+	{
+		Animation *animation{nullptr};
+
+		float time{0.0f};
+
+		bool loop{true};
+
+		/// Key found for each channel by the previous evaluation
+		std::vector<uint32_t> last_keys;
+	};
+
+	/**
+	 * @brief Evaluates a range of the flat list of channels
+	 */
+	void evaluate(size_t begin, size_t end);
+
+	std::vector<Playback> playbacks;
+
+	/// Index of the first channel of each playback in the flat list
+	std::vector<size_t> channel_offsets;
+
+	/// Evaluated value of each channel in the flat list
+	std::vector<glm::vec4> values;
+
+	std::unique_ptr<ctpl::thread_pool> thread_pool;
+
+	size_t thread_count{1};
+
+	double update_time{0.0};
+};
+}        // namespace sg
+}        // namespace vkb
@@ -36,9 +36,10 @@ namespace vkb
 {
 namespace sg
 {
-NodeAnimation::NodeAnimation(Node &node, TransformAnimFn animation_fn) :
+NodeAnimation::NodeAnimation(Node &node, TransformAnimFn animation_fn, bool parallel_safe) :
     Script{node, ""},
-    animation_fn{animation_fn}
+    animation_fn{animation_fn},
+    parallel_safe{parallel_safe}
 {
 }
 
@@ -50,6 +51,16 @@ void NodeAnimation::update(float delta_time)
 	}
 }
 
+bool NodeAnimation::is_parallel_safe() const
+{
+	return parallel_safe;
+}
+
+void NodeAnimation::set_parallel_safe(bool safe)
+{
+	parallel_safe = safe;
+}
+
 void NodeAnimation::set_animation(TransformAnimFn handle)
 {
 	animation_fn = handle;
@@ -42,18 +42,33 @@ namespace sg
 class NodeAnimation : public Script
 {
   public:
-	NodeAnimation(Node &node, TransformAnimFn animation_fn);
+	/**
+	 * @param node The node whose transform is animated
+	 * @param animation_fn The animation applied on every update
+	 * @param parallel_safe Whether animation_fn only modifies the transform it is given, see Script::is_parallel_safe()
+	 */
+	NodeAnimation(Node &node, TransformAnimFn animation_fn, bool parallel_safe = false);
 
 	virtual ~NodeAnimation() = default;
 
 	virtual void update(float delta_time) override;
 
+	virtual bool is_parallel_safe() const override;
+
+	/**
+	 * @brief Declares whether the animation only modifies the transform it is given,
+	 *        and reads no other node, so that it can run as a parallel job
+	 */
+	void set_parallel_safe(bool parallel_safe);
+
 	void set_animation(TransformAnimFn handle);
 
 	void clear_animation();
 
   private:
 	TransformAnimFn animation_fn{};
+
+	bool parallel_safe{false};
 };
 }        // namespace sg
 }        // namespace vkb
@@ -357,7 +357,7 @@ inline void read_shader_resource<ShaderResourceType::BufferStorage>(const spirv_
 
 	for (auto &resource : storage_resources)
 	{
-		ShaderResource shader_resource;
+		ShaderResource shader_resource{};
 		shader_resource.type   = ShaderResourceType::BufferStorage;
 		shader_resource.stages = stage;
 		shader_resource.name   = resource.name;
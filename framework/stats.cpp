@@ -21,9 +21,19 @@
 #include "stats.h"
 
 #include "common/error.h"
+#include "common/logging.h"
 
 namespace vkb
 {
+namespace
+{
+// Weight of the latest sample in the running average of the sampling overhead
+constexpr float OVERHEAD_SMOOTHING = 0.05f;
+
+// Maximum number of samples waiting to be displayed
+constexpr size_t MAX_PENDING_SAMPLES = 100;
+}        // namespace
+
 Stats::Stats(const std::set<StatIndex> &enabled_stats, CounterSamplingConfig sampling_config,
              const size_t buffer_size) :
     enabled_stats(enabled_stats),
@@ -34,10 +44,10 @@ Stats::Stats(const std::set<StatIndex> &enabled_stats, CounterSamplingConfig sam
 
 	for (const auto &stat : enabled_stats)
 	{
-		counters[stat] = std::vector<float>(buffer_size, 0);
+		counters[static_cast<size_t>(stat)].values = std::vector<float>(buffer_size, 0);
 	}
 
-	stat_data = {
+	StatDataMap stat_data_map = {
 	    {StatIndex::frame_times, {StatScaling::None}},
 	    {StatIndex::cpu_cycles, {hwcpipe::CpuCounter::Cycles}},
 	    {StatIndex::cpu_instructions, {hwcpipe::CpuCounter::Instructions}},
@@ -57,37 +67,43 @@ Stats::Stats(const std::set<StatIndex> &enabled_stats, CounterSamplingConfig sam
 	    {StatIndex::l2_ext_read_bytes, {hwcpipe::GpuCounter::ExternalMemoryReadBytes}},
 	    {StatIndex::l2_ext_write_bytes, {hwcpipe::GpuCounter::ExternalMemoryWriteBytes}},
 	    {StatIndex::tex_cycles, {hwcpipe::GpuCounter::ShaderTextureCycles}},
+	    {StatIndex::script_times, {StatScaling::None}},
+	    {StatIndex::attachment_load_bytes, {StatScaling::None}},
+	    {StatIndex::attachment_store_bytes, {StatScaling::None}},
 	};
 
+	for (const auto &data : stat_data_map)
+	{
+		stat_data[static_cast<size_t>(data.first)]     = data.second;
+		stat_data_set[static_cast<size_t>(data.first)] = true;
+	}
+
 	hwcpipe::CpuCounterSet enabled_cpu_counters{};
 	hwcpipe::GpuCounterSet enabled_gpu_counters{};
 
 	for (const auto &stat : enabled_stats)
 	{
-		auto res = stat_data.find(stat);
-		if (res != stat_data.end())
+		const auto &data = stat_data[static_cast<size_t>(stat)];
+		switch (data.type)
 		{
-			switch (res->second.type)
-			{
-				case StatType::Cpu:
-					enabled_cpu_counters.insert(res->second.cpu_counter);
+			case StatType::Cpu:
+				enabled_cpu_counters.insert(data.cpu_counter);
 
-					if (res->second.divisor_cpu_counter != hwcpipe::CpuCounter::MaxValue)
-					{
-						enabled_cpu_counters.insert(res->second.divisor_cpu_counter);
-					}
-					break;
-				case StatType::Gpu:
-					enabled_gpu_counters.insert(res->second.gpu_counter);
+				if (data.divisor_cpu_counter != hwcpipe::CpuCounter::MaxValue)
+				{
+					enabled_cpu_counters.insert(data.divisor_cpu_counter);
+				}
+				break;
+			case StatType::Gpu:
+				enabled_gpu_counters.insert(data.gpu_counter);
 
-					if (res->second.divisor_gpu_counter != hwcpipe::GpuCounter::MaxValue)
-					{
-						enabled_gpu_counters.insert(res->second.divisor_gpu_counter);
-					}
-					break;
-				default:
-					break;
-			}
+				if (data.divisor_gpu_counter != hwcpipe::GpuCounter::MaxValue)
+				{
+					enabled_gpu_counters.insert(data.divisor_gpu_counter);
+				}
+				break;
+			default:
+				break;
 		}
 	}
 
@@ -115,6 +131,8 @@ Stats::~Stats()
 	if (worker_thread.joinable())
 	{
 		worker_thread.join();
+
+		LOGI("Continuous counter sampling: {:.1f} us per sample, {} samples dropped", get_sampling_overhead(), get_dropped_sample_count());
 	}
 }
 
@@ -122,31 +140,47 @@ void Stats::resize(const size_t width)
 {
 	// The circular buffer size will be 1/16th of the width of the screen
 	// which means every sixteen pixels represent one graph value
-	size_t buffers_size = width >> 4;
+	size_t buffers_size = std::max<size_t>(2, width >> 4);
 
 	for (auto &counter : counters)
 	{
-		counter.second.resize(buffers_size);
-		counter.second.shrink_to_fit();
+		const auto old_size = counter.values.size();
+		if (old_size == 0 || old_size == buffers_size)
+		{
+			continue;
+		}
+
+		// Keep the most recent values in chronological order, starting from index 0
+		std::vector<float> values(buffers_size, 0.0f);
+
+		const auto kept_count = std::min(old_size, buffers_size);
+		for (size_t i = 0; i < kept_count; ++i)
+		{
+			values[buffers_size - kept_count + i] = counter.values[(counter.head + old_size - kept_count + i) % old_size];
+		}
+
+		counter.values = std::move(values);
+		counter.head   = 0;
 	}
 }
 
 bool Stats::is_available(const StatIndex index) const
 {
-	const auto &data = stat_data.find(index);
-	if (data == stat_data.end())
+	if (!stat_data_set[static_cast<size_t>(index)])
 	{
 		return false;
 	}
 
-	switch (data->second.type)
+	const auto &data = stat_data[static_cast<size_t>(index)];
+
+	switch (data.type)
 	{
 		case StatType::Cpu:
 		{
 			if (hwcpipe->cpu_profiler())
 			{
 				const auto &cpu_supp = hwcpipe->cpu_profiler()->supported_counters();
-				return cpu_supp.find(data->second.cpu_counter) != cpu_supp.end();
+				return cpu_supp.find(data.cpu_counter) != cpu_supp.end();
 			}
 			break;
 		}
@@ -155,7 +189,7 @@ bool Stats::is_available(const StatIndex index) const
 			if (hwcpipe->gpu_profiler())
 			{
 				const auto &gpu_supp = hwcpipe->gpu_profiler()->supported_counters();
-				return gpu_supp.find(data->second.gpu_counter) != gpu_supp.end();
+				return gpu_supp.find(data.gpu_counter) != gpu_supp.end();
 			}
 			break;
 		}
@@ -168,18 +202,24 @@ bool Stats::is_available(const StatIndex index) const
 	return false;
 }
 
-void add_smoothed_value(std::vector<float> &values, float value, float alpha)
+float Stats::get_sampling_overhead() const
 {
-	assert(values.size() >= 2 && "Buffers size should be greater than 2");
+	return sampling_overhead.load(std::memory_order_relaxed);
+}
 
-	if (values.size() == values.capacity())
-	{
-		// Shift values to the left to make space at the end and update counters
-		std::rotate(values.begin(), values.begin() + 1, values.end());
-	}
+uint32_t Stats::get_dropped_sample_count() const
+{
+	return dropped_sample_count.load(std::memory_order_relaxed);
+}
+
+void add_smoothed_value(StatBuffer &buffer, float value, float alpha)
+{
+	assert(buffer.values.size() >= 2 && "Buffers size should be greater than 2");
 
-	// Use an exponential moving average to smooth values
-	values.back() = value * alpha + *(values.end() - 2) * (1.0f - alpha);
+	// Use an exponential moving average to smooth values, overwriting the oldest one
+	buffer.values[buffer.head] = value * alpha + buffer.get_latest() * (1.0f - alpha);
+
+	buffer.head = (buffer.head + 1) % buffer.values.size();
 }
 
 void Stats::update()
@@ -190,48 +230,33 @@ void Stats::update()
 	{
 		case CounterSamplingMode::Polling:
 		{
-			auto m          = hwcpipe->sample();
-			pending_samples = {{m.cpu ? *m.cpu : hwcpipe::CpuMeasurements{},
-			                    m.gpu ? *m.gpu : hwcpipe::GpuMeasurements{},
-			                    delta_time}};
+			pending_samples = {sample(delta_time)};
 			break;
 		}
 		case CounterSamplingMode::Continuous:
 		{
-			// Check that we have no pending samples to be shown
-			if (pending_samples.size() == 0)
+			// Read the samples captured by the worker thread since the previous frame,
+			// so that the queue never fills up while older samples are being shown
+			while (continuous_samples.pop(popped_sample))
 			{
-				std::unique_lock<std::mutex> lock(continuous_sampling_mutex);
-				if (!should_add_to_continuous_samples)
-				{
-					// If we have no pending samples, we let the worker thread
-					// capture samples for the next frame
-					should_add_to_continuous_samples = true;
-				}
-				else
-				{
-					// The worker thread has captured a frame, so we stop it
-					// and read the samples
-					should_add_to_continuous_samples = false;
-					pending_samples                  = continuous_samples;
-					continuous_samples.clear();
-				}
+				pending_samples.push_back(popped_sample);
 			}
 
-			// Ensure the number of pending samples is capped at a reasonable value
-			if (pending_samples.size() > 100)
+			// Ensure the number of pending samples is capped at a reasonable value, keeping the latest ones
+			if (pending_samples.size() > MAX_PENDING_SAMPLES)
 			{
-				pending_samples.resize(100);
+				pending_samples.erase(pending_samples.begin(), pending_samples.end() - MAX_PENDING_SAMPLES);
 			}
 			break;
 		}
 	}
 
 	// Handle delta time counter
-	auto delta_time_counter = counters.find(StatIndex::frame_times);
-	if (delta_time_counter != counters.end())
+	auto &delta_time_counter = counters[static_cast<size_t>(StatIndex::frame_times)];
+	if (!delta_time_counter.values.empty())
 	{
-		add_smoothed_value(delta_time_counter->second, delta_time, alpha_smoothing);
+		latest_values[static_cast<size_t>(StatIndex::frame_times)] = delta_time;
+		add_smoothed_value(delta_time_counter, delta_time, alpha_smoothing);
 	}
 
 	if (pending_samples.size() == 0)
@@ -245,11 +270,42 @@ void Stats::update()
 	// Clamp the number of samples
 	sample_count = std::max<size_t>(1, std::min(sample_count, pending_samples.size()));
 
-	// Push the samples to circular buffers
-	std::for_each(pending_samples.end() - sample_count, pending_samples.end(), [this](const auto &s) {
+	// Push the oldest samples to circular buffers, in the order they were captured
+	std::for_each(pending_samples.begin(), pending_samples.begin() + sample_count, [this](const auto &s) {
 		push_sample(s);
 	});
-	pending_samples.erase(pending_samples.end() - sample_count, pending_samples.end());
+	pending_samples.erase(pending_samples.begin(), pending_samples.begin() + sample_count);
+}
+
+void Stats::add_value(const StatIndex index, const float value)
+{
+	assert(stat_data[static_cast<size_t>(index)].type == StatType::Other && "Counter stats are sampled by Stats");
+
+	auto &counter = counters[static_cast<size_t>(index)];
+	if (!counter.values.empty())
+	{
+		latest_values[static_cast<size_t>(index)] = value;
+		add_smoothed_value(counter, value, alpha_smoothing);
+	}
+}
+
+Stats::MeasurementSample Stats::sample(float delta_time)
+{
+	Timer timer;
+	timer.start();
+
+	const auto measurements = hwcpipe->sample();
+
+	MeasurementSample sample{measurements.cpu ? *measurements.cpu : hwcpipe::CpuMeasurements{},
+	                         measurements.gpu ? *measurements.gpu : hwcpipe::GpuMeasurements{},
+	                         delta_time};
+
+	// Only the thread sampling the counters writes the overhead, so a load and a store are enough
+	auto elapsed = static_cast<float>(timer.stop<Timer::Microseconds>());
+	auto average = sampling_overhead.load(std::memory_order_relaxed);
+	sampling_overhead.store(average == 0.0f ? elapsed : average + (elapsed - average) * OVERHEAD_SMOOTHING, std::memory_order_relaxed);
+
+	return sample;
 }
 
 void Stats::continuous_sampling_worker(std::future<void> should_terminate)
@@ -270,44 +326,36 @@ void Stats::continuous_sampling_worker(std::future<void> should_terminate)
 		}
 
 		// Sample counters
-		const auto measurements = hwcpipe->sample();
+		const auto measurement_sample = sample(delta_time);
 
-		// Add the new sample to the vector of continuous samples
+		// Add the new sample to the queue of continuous samples, without waiting for the main thread
+		if (!continuous_samples.push(measurement_sample))
 		{
-			std::unique_lock<std::mutex> lock(continuous_sampling_mutex);
-			continuous_samples.push_back({measurements.cpu ? *measurements.cpu : hwcpipe::CpuMeasurements{},
-			                              measurements.gpu ? *measurements.gpu : hwcpipe::GpuMeasurements{},
-			                              delta_time});
+			dropped_sample_count.fetch_add(1, std::memory_order_relaxed);
 		}
 	}
 }
 
 void Stats::push_sample(const MeasurementSample &sample)
 {
-	for (auto &c : counters)
+	for (const auto &stat : enabled_stats)
 	{
-		auto &values = c.second;
-
-		const auto data = stat_data.find(c.first);
-		if (data == stat_data.end())
-		{
-			continue;
-		}
+		const auto &data = stat_data[static_cast<size_t>(stat)];
 
 		float measurement = 0;
-		switch (data->second.type)
+		switch (data.type)
 		{
 			case StatType::Cpu:
 			{
-				const auto &cpu_res = sample.cpu.find(data->second.cpu_counter);
+				const auto &cpu_res = sample.cpu.find(data.cpu_counter);
 				if (cpu_res != sample.cpu.end())
 				{
 					measurement = cpu_res->second.get<float>();
 				}
 
-				if (data->second.scaling == StatScaling::ByCounter)
+				if (data.scaling == StatScaling::ByCounter)
 				{
-					const auto &divisor_cpu_res = sample.cpu.find(data->second.divisor_cpu_counter);
+					const auto &divisor_cpu_res = sample.cpu.find(data.divisor_cpu_counter);
 					if (divisor_cpu_res != sample.cpu.end())
 					{
 						measurement /= divisor_cpu_res->second.get<float>();
@@ -321,15 +369,15 @@ void Stats::push_sample(const MeasurementSample &sample)
 			}
 			case StatType::Gpu:
 			{
-				const auto &gpu_res = sample.gpu.find(data->second.gpu_counter);
+				const auto &gpu_res = sample.gpu.find(data.gpu_counter);
 				if (gpu_res != sample.gpu.end())
 				{
 					measurement = gpu_res->second.get<float>();
 				}
 
-				if (data->second.scaling == StatScaling::ByCounter)
+				if (data.scaling == StatScaling::ByCounter)
 				{
-					const auto &divisor_gpu_res = sample.gpu.find(data->second.divisor_gpu_counter);
+					const auto &divisor_gpu_res = sample.gpu.find(data.divisor_gpu_counter);
 					if (divisor_gpu_res != sample.gpu.end())
 					{
 						measurement /= divisor_gpu_res->second.get<float>();
@@ -348,12 +396,13 @@ void Stats::push_sample(const MeasurementSample &sample)
 			}
 		}
 
-		if (data->second.scaling == StatScaling::ByDeltaTime)
+		if (data.scaling == StatScaling::ByDeltaTime)
 		{
 			measurement /= sample.delta_time;
 		}
 
-		add_smoothed_value(values, measurement, alpha_smoothing);
+		latest_values[static_cast<size_t>(stat)] = measurement;
+		add_smoothed_value(counters[static_cast<size_t>(stat)], measurement, alpha_smoothing);
 	}
 }
 
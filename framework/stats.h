@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <ctime>
 #include <future>
@@ -28,6 +30,7 @@
 #include <vector>
 
 #include "common/error.h"
+#include "common/spsc_queue.h"
 
 VKBP_DISABLE_WARNINGS()
 #include <hwcpipe.h>
@@ -60,9 +63,15 @@ enum class StatIndex
 	l2_ext_write_stalls,
 	l2_ext_read_bytes,
 	l2_ext_write_bytes,
-	tex_cycles
+	tex_cycles,
+	script_times,
+	attachment_load_bytes,
+	attachment_store_bytes
 };
 
+/// Number of stats in @ref StatIndex, used to size arrays indexed by it
+constexpr size_t STAT_INDEX_COUNT = static_cast<size_t>(StatIndex::attachment_store_bytes) + 1;
+
 struct StatIndexHash
 {
 	template <typename T>
@@ -140,6 +149,28 @@ struct StatData
 
 using StatDataMap = std::unordered_map<StatIndex, StatData, StatIndexHash>;
 
+/**
+ * @brief Fixed size circular buffer of the values of a stat
+ *
+ * New values overwrite the oldest one at head, which then moves forward,
+ * so values are in chronological order starting from head.
+ */
+struct StatBuffer
+{
+	std::vector<float> values;
+
+	/// Index of the oldest value, which is the next one to be overwritten
+	size_t head{0};
+
+	/**
+	 * @return The most recent value
+	 */
+	float get_latest() const
+	{
+		return values[(head + values.size() - 1) % values.size()];
+	}
+};
+
 enum class CounterSamplingMode
 {
 	/// Sample counters only when calling update()
@@ -197,13 +228,21 @@ class Stats
 
 	/**
 	 * @param index The stat index of the data requested
-	 * @return The data of the specified stat
+	 * @return The circular buffer of the specified stat
 	 */
-	const std::vector<float> &get_data(StatIndex index) const
+	const StatBuffer &get_data(StatIndex index) const
 	{
-		return counters.at(index);
+		return counters[static_cast<size_t>(index)];
 	};
 
+	/**
+	 * @return The value of each stat before smoothing, as of the last update, indexed by StatIndex
+	 */
+	const std::array<float, STAT_INDEX_COUNT> &get_latest_values() const
+	{
+		return latest_values;
+	}
+
 	/**
 	 * @return The enabled stats
 	 */
@@ -217,6 +256,23 @@ class Stats
 	 */
 	void update();
 
+	/**
+	 * @brief Adds a value measured by the application, for stats which do not use counters
+	 * @param index The stat index, it is ignored if the stat is not enabled
+	 * @param value The measured value, in seconds for times
+	 */
+	void add_value(StatIndex index, float value);
+
+	/**
+	 * @return The average time spent sampling the counters once, in microseconds
+	 */
+	float get_sampling_overhead() const;
+
+	/**
+	 * @return The number of samples discarded because the main thread did not read them in time
+	 */
+	uint32_t get_dropped_sample_count() const;
+
   private:
 	struct MeasurementSample
 	{
@@ -231,8 +287,11 @@ class Stats
 	/// Counter sampling configuration
 	CounterSamplingConfig sampling_config;
 
-	/// Mapping of stats to their availability and value getters
-	StatDataMap stat_data;
+	/// Description of every stat, indexed by StatIndex
+	std::array<StatData, STAT_INDEX_COUNT> stat_data;
+
+	/// Whether the stat_data entry of a StatIndex has been described, the others are not available
+	std::array<bool, STAT_INDEX_COUNT> stat_data_set{};
 
 	/// Timer used in the main thread to compute delta time
 	Timer main_timer;
@@ -243,8 +302,11 @@ class Stats
 	/// Alpha smoothing for running average
 	float alpha_smoothing{0.2f};
 
-	/// Circular buffers for counter data
-	std::map<StatIndex, std::vector<float>> counters{};
+	/// Circular buffers for counter data, indexed by StatIndex
+	std::array<StatBuffer, STAT_INDEX_COUNT> counters{};
+
+	/// Values of the stats before smoothing, indexed by StatIndex
+	std::array<float, STAT_INDEX_COUNT> latest_values{};
 
 	/// Profiler to gather CPU and GPU performance data
 	std::unique_ptr<hwcpipe::HWCPipe> hwcpipe{};
@@ -255,22 +317,30 @@ class Stats
 	/// Promise to stop the worker thread
 	std::unique_ptr<std::promise<void>> stop_worker;
 
-	/// A mutex for accessing measurements during continuous sampling
-	std::mutex continuous_sampling_mutex;
+	/// The samples read during continuous sampling, produced by the worker thread
+	/// and consumed by the main thread
+	SpscQueue<MeasurementSample> continuous_samples{256};
 
-	/// The samples read during continuous sampling
-	std::vector<MeasurementSample> continuous_samples;
+	/// Running average of the time spent in a single counter sample in microseconds,
+	/// written by the thread that samples the counters
+	std::atomic<float> sampling_overhead{0.0f};
 
-	/// A flag specifying if the worker thread should add entries to continuous_samples
-	bool should_add_to_continuous_samples{false};
+	/// Number of samples the worker thread could not add to continuous_samples
+	std::atomic<uint32_t> dropped_sample_count{0};
 
 	/// The samples waiting to be displayed
 	std::vector<MeasurementSample> pending_samples;
 
+	/// Sample exchanged with the slots of continuous_samples, so that their storage is reused
+	MeasurementSample popped_sample;
+
 	/// The worker thread function for continuous sampling;
 	/// it adds a new entry to continuous_samples at every interval
 	void continuous_sampling_worker(std::future<void> should_terminate);
 
+	/// Samples the counters and updates the sampling overhead
+	MeasurementSample sample(float delta_time);
+
 	/// Updates circular buffers for CPU and GPU counters
 	void push_sample(const MeasurementSample &sample);
 };
@@ -0,0 +1,91 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace vkb
+{
+/**
+ * @brief Layout of the binary logs written by TelemetryRecorder
+ *
+ * This header has no dependency on the rest of the framework, so that the converter
+ * tool can read the logs without linking it. Values are stored in the byte order of
+ * the recording machine, which is little endian on every supported platform.
+ *
+ * A log is made of:
+ * - a TelemetryHeader
+ * - a TelemetryStat for each recorded stat, in the order of the values of a record
+ * - records until the end of the file, each one is a TelemetryRecord followed by
+ *   one float per recorded stat
+ */
+namespace telemetry
+{
+/// "VKBT" read as a little endian integer
+constexpr uint32_t MAGIC = 0x54424B56;
+
+constexpr uint32_t VERSION = 1;
+
+/// Size of the zero padded names of the stats
+constexpr uint32_t STAT_NAME_SIZE = 32;
+
+#pragma pack(push, 1)
+
+struct TelemetryHeader
+{
+	uint32_t magic{MAGIC};
+
+	uint32_t version{VERSION};
+
+	/// Number of values in each record
+	uint32_t stat_count{0};
+
+	/// Size of a record with its values in bytes
+	uint32_t record_size{0};
+};
+
+struct TelemetryStat
+{
+	/// Value of the StatIndex of the stat
+	uint32_t index{0};
+
+	char name[STAT_NAME_SIZE]{};
+};
+
+struct TelemetryRecord
+{
+	uint64_t frame_index{0};
+
+	/// Time since the recorder was created in microseconds
+	uint64_t timestamp{0};
+
+	/// Duration of the frame in seconds
+	float delta_time{0.0f};
+};
+
+#pragma pack(pop)
+
+inline uint32_t get_record_size(uint32_t stat_count)
+{
+	return static_cast<uint32_t>(sizeof(TelemetryRecord) + stat_count * sizeof(float));
+}
+}        // namespace telemetry
+}        // namespace vkb
@@ -0,0 +1,178 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "telemetry_recorder.h"
+
+#include <cstring>
+
+#include "common/error.h"
+#include "common/helpers.h"
+#include "common/logging.h"
+#include "telemetry_format.h"
+#include "utils/strings.h"
+
+namespace vkb
+{
+namespace
+{
+// Interval at which the writer thread drains the queue
+constexpr std::chrono::milliseconds WRITE_INTERVAL{50};
+}        // namespace
+
+TelemetryRecorder::TelemetryRecorder(const std::string &path, const std::set<StatIndex> &stats, size_t capacity) :
+    stats(stats.begin(), stats.end()),
+    file(path, std::ios::out | std::ios::binary | std::ios::trunc),
+    record_size{telemetry::get_record_size(to_u32(stats.size()))},
+    records{capacity},
+    stop_writer(std::make_unique<std::promise<void>>())
+{
+	if (!file.is_open())
+	{
+		LOGE("Failed to open telemetry log {}", path);
+		return;
+	}
+
+	telemetry::TelemetryHeader header;
+	header.stat_count  = to_u32(stats.size());
+	header.record_size = to_u32(record_size);
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+	for (auto stat : stats)
+	{
+		telemetry::TelemetryStat stat_header;
+		stat_header.index = static_cast<uint32_t>(stat);
+
+		auto name = utils::to_string(stat);
+		std::strncpy(stat_header.name, name.c_str(), telemetry::STAT_NAME_SIZE - 1);
+
+		file.write(reinterpret_cast<const char *>(&stat_header), sizeof(stat_header));
+	}
+
+	// Enough space to write the whole queue at once
+	write_buffer.resize(records.get_capacity() * record_size);
+
+	timer.start();
+
+	writer_thread = std::thread([this] {
+		writer_worker(stop_writer->get_future());
+	});
+
+	LOGI("Recording telemetry of {} stats to {}", stats.size(), path);
+}
+
+TelemetryRecorder::~TelemetryRecorder()
+{
+	if (writer_thread.joinable())
+	{
+		stop_writer->set_value();
+
+		writer_thread.join();
+
+		LOGI("Telemetry: {} records written, {} dropped", get_written_record_count(), get_dropped_record_count());
+	}
+}
+
+void TelemetryRecorder::record(uint64_t frame_index, float delta_time, const std::array<float, STAT_INDEX_COUNT> &values)
+{
+	if (!writer_thread.joinable())
+	{
+		return;
+	}
+
+	Record record;
+	record.frame_index = frame_index;
+	record.timestamp   = static_cast<uint64_t>(timer.elapsed<Timer::Microseconds>());
+	record.delta_time  = delta_time;
+
+	for (size_t i = 0; i < stats.size(); ++i)
+	{
+		record.values[i] = values[static_cast<size_t>(stats[i])];
+	}
+
+	if (!records.push(record))
+	{
+		dropped_record_count.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+bool TelemetryRecorder::is_open() const
+{
+	return file.is_open();
+}
+
+uint32_t TelemetryRecorder::get_dropped_record_count() const
+{
+	return dropped_record_count.load(std::memory_order_relaxed);
+}
+
+uint64_t TelemetryRecorder::get_written_record_count() const
+{
+	return written_record_count.load(std::memory_order_relaxed);
+}
+
+void TelemetryRecorder::writer_worker(std::future<void> should_terminate)
+{
+	while (should_terminate.wait_for(WRITE_INTERVAL) != std::future_status::ready)
+	{
+		if (!drain())
+		{
+			LOGE("Failed to write telemetry log, recording stopped");
+			return;
+		}
+	}
+
+	// Records pushed before the recorder was destroyed
+	drain();
+
+	file.flush();
+}
+
+bool TelemetryRecorder::drain()
+{
+	size_t record_count = 0;
+
+	// The buffer fits the capacity of the queue, records pushed while draining are written next time
+	while (record_count < records.get_capacity() && records.pop(popped_record))
+	{
+		auto data = write_buffer.data() + record_count * record_size;
+
+		telemetry::TelemetryRecord record;
+		record.frame_index = popped_record.frame_index;
+		record.timestamp   = popped_record.timestamp;
+		record.delta_time  = popped_record.delta_time;
+
+		std::memcpy(data, &record, sizeof(record));
+		std::memcpy(data + sizeof(record), popped_record.values.data(), stats.size() * sizeof(float));
+
+		++record_count;
+	}
+
+	if (record_count == 0)
+	{
+		return true;
+	}
+
+	file.write(reinterpret_cast<const char *>(write_buffer.data()), record_count * record_size);
+
+	written_record_count.fetch_add(record_count, std::memory_order_relaxed);
+
+	return file.good();
+}
+}        // namespace vkb
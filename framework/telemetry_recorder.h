@@ -0,0 +1,144 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <future>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/spsc_queue.h"
+#include "stats.h"
+#include "timer.h"
+
+namespace vkb
+{
+/**
+ * @brief Appends the values of a set of stats to a binary log every frame
+ *
+ * Records are pushed to a queue allocated once at construction and written to the file by
+ * a background thread, so recording a frame neither allocates nor waits for the disk.
+ * If the writer falls behind and the queue is full, records are dropped and counted.
+ * The layout of the log is described in telemetry_format.h, and the telemetry_converter
+ * tool turns it into CSV or JSON.
+ */
+class TelemetryRecorder
+{
+  public:
+	/**
+	 * @brief Default number of records the queue can hold before the writer drains it
+	 */
+	static constexpr size_t RECORD_CAPACITY = 4096;
+
+	/**
+	 * @param path Path of the log, it is overwritten if it exists
+	 * @param stats Stats to be recorded
+	 * @param capacity Number of records the queue can hold
+	 */
+	TelemetryRecorder(const std::string &path, const std::set<StatIndex> &stats, size_t capacity = RECORD_CAPACITY);
+
+	TelemetryRecorder(const TelemetryRecorder &) = delete;
+
+	TelemetryRecorder(TelemetryRecorder &&) = delete;
+
+	/**
+	 * @brief Stops the writer thread once every queued record is written
+	 */
+	~TelemetryRecorder();
+
+	TelemetryRecorder &operator=(const TelemetryRecorder &) = delete;
+
+	TelemetryRecorder &operator=(TelemetryRecorder &&) = delete;
+
+	/**
+	 * @brief Queues a record, only called by one thread
+	 * @param frame_index Index of the frame the values belong to
+	 * @param delta_time Duration of the frame in seconds
+	 * @param values Value of each stat, indexed by StatIndex
+	 */
+	void record(uint64_t frame_index, float delta_time, const std::array<float, STAT_INDEX_COUNT> &values);
+
+	/**
+	 * @return Whether the log could be opened
+	 */
+	bool is_open() const;
+
+	/**
+	 * @return The number of records dropped because the queue was full
+	 */
+	uint32_t get_dropped_record_count() const;
+
+	/**
+	 * @return The number of records written to the log
+	 */
+	uint64_t get_written_record_count() const;
+
+  private:
+	struct Record
+	{
+		uint64_t frame_index{0};
+
+		uint64_t timestamp{0};
+
+		float delta_time{0.0f};
+
+		/// Values of the recorded stats, in the order of the header of the log
+		std::array<float, STAT_INDEX_COUNT> values{};
+	};
+
+	/// The writer thread function, it drains the queue at every interval until terminated
+	void writer_worker(std::future<void> should_terminate);
+
+	/// Writes the queued records, returns false if writing failed
+	bool drain();
+
+	std::vector<StatIndex> stats;
+
+	std::ofstream file;
+
+	/// Size of a record in the log
+	size_t record_size{0};
+
+	SpscQueue<Record> records;
+
+	/// Record exchanged with the slots of the queue by the writer thread
+	Record popped_record;
+
+	/// Records packed by the writer thread before being written in a single call
+	std::vector<uint8_t> write_buffer;
+
+	/// Time since the recorder was created
+	Timer timer;
+
+	std::thread writer_thread;
+
+	/// Promise to stop the writer thread
+	std::unique_ptr<std::promise<void>> stop_writer;
+
+	std::atomic<uint32_t> dropped_record_count{0};
+
+	std::atomic<uint64_t> written_record_count{0};
+};
+}        // namespace vkb
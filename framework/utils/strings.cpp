@@ -24,6 +24,7 @@
 
 #include "core/shader_module.h"
 #include "scene_graph/components/material.h"
+#include "stats.h"
 
 namespace vkb
 {
@@ -1328,5 +1329,58 @@ std::string to_string(ShaderResourceType type)
 	}
 }
 
+std::string to_string(StatIndex index)
+{
+	switch (index)
+	{
+		case StatIndex::frame_times:
+			return "frame_times";
+		case StatIndex::cpu_cycles:
+			return "cpu_cycles";
+		case StatIndex::cpu_instructions:
+			return "cpu_instructions";
+		case StatIndex::cache_miss_ratio:
+			return "cache_miss_ratio";
+		case StatIndex::branch_miss_ratio:
+			return "branch_miss_ratio";
+		case StatIndex::gpu_cycles:
+			return "gpu_cycles";
+		case StatIndex::vertex_compute_cycles:
+			return "vertex_compute_cycles";
+		case StatIndex::tiles:
+			return "tiles";
+		case StatIndex::fragment_jobs:
+			return "fragment_jobs";
+		case StatIndex::fragment_cycles:
+			return "fragment_cycles";
+		case StatIndex::l2_reads_lookups:
+			return "l2_reads_lookups";
+		case StatIndex::l2_ext_reads:
+			return "l2_ext_reads";
+		case StatIndex::l2_writes_lookups:
+			return "l2_writes_lookups";
+		case StatIndex::l2_ext_writes:
+			return "l2_ext_writes";
+		case StatIndex::l2_ext_read_stalls:
+			return "l2_ext_read_stalls";
+		case StatIndex::l2_ext_write_stalls:
+			return "l2_ext_write_stalls";
+		case StatIndex::l2_ext_read_bytes:
+			return "l2_ext_read_bytes";
+		case StatIndex::l2_ext_write_bytes:
+			return "l2_ext_write_bytes";
+		case StatIndex::tex_cycles:
+			return "tex_cycles";
+		case StatIndex::script_times:
+			return "script_times";
+		case StatIndex::attachment_load_bytes:
+			return "attachment_load_bytes";
+		case StatIndex::attachment_store_bytes:
+			return "attachment_store_bytes";
+		default:
+			return "unknown_stat";
+	}
+}
+
 }        // namespace utils
 }        // namespace vkb
@@ -28,6 +28,7 @@
 namespace vkb
 {
 enum class ShaderResourceType;
+enum class StatIndex;
 
 namespace sg
 {
@@ -90,6 +91,8 @@ extern std::string to_string(bool flag);
 
 extern std::string to_string(ShaderResourceType type);
 
+extern std::string to_string(StatIndex index);
+
 extern std::unordered_map<VkFormat, std::string> vk_format_strings;
 
 }        // namespace utils
@@ -20,6 +20,11 @@
 
 #include "vulkan_sample.h"
 
+#include <cctype>
+#include <thread>
+
+#include <ctpl_stl.h>
+
 #include "common/error.h"
 
 VKBP_DISABLE_WARNINGS()
@@ -30,12 +35,16 @@ VKBP_ENABLE_WARNINGS()
 #include "common/helpers.h"
 #include "common/logging.h"
 #include "common/vk_common.h"
+#include "core/null_driver.h"
 #include "gltf_loader.h"
+#include "platform/filesystem.h"
 #include "platform/platform.h"
 #include "platform/window.h"
+#include "rendering/subpasses/scene_subpass.h"
 #include "scene_graph/components/camera.h"
 #include "scene_graph/script.h"
 #include "scene_graph/scripts/free_camera.h"
+#include "timer.h"
 #include "utils/graphs.h"
 #include "utils/strings.h"
 
@@ -45,16 +54,42 @@ VKBP_ENABLE_WARNINGS()
 
 namespace vkb
 {
+namespace
+{
+/**
+ * @brief Name of the pipeline cache file of a sample, each sample has its own so that
+ *        running a sample does not replace the pipelines cached by another one
+ */
+std::string get_pipeline_cache_filename(const std::string &sample_name)
+{
+	std::string filename;
+
+	for (unsigned char ch : sample_name)
+	{
+		filename += std::isalnum(ch) ? static_cast<char>(std::tolower(ch)) : '_';
+	}
+
+	return (filename.empty() ? "sample" : filename) + ".pipeline_cache";
+}
+}        // namespace
+
 VulkanSample::VulkanSample()
 {
 }
 
 VulkanSample::~VulkanSample()
 {
+	wait_render_job();
+
 	device->wait_idle();
 
+	memory_defragmenter.reset();
+
+	overdraw_histogram.reset();
+
 	scene.reset();
 
+	telemetry_recorder.reset();
 	stats.reset();
 	gui.reset();
 	render_context.reset();
@@ -77,10 +112,19 @@ bool VulkanSample::prepare(Platform &platform)
 
 	LOGI("Initializing Vulkan sample");
 
+	if (uses_null_driver() && !is_headless())
+	{
+		LOGE("The null driver cannot present, it requires --headless");
+		return false;
+	}
+
 	// Creating the vulkan instance
 	std::vector<const char *> instance_extensions = get_instance_extensions();
-	instance_extensions.push_back(platform.get_surface_extension());
-	instance = std::make_unique<Instance>(get_name(), instance_extensions, get_validation_layers(), is_headless());
+	if (!uses_null_driver())
+	{
+		instance_extensions.push_back(platform.get_surface_extension());
+	}
+	instance = std::make_unique<Instance>(get_name(), instance_extensions, get_validation_layers(), is_headless(), uses_null_driver());
 
 	// Getting a valid vulkan surface from the platform
 	surface = platform.get_window().create_surface(instance->get_handle());
@@ -91,12 +135,17 @@ bool VulkanSample::prepare(Platform &platform)
 	{
 		device_extensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
 	}
-	device = std::make_unique<vkb::Device>(instance->get_gpu(), surface, device_extensions);
+	device = std::make_unique<vkb::Device>(instance->get_gpu(), surface, device_extensions, VkPhysicalDeviceFeatures{}, get_pipeline_cache_filename(get_name()));
 
 	// Preparing render context for rendering
 	render_context = std::make_unique<vkb::RenderContext>(*device, surface, platform.get_window().get_width(), platform.get_window().get_height());
 	prepare_render_context();
 
+	if (buffer_ring_size > 0)
+	{
+		render_context->set_buffer_ring_size(buffer_ring_size);
+	}
+
 	return true;
 }
 
@@ -109,16 +158,79 @@ void VulkanSample::update_scene(float delta_time)
 {
 	if (scene)
 	{
+		Timer timer;
+		timer.start();
+
 		//Update scripts
 		if (scene->has_component<sg::Script>())
 		{
-			auto scripts = scene->get_components<sg::Script>();
+			auto &scripts = scene->get_components<sg::Script>();
+
+			std::vector<sg::Script *> parallel_scripts;
+			std::vector<sg::Script *> serial_scripts;
 
 			for (auto script : scripts)
+			{
+				if (script->is_parallel_safe())
+				{
+					parallel_scripts.push_back(script);
+				}
+				else
+				{
+					serial_scripts.push_back(script);
+				}
+			}
+
+			auto thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+
+			if (parallel_scripts.size() < PARALLEL_SCRIPT_COUNT || thread_count == 1)
+			{
+				serial_scripts.insert(serial_scripts.begin(), parallel_scripts.begin(), parallel_scripts.end());
+			}
+			else
+			{
+				if (!script_thread_pool)
+				{
+					script_thread_pool = std::make_unique<ctpl::thread_pool>(static_cast<int>(thread_count));
+				}
+
+				size_t batch_size = (parallel_scripts.size() + thread_count - 1) / thread_count;
+
+				std::vector<std::future<void>> futures;
+
+				for (size_t begin = 0; begin < parallel_scripts.size(); begin += batch_size)
+				{
+					size_t end = std::min(begin + batch_size, parallel_scripts.size());
+
+					futures.push_back(script_thread_pool->push([&parallel_scripts, begin, end, delta_time](size_t) {
+						for (size_t i = begin; i < end; ++i)
+						{
+							parallel_scripts[i]->update(delta_time);
+						}
+					}));
+				}
+
+				for (auto &future : futures)
+				{
+					future.get();
+				}
+			}
+
+			for (auto script : serial_scripts)
 			{
 				script->update(delta_time);
 			}
 		}
+
+		// Scripts only change local transforms, propagate them down the hierarchy
+		scene->update_world_transforms();
+
+		script_update_time = static_cast<float>(timer.stop<Timer::Milliseconds>());
+
+		if (stats)
+		{
+			stats->add_value(StatIndex::script_times, script_update_time / 1000.0f);
+		}
 	}
 }
 
@@ -128,6 +240,16 @@ void VulkanSample::update_stats(float delta_time)
 	{
 		stats->update();
 
+		if (!telemetry_filename.empty())
+		{
+			if (!telemetry_recorder)
+			{
+				telemetry_recorder = std::make_unique<TelemetryRecorder>(fs::path::get(fs::path::Logs) + telemetry_filename, stats->get_enabled_stats());
+			}
+
+			telemetry_recorder->record(telemetry_frame_index++, delta_time, stats->get_latest_values());
+		}
+
 		static float stats_view_count = 0.0f;
 		stats_view_count += delta_time;
 
@@ -156,20 +278,131 @@ void VulkanSample::update_gui(float delta_time)
 		// Samples can override this
 		draw_gui();
 
+		if (overdraw_histogram)
+		{
+			const auto &histogram = overdraw_histogram->get_histogram();
+
+			std::vector<float> values(histogram.begin(), histogram.end());
+
+			gui->show_histogram_window("Overdraw", values, fmt::format("{:.2f} fragments per pixel", overdraw_histogram->get_average_overdraw()));
+		}
+
 		gui->update(delta_time);
 	}
 }
 
+void VulkanSample::defragment_memory()
+{
+	if (memory_defragmenter && scene && memory_defragmenter->update(*scene, *render_context))
+	{
+		// Descriptor sets cached by the frames may refer to buffers which have been recreated
+		for (auto &frame : render_context->get_render_frames())
+		{
+			frame.clear_descriptors();
+		}
+	}
+}
+
+void VulkanSample::prebuild_pipelines()
+{
+	if (pipelines_prebuilt || !render_pipeline)
+	{
+		return;
+	}
+
+	pipelines_prebuilt = true;
+
+	auto thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+
+	Timer timer;
+	timer.start();
+
+	std::vector<PipelineState> pipeline_states;
+
+	auto state = render_pipeline->collect_pipeline_states(*device, render_context->get_render_frames().at(0).get_render_target(), pipeline_states);
+
+	if (gui)
+	{
+		gui->collect_pipeline_states(state, pipeline_states);
+	}
+
+	auto pipeline_count = device->get_resource_cache().prebuild_graphics_pipelines(pipeline_states, thread_count);
+
+	LOGI("Prebuilt {} pipelines in {:.1f} ms across {} threads", pipeline_count, timer.stop<Timer::Milliseconds>(), thread_count);
+}
+
 void VulkanSample::update(float delta_time)
 {
+	prebuild_pipelines();
+
+	Timer timer;
+	timer.start();
+
+	// With frame pipelining the previous frame is being recorded while the scene is updated
 	update_scene(delta_time);
 
+	const sg::SceneSnapshot *snapshot = nullptr;
+
+	if (frame_pipelining && scene)
+	{
+		snapshot = &scene_snapshots[snapshot_index];
+		scene_snapshots[snapshot_index].capture(*scene);
+
+		snapshot_index = (snapshot_index + 1) % scene_snapshots.size();
+	}
+
+	simulation_time = static_cast<float>(timer.stop<Timer::Milliseconds>());
+
+	// The GUI, the stats and the resources are not shared with the render thread
+	wait_render_job();
+
+	if (uses_null_driver())
+	{
+		auto call_count             = null_driver::get_total_call_count();
+		null_driver_calls_per_frame = call_count - null_driver_call_count;
+		null_driver_call_count      = call_count;
+	}
+
+	if (stats && delta_time > 0.0f)
+	{
+		// Per second, to be comparable with the external memory counters
+		const auto &bandwidth = render_context->get_last_rendered_frame().get_attachment_bandwidth();
+		stats->add_value(StatIndex::attachment_load_bytes, bandwidth.load_bytes / delta_time);
+		stats->add_value(StatIndex::attachment_store_bytes, bandwidth.store_bytes / delta_time);
+	}
+
 	update_stats(delta_time);
 
 	update_gui(delta_time);
 
+	defragment_memory();
+
+	if (frame_pipelining)
+	{
+		if (!render_thread)
+		{
+			render_thread = std::make_unique<ctpl::thread_pool>(1);
+		}
+
+		render_job = render_thread->push([this, snapshot, delta_time](size_t) { render_frame(snapshot, delta_time); });
+	}
+	else
+	{
+		render_frame(nullptr, delta_time);
+	}
+}
+
+void VulkanSample::render_frame(const sg::SceneSnapshot *snapshot, float delta_time)
+{
+	Timer timer;
+	timer.start();
+
 	auto &command_buffer = render_context->begin();
 
+	render_context->get_active_frame().set_scene_snapshot(snapshot);
+
+	render_context->get_active_frame().set_pipeline_statistics_enabled(instrumentation);
+
 	command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
 
 	draw(command_buffer, render_context->get_active_frame().get_render_target());
@@ -177,10 +410,39 @@ void VulkanSample::update(float delta_time)
 	command_buffer.end();
 
 	render_context->submit(command_buffer);
+
+	device->get_pipeline_cache_manager().update(delta_time);
+
+	render_time = static_cast<float>(timer.stop<Timer::Milliseconds>());
+}
+
+void VulkanSample::wait_render_job()
+{
+	if (render_job.valid())
+	{
+		render_job.get();
+	}
 }
 
 void VulkanSample::draw(CommandBuffer &command_buffer, RenderTarget &render_target)
 {
+	if (instrumentation && render_pipeline)
+	{
+		if (!overdraw_histogram && !render_pipeline->get_subpasses().empty())
+		{
+			// The overdraw is rendered from the point of view of the scene subpass of the sample
+			if (auto scene_subpass = dynamic_cast<SceneSubpass *>(render_pipeline->get_subpasses().at(0).get()))
+			{
+				overdraw_histogram = std::make_unique<OverdrawHistogram>(*render_context, *scene, scene_subpass->get_camera());
+			}
+		}
+
+		if (overdraw_histogram)
+		{
+			overdraw_histogram->record(command_buffer);
+		}
+	}
+
 	auto &views = render_target.get_views();
 
 	{
@@ -260,6 +522,8 @@ void VulkanSample::render(CommandBuffer &command_buffer)
 
 void VulkanSample::resize(uint32_t width, uint32_t height)
 {
+	wait_render_job();
+
 	Application::resize(width, height);
 
 	if (gui)
@@ -269,7 +533,7 @@ void VulkanSample::resize(uint32_t width, uint32_t height)
 
 	if (scene->has_component<sg::Script>())
 	{
-		auto scripts = scene->get_components<sg::Script>();
+		auto &scripts = scene->get_components<sg::Script>();
 
 		for (auto script : scripts)
 		{
@@ -298,7 +562,7 @@ void VulkanSample::input_event(const InputEvent &input_event)
 	{
 		if (scene->has_component<sg::Script>())
 		{
-			auto scripts = scene->get_components<sg::Script>();
+			auto &scripts = scene->get_components<sg::Script>();
 
 			for (auto script : scripts)
 			{
@@ -312,11 +576,15 @@ void VulkanSample::input_event(const InputEvent &input_event)
 		const auto &key_event = static_cast<const KeyInputEvent &>(input_event);
 		if (key_event.get_action() == KeyAction::Down && key_event.get_code() == KeyCode::PrintScreen)
 		{
+			wait_render_job();
+
 			screenshot(*render_context, "screenshot-" + get_name());
 		}
 
 		if (key_event.get_code() == KeyCode::F6 && key_event.get_action() == KeyAction::Down)
 		{
+			wait_render_job();
+
 			utils::debug_graphs(get_render_context(), *scene.get());
 		}
 	}
@@ -325,7 +593,38 @@ void VulkanSample::input_event(const InputEvent &input_event)
 void VulkanSample::finish()
 {
 	Application::finish();
+	wait_render_job();
 	device->wait_idle();
+
+	// Writes the remaining records, so that the log is complete when the sample finishes
+	telemetry_recorder.reset();
+
+	if (uses_null_driver())
+	{
+		LOGI("Null driver: {} Vulkan calls, {} live objects", null_driver::get_total_call_count(), null_driver::get_live_object_count());
+	}
+
+	if (is_benchmark_mode())
+	{
+		const auto &bandwidth = render_context->get_last_rendered_frame().get_attachment_bandwidth();
+		LOGI("Estimated attachment traffic per frame: {} KiB loaded, {} KiB stored", bandwidth.load_bytes / 1024, bandwidth.store_bytes / 1024);
+
+		if (instrumentation)
+		{
+			for (auto &statistics : render_context->get_last_rendered_frame().get_pipeline_statistics())
+			{
+				LOGI("Render pass {} subpass {}: {} primitives, {} vertex invocations, {} clipping primitives, {} fragment invocations",
+				     statistics.render_pass_index, statistics.subpass_index,
+				     statistics.input_assembly_primitives, statistics.vertex_shader_invocations,
+				     statistics.clipping_primitives, statistics.fragment_shader_invocations);
+			}
+
+			if (overdraw_histogram)
+			{
+				LOGI("Average overdraw: {:.2f} fragments per pixel", overdraw_histogram->get_average_overdraw());
+			}
+		}
+	}
 }
 
 Device &VulkanSample::get_device()
@@ -355,10 +654,68 @@ void VulkanSample::update_debug_window()
 	                                                    utils::to_string(render_context->get_swapchain().get_format()) + " (" +
 	                                                        to_string(get_bits_per_pixel(render_context->get_swapchain().get_format())) + "bbp)");
 
+	get_debug_info().insert<field::Static, std::string>("buffer_memory",
+	                                                    to_string(render_context->get_buffer_memory_size() / 1024) + " KB" + (render_context->get_buffer_ring() ? " (ring)" : ""));
+
+	if (memory_defragmenter)
+	{
+		get_debug_info().insert<field::Static, std::string>("memory_fragmentation",
+		                                                    to_string(memory_defragmenter->get_fragmentation_ratio()) + " (" +
+		                                                        to_string(memory_defragmenter->get_total_bytes_moved() / 1024) + " KB moved)");
+	}
+
+	if (stats)
+	{
+		get_debug_info().insert<field::Static, std::string>("stats_sampling",
+		                                                    fmt::format("{:.1f} us ({} dropped)", stats->get_sampling_overhead(), stats->get_dropped_sample_count()));
+	}
+
+	get_debug_info().insert<field::Static, std::string>("gui_cpu_time", fmt::format("{:.2f} ms", gui->get_cpu_time()));
+
+	get_debug_info().insert<field::Static, std::string>("script_update_time", fmt::format("{:.2f} ms", script_update_time));
+
+	get_debug_info().insert<field::Static, std::string>("simulation_render_time", fmt::format("{:.2f} / {:.2f} ms{}", simulation_time, render_time, frame_pipelining ? " (pipelined)" : ""));
+
+	const auto &bandwidth = render_context->get_last_rendered_frame().get_attachment_bandwidth();
+	get_debug_info().insert<field::Static, std::string>("attachment_bandwidth",
+	                                                    fmt::format("{} / {} KiB per frame (estimated)", bandwidth.load_bytes / 1024, bandwidth.store_bytes / 1024));
+
+	for (auto &statistics : render_context->get_last_rendered_frame().get_pipeline_statistics())
+	{
+		const auto fragments_per_pixel = statistics.pixel_count > 0 ? static_cast<float>(statistics.fragment_shader_invocations) / statistics.pixel_count : 0.0f;
+
+		get_debug_info().insert<field::Static, std::string>(fmt::format("pipeline_statistics_{}_{}", statistics.render_pass_index, statistics.subpass_index),
+		                                                    fmt::format("{} prims, {} verts, {} clipped prims, {} frags ({:.2f} per pixel)",
+		                                                                statistics.input_assembly_primitives, statistics.vertex_shader_invocations,
+		                                                                statistics.clipping_primitives, statistics.fragment_shader_invocations, fragments_per_pixel));
+	}
+
+	if (uses_null_driver())
+	{
+		get_debug_info().insert<field::Static, std::string>("null_driver_calls",
+		                                                    fmt::format("{} per frame ({} live objects)", null_driver_calls_per_frame, null_driver::get_live_object_count()));
+	}
+
+	const auto &cache_state = device->get_resource_cache().get_internal_state();
+	get_debug_info().insert<field::Static, std::string>("shader_modules_pipelines",
+	                                                    fmt::format("{} / {}", cache_state.shader_modules.size(), cache_state.graphics_pipelines.size()));
+
+	get_debug_info().insert<field::Static, uint32_t>("on_demand_pipelines", device->get_resource_cache().get_on_demand_pipeline_count());
+
 	get_debug_info().insert<field::Static, uint32_t>("mesh_count", to_u32(scene->get_components<sg::SubMesh>().size()));
 
 	get_debug_info().insert<field::Static, uint32_t>("texture_count", to_u32(scene->get_components<sg::Texture>().size()));
 
+	get_debug_info().insert<field::Static, uint32_t>("image_count", to_u32(scene->get_components<sg::Image>().size()));
+
+	if (render_pipeline && !render_pipeline->get_subpasses().empty())
+	{
+		if (auto scene_subpass = dynamic_cast<SceneSubpass *>(render_pipeline->get_subpasses().at(0).get()))
+		{
+			get_debug_info().insert<field::Static, uint32_t>("texture_binding_changes", scene_subpass->get_texture_binding_changes());
+		}
+	}
+
 	if (auto camera = scene->get_components<vkb::sg::Camera>().at(0))
 	{
 		if (auto camera_node = camera->get_node())
@@ -403,6 +760,15 @@ void VulkanSample::load_scene(const std::string &path)
 {
 	GLTFLoader loader{*device};
 
+	if (astc_encoding)
+	{
+		loader.set_astc_encoding(astc_settings);
+	}
+
+	loader.set_texture_arrays(texture_arrays);
+
+	loader.set_gpu_mipmaps(gpu_mipmaps);
+
 	scene = loader.read_scene_from_file(path);
 
 	if (!scene)
@@ -427,6 +793,8 @@ void VulkanSample::set_render_pipeline(RenderPipeline &&rp)
 {
 	render_pipeline.reset();
 	render_pipeline = std::make_unique<RenderPipeline>(std::move(rp));
+
+	pipelines_prebuilt = false;
 }
 
 RenderPipeline &VulkanSample::get_render_pipeline()
@@ -450,6 +818,73 @@ std::vector<const char *> VulkanSample::get_device_extensions()
 	return {};
 }
 
+void VulkanSample::set_frame_pipelining(bool enabled)
+{
+	wait_render_job();
+
+	frame_pipelining = enabled;
+}
+
+bool VulkanSample::is_frame_pipelining() const
+{
+	return frame_pipelining;
+}
+
+void VulkanSample::set_telemetry(const std::string &filename)
+{
+	telemetry_recorder.reset();
+
+	telemetry_filename    = filename;
+	telemetry_frame_index = 0;
+}
+
+void VulkanSample::set_astc_encoding(bool enabled, const sg::AstcEncodeSettings &settings)
+{
+	astc_encoding = enabled;
+	astc_settings = settings;
+}
+
+void VulkanSample::set_texture_arrays(bool enabled)
+{
+	texture_arrays = enabled;
+}
+
+void VulkanSample::set_gpu_mipmaps(bool enabled)
+{
+	gpu_mipmaps = enabled;
+}
+
+void VulkanSample::set_buffer_ring_size(VkDeviceSize size)
+{
+	buffer_ring_size = size;
+
+	if (render_context)
+	{
+		wait_render_job();
+
+		render_context->set_buffer_ring_size(size);
+	}
+}
+
+void VulkanSample::set_instrumentation(bool enabled)
+{
+	wait_render_job();
+
+	if (!enabled && overdraw_histogram)
+	{
+		device->wait_idle();
+
+		overdraw_histogram.reset();
+	}
+
+	instrumentation = enabled;
+}
+
+bool VulkanSample::is_instrumentation() const
+{
+	return instrumentation;
+}
+
 sg::Scene &VulkanSample::get_scene()
 {
 	assert(scene && "Scene not loaded");
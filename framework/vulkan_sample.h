@@ -24,13 +24,23 @@
 #include "common/utils.h"
 #include "common/vk_common.h"
 #include "gui.h"
+#include "memory_defragmenter.h"
 #include "platform/application.h"
+#include "rendering/overdraw_histogram.h"
 #include "rendering/render_context.h"
 #include "rendering/render_pipeline.h"
+#include "scene_graph/components/image/astc.h"
 #include "scene_graph/node.h"
 #include "scene_graph/scene.h"
+#include "scene_graph/scene_snapshot.h"
 #include "scene_graph/scripts/node_animation.h"
 #include "stats.h"
+#include "telemetry_recorder.h"
+
+namespace ctpl
+{
+class thread_pool;
+}        // namespace ctpl
 
 namespace vkb
 {
@@ -146,6 +156,55 @@ class VulkanSample : public Application
 
 	sg::Scene &get_scene();
 
+	/**
+	 * @brief Enables frame pipelining: the scene of the next frame is updated on the main thread
+	 *        while the current frame is recorded and submitted on a render thread, which reads the
+	 *        scene state from a snapshot. Samples overriding render() must not read scene state
+	 *        other than through the snapshot of the active frame.
+	 */
+	void set_frame_pipelining(bool enabled);
+
+	bool is_frame_pipelining() const;
+
+	/**
+	 * @brief Enables the instrumentation mode: the subpasses of the render pipeline are wrapped
+	 *        in pipeline statistics queries, and the overdraw of the scene is rendered to an
+	 *        offscreen target and reduced to a histogram shown in the GUI.
+	 *        It adds work to every frame, so it should not be enabled while measuring performance.
+	 */
+	void set_instrumentation(bool enabled);
+
+	bool is_instrumentation() const;
+
+	/**
+	 * @brief Records the enabled stats of every frame to a binary log in the logs directory
+	 * @param filename Name of the log, empty to disable the recording
+	 */
+	void set_telemetry(const std::string &filename);
+
+	/**
+	 * @brief Encodes the PNG and JPG images of the scenes loaded afterwards to ASTC, see GLTFLoader::set_astc_encoding
+	 * @param enabled Whether images are encoded
+	 * @param settings Block dimensions and preset of the encoder
+	 */
+	void set_astc_encoding(bool enabled, const sg::AstcEncodeSettings &settings = {});
+
+	/**
+	 * @brief Packs the images of the scenes loaded afterwards into texture arrays, see GLTFLoader::set_texture_arrays
+	 */
+	void set_texture_arrays(bool enabled);
+
+	/**
+	 * @brief Generates the missing mipmaps of the scenes loaded afterwards on the GPU, see GLTFLoader::set_gpu_mipmaps
+	 */
+	void set_gpu_mipmaps(bool enabled);
+
+	/**
+	 * @brief Allocates the transient buffers of every frame from a single ring buffer, see RenderContext::set_buffer_ring_size
+	 * @param size Size of the ring in bytes, 0 to allocate from the buffer pools of each frame
+	 */
+	void set_buffer_ring_size(VkDeviceSize size);
+
   protected:
 	/**
 	 * @brief The Vulkan device
@@ -167,7 +226,13 @@ class VulkanSample : public Application
 	std::unique_ptr<Stats> stats{nullptr};
 
 	/**
-	 * @brief Update scene
+	 * @brief Compacts scene buffer memory when fragmented, samples opt in by creating it
+	 */
+	std::unique_ptr<MemoryDefragmenter> memory_defragmenter{nullptr};
+
+	/**
+	 * @brief Update scene, parallel-safe scripts are updated as jobs on worker threads
+	 *        and the other ones on the main thread, then world transforms are resolved
 	 * @param delta_time
 	 */
 	void update_scene(float delta_time);
@@ -184,6 +249,30 @@ class VulkanSample : public Application
 	 */
 	void update_gui(float delta_time);
 
+	/**
+	 * @brief Runs a step of the memory defragmenter if the sample created one,
+	 *        it must be called between frames
+	 */
+	void defragment_memory();
+
+	/**
+	 * @brief Creates the pipelines the render pipeline will need before the first frame,
+	 *        it does nothing if they have already been created
+	 */
+	void prebuild_pipelines();
+
+	/**
+	 * @brief Records the active frame and submits it
+	 * @param snapshot The scene state to be rendered, nullptr to read the scene directly
+	 * @param delta_time
+	 */
+	void render_frame(const sg::SceneSnapshot *snapshot, float delta_time);
+
+	/**
+	 * @brief Waits until the render thread has submitted the frame it is recording, if any
+	 */
+	void wait_render_job();
+
 	/**
 	 * @brief Prepares the render target and draws to it, calling draw_renderpass
 	 * @param command_buffer The command buffer to record the commands to
@@ -260,6 +349,80 @@ class VulkanSample : public Application
   private:
 	static constexpr float STATS_VIEW_RESET_TIME{10.0f};        // 10 seconds
 
+	/// Minimum number of parallel-safe scripts for their updates to be split across threads
+	static constexpr size_t PARALLEL_SCRIPT_COUNT{64};
+
+	/**
+	 * @brief Worker threads for the updates of parallel-safe scripts, created when first needed
+	 */
+	std::unique_ptr<ctpl::thread_pool> script_thread_pool{nullptr};
+
+	/**
+	 * @brief Time spent updating scripts and resolving transforms in the last frame in milliseconds
+	 */
+	float script_update_time{0.0f};
+
+	bool frame_pipelining{false};
+
+	/**
+	 * @brief Single thread recording and submitting frames when frame pipelining is enabled
+	 */
+	std::unique_ptr<ctpl::thread_pool> render_thread{nullptr};
+
+	/**
+	 * @brief Frame being recorded by the render thread
+	 */
+	std::future<void> render_job;
+
+	/**
+	 * @brief Snapshots of the scene used in turns, one is captured while the render thread reads the other
+	 */
+	std::array<sg::SceneSnapshot, 2> scene_snapshots;
+
+	/// Index of the snapshot to be captured next
+	size_t snapshot_index{0};
+
+	/**
+	 * @brief Time spent updating the scene of the last frame in milliseconds
+	 */
+	float simulation_time{0.0f};
+
+	/**
+	 * @brief Time spent recording and submitting the last frame in milliseconds
+	 */
+	float render_time{0.0f};
+
+	/**
+	 * @brief Number of Vulkan calls made by the last frame, counted by the null driver
+	 */
+	uint64_t null_driver_calls_per_frame{0};
+
+	uint64_t null_driver_call_count{0};
+
+	bool instrumentation{false};
+
+	/**
+	 * @brief Overdraw pass recorded before the render pipeline when instrumentation is enabled
+	 */
+	std::unique_ptr<OverdrawHistogram> overdraw_histogram{nullptr};
+
+	/// Name of the telemetry log, the recorder is created with the first stats update
+	std::string telemetry_filename;
+
+	std::unique_ptr<TelemetryRecorder> telemetry_recorder{nullptr};
+
+	uint64_t telemetry_frame_index{0};
+
+	bool astc_encoding{false};
+
+	sg::AstcEncodeSettings astc_settings;
+
+	bool texture_arrays{false};
+
+	bool gpu_mipmaps{false};
+
+	VkDeviceSize buffer_ring_size{0};
+
 	/**
 	 * @brief The Vulkan instance
 	 */
@@ -270,6 +433,11 @@ class VulkanSample : public Application
 	 */
 	VkSurfaceKHR surface{VK_NULL_HANDLE};
 
+	/**
+	 * @brief Whether the pipelines of the current render pipeline have been prebuilt
+	 */
+	bool pipelines_prebuilt{false};
+
 	/**
 	 * @brief Context used for rendering, it is responsible for managing the frames and their underlying images
 	 */
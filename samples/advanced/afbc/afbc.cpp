@@ -72,6 +72,9 @@ bool AFBCSample::prepare(vkb::Platform &platform)
 
 void AFBCSample::update(float delta_time)
 {
+	// The swapchain may be recreated, the render thread must not be using it
+	wait_render_job();
+
 	if (afbc_enabled != afbc_enabled_last_value)
 	{
 		std::set<VkImageUsageFlagBits> image_usage_flags = {VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT};
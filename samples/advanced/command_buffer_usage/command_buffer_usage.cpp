@@ -30,7 +30,10 @@
 #include "gui.h"
 #include "platform/filesystem.h"
 #include "platform/platform.h"
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
 #include "stats.h"
+#include "timer.h"
 
 CommandBufferUsage::CommandBufferUsage()
 {
@@ -103,6 +106,8 @@ void CommandBufferUsage::prepare_render_context()
 
 void CommandBufferUsage::update(float delta_time)
 {
+	prebuild_pipelines();
+
 	auto &subpass_state = static_cast<SceneSubpassSecondary *>(render_pipeline->get_active_subpass().get())->get_state();
 
 	// Process GUI input
@@ -134,12 +139,14 @@ void CommandBufferUsage::update(float delta_time)
 	primary_command_buffer.end();
 
 	render_context.submit(primary_command_buffer);
+
+	device->get_pipeline_cache_manager().update(delta_time);
 }
 
 void CommandBufferUsage::draw_gui()
 {
 	const bool landscape = camera->get_aspect_ratio() > 1.0f;
-	uint32_t   lines     = landscape ? 3 : 5;
+	uint32_t   lines     = landscape ? 4 : 6;
 
 	const auto &subpass = static_cast<SceneSubpassSecondary *>(render_pipeline->get_active_subpass().get());
 
@@ -168,10 +175,59 @@ void CommandBufferUsage::draw_gui()
 			    ImGui::SameLine();
 		    }
 		    ImGui::RadioButton("Reset pool", &gui_command_buffer_reset_mode, static_cast<int>(vkb::CommandBuffer::ResetMode::ResetPool));
+
+		    // Script updates of the mesh nodes run as parallel jobs
+		    if (ImGui::Checkbox("Animate meshes", &gui_animate_meshes))
+		    {
+			    set_meshes_animated(gui_animate_meshes);
+		    }
 	    },
 	    /* lines = */ lines);
 }
 
+void CommandBufferUsage::set_meshes_animated(bool animated)
+{
+	if (animated && mesh_animations.empty())
+	{
+		for (auto &node : scene->get_nodes())
+		{
+			if (node->has_component<vkb::sg::Mesh>() && !node->has_component<vkb::sg::Script>())
+			{
+				// The animation only modifies the transform it is given, so it can run as a parallel job
+				auto animation = std::make_unique<vkb::sg::NodeAnimation>(*node, TransformAnimFn{}, true);
+				mesh_animations.push_back(animation.get());
+				scene->add_component(std::move(animation), *node);
+			}
+		}
+	}
+
+	for (auto animation : mesh_animations)
+	{
+		if (animated)
+		{
+			animation->set_animation([](vkb::sg::Transform &transform, float delta_time) {
+				transform.set_rotation(glm::angleAxis(delta_time, glm::vec3(0.0f, 1.0f, 0.0f)) * transform.get_rotation());
+			});
+		}
+		else
+		{
+			animation->clear_animation();
+		}
+	}
+}
+
+void CommandBufferUsage::update_debug_window()
+{
+	VulkanSample::update_debug_window();
+
+	const auto &subpass = static_cast<SceneSubpassSecondary *>(render_pipeline->get_active_subpass().get());
+
+	get_debug_info().insert<vkb::field::Static, std::string>("cmd_buf_request", vkb::to_string(subpass->get_avg_request_time()) + " us");
+
+	// The GUI is updated before the next frame begins, so the count is the one of the previous frame
+	get_debug_info().insert<vkb::field::Static, uint32_t>("cmd_buf_allocations", get_render_context().get_last_rendered_frame().get_command_buffer_allocation_count());
+}
+
 void CommandBufferUsage::render(vkb::CommandBuffer &primary_command_buffer)
 {
 	if (render_pipeline)
@@ -267,8 +323,15 @@ vkb::CommandBuffer *CommandBufferUsage::SceneSubpassSecondary::record_draw_secon
 {
 	const auto &queue = render_context.get_device().get_queue_by_flags(VK_QUEUE_GRAPHICS_BIT, 0);
 
+	vkb::Timer timer;
+	timer.start();
+
 	auto &secondary_command_buffer = render_context.get_active_frame().request_command_buffer(queue, state.command_buffer_reset_mode, VK_COMMAND_BUFFER_LEVEL_SECONDARY, thread_index);
 
+	// Each thread only writes to its own slot
+	request_times[thread_index] += timer.stop<vkb::Timer::Microseconds>();
+	request_counts[thread_index]++;
+
 	secondary_command_buffer.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, &primary_command_buffer);
 
 	secondary_command_buffer.set_viewport(0, {viewport});
@@ -321,6 +384,9 @@ void CommandBufferUsage::SceneSubpassSecondary::draw(vkb::CommandBuffer &primary
 		thread_pool.resize(state.thread_count);
 	}
 
+	request_times.assign(std::max<size_t>(state.thread_count, 1), 0.0);
+	request_counts.assign(request_times.size(), 0);
+
 	if (use_secondary_command_buffers)
 	{
 		std::vector<std::future<vkb::CommandBuffer *>> secondary_cmd_buf_futures;
@@ -395,6 +461,9 @@ void CommandBufferUsage::SceneSubpassSecondary::draw(vkb::CommandBuffer &primary
 	{
 		primary_command_buffer.execute_commands(secondary_command_buffers);
 	}
+
+	auto total_request_count = std::accumulate(request_counts.begin(), request_counts.end(), 0U);
+	avg_request_time         = total_request_count > 0 ? std::accumulate(request_times.begin(), request_times.end(), 0.0) / total_request_count : 0.0;
 }
 
 void CommandBufferUsage::SceneSubpassSecondary::set_viewport(VkViewport &viewport)
@@ -412,6 +481,11 @@ float CommandBufferUsage::SceneSubpassSecondary::get_avg_draws_per_buffer() cons
 	return avg_draws_per_buffer;
 }
 
+double CommandBufferUsage::SceneSubpassSecondary::get_avg_request_time() const
+{
+	return avg_request_time;
+}
+
 CommandBufferUsage::SceneSubpassSecondaryState &CommandBufferUsage::SceneSubpassSecondary::get_state()
 {
 	return state;
@@ -28,6 +28,7 @@
 #include "scene_graph/components/material.h"
 #include "scene_graph/components/mesh.h"
 #include "scene_graph/components/perspective_camera.h"
+#include "scene_graph/scripts/node_animation.h"
 #include "vulkan_sample.h"
 
 /**
@@ -80,6 +81,11 @@ class CommandBufferUsage : public vkb::VulkanSample
 
 		float get_avg_draws_per_buffer() const;
 
+		/**
+		 * @return Average time spent requesting a secondary command buffer in the last frame, in microseconds
+		 */
+		double get_avg_request_time() const;
+
 		SceneSubpassSecondaryState &get_state();
 
 	  private:
@@ -120,6 +126,13 @@ class CommandBufferUsage : public vkb::VulkanSample
 
 		float avg_draws_per_buffer{0};
 
+		/// Time spent requesting command buffers by each thread in the current frame
+		std::vector<double> request_times;
+
+		std::vector<uint32_t> request_counts;
+
+		double avg_request_time{0};
+
 		ctpl::thread_pool thread_pool;
 	};
 
@@ -134,6 +147,13 @@ class CommandBufferUsage : public vkb::VulkanSample
 
 	void draw_gui() override;
 
+	void update_debug_window() override;
+
+	/**
+	 * @brief Spins every mesh node around its vertical axis, or stops them
+	 */
+	void set_meshes_animated(bool animated);
+
 	int gui_secondary_cmd_buf_count{0};
 
 	uint32_t max_secondary_command_buffer_count{100};
@@ -144,6 +164,11 @@ class CommandBufferUsage : public vkb::VulkanSample
 
 	bool gui_multi_threading{false};
 
+	bool gui_animate_meshes{false};
+
+	/// Added to the mesh nodes the first time they are animated, owned by the scene
+	std::vector<vkb::sg::NodeAnimation *> mesh_animations;
+
 	const uint32_t MIN_THREAD_COUNT{4};
 
 	uint32_t max_thread_count{0};
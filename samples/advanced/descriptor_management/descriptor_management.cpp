@@ -64,17 +64,24 @@ bool DescriptorManagement::prepare(vkb::Platform &platform)
 	stats = std::make_unique<vkb::Stats>(std::set<vkb::StatIndex>{vkb::StatIndex::frame_times});
 	gui   = std::make_unique<vkb::Gui>(*this, platform.get_window().get_dpi_factor());
 
+	// One VkBuffer per allocation creates and frees many small buffers, compact the scene buffers when memory fragments
+	memory_defragmenter = std::make_unique<vkb::MemoryDefragmenter>(get_device());
+
 	return true;
 }
 
 void DescriptorManagement::update(float delta_time)
 {
+	prebuild_pipelines();
+
 	update_scene(delta_time);
 
 	update_stats(delta_time);
 
 	update_gui(delta_time);
 
+	defragment_memory();
+
 	auto &render_context = get_render_context();
 
 	auto &command_buffer = render_context.begin();
@@ -99,6 +106,8 @@ void DescriptorManagement::update(float delta_time)
 	command_buffer.end();
 
 	render_context.submit(command_buffer);
+
+	device->get_pipeline_cache_manager().update(delta_time);
 }
 
 void DescriptorManagement::draw_gui()
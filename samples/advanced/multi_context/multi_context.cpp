@@ -0,0 +1,222 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "multi_context.h"
+
+#include <array>
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/device.h"
+#include "gltf_loader.h"
+#include "gui.h"
+#include "platform/filesystem.h"
+#include "platform/platform.h"
+#include "rendering/subpasses/scene_subpass.h"
+#include "scene_graph/components/perspective_camera.h"
+#include "scene_graph/components/transform.h"
+#include "scene_graph/node.h"
+#include "stats.h"
+
+#if defined(VK_USE_PLATFORM_ANDROID_KHR)
+#	include "platform/android/android_platform.h"
+#endif
+
+namespace
+{
+/// Size of the render targets of the offscreen views
+constexpr VkExtent2D VIEW_EXTENT{640, 360};
+
+/// Context counts compared by the sample, and swept in benchmark mode
+const std::array<int, 4> CONTEXT_COUNTS{{1, 2, 4, 8}};
+
+/// Frames rendered by each offscreen context per frame of the sample
+constexpr uint32_t FRAMES_PER_UPDATE{4};
+
+/// Frames of the sample measured for each context count in benchmark mode
+constexpr uint32_t SWEEP_UPDATES{120};
+}        // namespace
+
+MultiContext::MultiContext()
+{
+	auto &config = get_configuration();
+
+	for (size_t i = 0; i < CONTEXT_COUNTS.size(); ++i)
+	{
+		config.insert<vkb::IntSetting>(static_cast<uint32_t>(i), context_count, CONTEXT_COUNTS[i]);
+	}
+}
+
+bool MultiContext::prepare(vkb::Platform &platform)
+{
+	if (!VulkanSample::prepare(platform))
+	{
+		return false;
+	}
+
+	load_scene("scenes/sponza/Sponza01.gltf");
+	auto &camera_node = add_free_camera("main_camera");
+	camera            = &camera_node.get_component<vkb::sg::Camera>();
+
+	vkb::ShaderSource vert_shader(vkb::fs::read_shader("base.vert"));
+	vkb::ShaderSource frag_shader(vkb::fs::read_shader("base.frag"));
+	auto              scene_subpass = std::make_unique<vkb::SceneSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader), *scene, *camera);
+
+	auto render_pipeline = vkb::RenderPipeline();
+	render_pipeline.add_subpass(std::move(scene_subpass));
+
+	set_render_pipeline(std::move(render_pipeline));
+
+	// Every view draws the scene of the sample from its own camera
+	render_farm = std::make_unique<vkb::RenderFarm>(get_device(), VIEW_EXTENT);
+
+	for (int i = 0; i < CONTEXT_COUNTS.back(); ++i)
+	{
+		auto &view_camera = add_view_camera(static_cast<size_t>(i));
+
+		render_farm->add_view(*scene, [this, &view_camera](vkb::RenderContext &render_context) {
+			vkb::ShaderSource vert_shader(vkb::fs::read_shader("base.vert"));
+			vkb::ShaderSource frag_shader(vkb::fs::read_shader("base.frag"));
+
+			auto render_pipeline = vkb::RenderPipeline();
+			render_pipeline.add_subpass(std::make_unique<vkb::SceneSubpass>(render_context, std::move(vert_shader), std::move(frag_shader), *scene, view_camera));
+
+			return render_pipeline;
+		});
+	}
+
+	if (is_benchmark_mode())
+	{
+		context_count = CONTEXT_COUNTS[sweep_index];
+	}
+
+	stats = std::make_unique<vkb::Stats>(std::set<vkb::StatIndex>{vkb::StatIndex::frame_times});
+	gui   = std::make_unique<vkb::Gui>(*this, platform.get_window().get_dpi_factor());
+
+	return true;
+}
+
+vkb::sg::Camera &MultiContext::add_view_camera(size_t view_index)
+{
+	auto view_node = std::make_unique<vkb::sg::Node>("view_camera_" + std::to_string(view_index));
+
+	auto view_camera = std::make_unique<vkb::sg::PerspectiveCamera>(view_node->get_name());
+	view_camera->set_aspect_ratio(static_cast<float>(VIEW_EXTENT.width) / VIEW_EXTENT.height);
+	view_camera->set_field_of_view(1.0f);
+	view_camera->set_near_plane(0.1f);
+	view_camera->set_far_plane(1000.0f);
+
+	auto &camera_ref = *view_camera;
+
+	view_nodes.push_back(view_node.get());
+
+	view_camera->set_node(*view_node);
+	view_node->set_component(*view_camera);
+	scene->add_component(std::move(view_camera));
+
+	scene->add_child(*view_node);
+	scene->add_node(std::move(view_node));
+
+	return camera_ref;
+}
+
+void MultiContext::update(float delta_time)
+{
+	// View cameras stand where the main camera is, each turned by a different angle around it
+	auto camera_matrix = camera->get_node()->get_transform().get_world_matrix();
+
+	for (size_t i = 0; i < view_nodes.size(); ++i)
+	{
+		auto angle = glm::two_pi<float>() * i / view_nodes.size();
+
+		view_nodes[i]->get_transform().set_matrix(glm::rotate(camera_matrix, angle, glm::vec3(0.0f, 1.0f, 0.0f)));
+	}
+
+	VulkanSample::update(delta_time);
+
+	auto render_time = render_farm->render(context_count, FRAMES_PER_UPDATE);
+	auto frame_count = static_cast<uint32_t>(context_count) * FRAMES_PER_UPDATE;
+
+	measured_time += render_time;
+	measured_frames += frame_count;
+
+	// Refresh the aggregate rate twice per second, so that it can be read in the GUI
+	if (measured_time > 0.5)
+	{
+		aggregate_fps   = static_cast<float>(measured_frames / measured_time);
+		measured_frames = 0;
+		measured_time   = 0.0;
+	}
+
+	if (is_benchmark_mode() && sweep_index < CONTEXT_COUNTS.size())
+	{
+		sweep_time += render_time;
+		sweep_frames += frame_count;
+
+		if (++sweep_updates < SWEEP_UPDATES)
+		{
+			return;
+		}
+
+		sweep_results.push_back(static_cast<float>(sweep_frames / sweep_time));
+
+		sweep_frames  = 0;
+		sweep_time    = 0.0;
+		sweep_updates = 0;
+
+		if (++sweep_index < CONTEXT_COUNTS.size())
+		{
+			context_count = CONTEXT_COUNTS[sweep_index];
+		}
+	}
+}
+
+void MultiContext::finish()
+{
+	VulkanSample::finish();
+
+	for (size_t i = 0; i < sweep_results.size(); ++i)
+	{
+		LOGI("Offscreen contexts: {}, aggregate: {:.1f} fps, per context: {:.1f} fps",
+		     CONTEXT_COUNTS[i], sweep_results[i], sweep_results[i] / CONTEXT_COUNTS[i]);
+	}
+}
+
+void MultiContext::draw_gui()
+{
+	gui->show_options_window(
+	    /* body = */ [this]() {
+		    ImGui::Text("Offscreen contexts:");
+		    for (auto count : CONTEXT_COUNTS)
+		    {
+			    ImGui::SameLine();
+			    ImGui::RadioButton(std::to_string(count).c_str(), &context_count, count);
+		    }
+
+		    ImGui::Text("Aggregate: %.1f fps, per context: %.1f fps", aggregate_fps, aggregate_fps / context_count);
+	    },
+	    /* lines = */ 2);
+}
+
+std::unique_ptr<vkb::VulkanSample> create_multi_context()
+{
+	return std::make_unique<MultiContext>();
+}
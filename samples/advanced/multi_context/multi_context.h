@@ -0,0 +1,83 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "common/utils.h"
+#include "rendering/render_farm.h"
+#include "rendering/render_pipeline.h"
+#include "scene_graph/components/camera.h"
+#include "vulkan_sample.h"
+
+/**
+ * @brief Rendering many independent offscreen views concurrently on one device
+ */
+class MultiContext : public vkb::VulkanSample
+{
+  public:
+	MultiContext();
+
+	virtual ~MultiContext() = default;
+
+	virtual bool prepare(vkb::Platform &platform) override;
+
+	virtual void update(float delta_time) override;
+
+	virtual void finish() override;
+
+  private:
+	vkb::sg::Camera *camera{nullptr};
+
+	/// Nodes of the cameras of the offscreen views
+	std::vector<vkb::sg::Node *> view_nodes;
+
+	std::unique_ptr<vkb::RenderFarm> render_farm;
+
+	int context_count{1};
+
+	/// Offscreen frames rendered and time spent since the aggregate rate was last computed
+	uint32_t measured_frames{0};
+
+	double measured_time{0.0};
+
+	float aggregate_fps{0.0f};
+
+	/// Index of the context count being measured in benchmark mode
+	size_t sweep_index{0};
+
+	uint32_t sweep_updates{0};
+
+	/// Offscreen frames rendered and time spent with the context count being measured
+	uint32_t sweep_frames{0};
+
+	double sweep_time{0.0};
+
+	/// Aggregate frames per second of each context count in benchmark mode
+	std::vector<float> sweep_results;
+
+	/**
+	 * @brief Adds a camera looking in another direction than the main one for each offscreen view
+	 */
+	vkb::sg::Camera &add_view_camera(size_t view_index);
+
+	virtual void draw_gui() override;
+};
+
+std::unique_ptr<vkb::VulkanSample> create_multi_context();
@@ -41,23 +41,7 @@ PipelineCache::PipelineCache()
 
 PipelineCache::~PipelineCache()
 {
-	if (pipeline_cache != VK_NULL_HANDLE)
-	{
-		/* Get size of pipeline cache */
-		size_t size{};
-		VK_CHECK(vkGetPipelineCacheData(device->get_handle(), pipeline_cache, &size, nullptr));
-
-		/* Get data of pipeline cache */
-		std::vector<uint8_t> data(size);
-		VK_CHECK(vkGetPipelineCacheData(device->get_handle(), pipeline_cache, &size, data.data()));
-
-		/* Write pipeline cache data to a file in binary format */
-		vkb::fs::write_temp(data, "pipeline_cache.data");
-
-		/* Destroy Vulkan pipeline cache */
-		vkDestroyPipelineCache(device->get_handle(), pipeline_cache, nullptr);
-	}
-
+	/* The pipeline cache is saved by the device */
 	vkb::fs::write_temp(device->get_resource_cache().serialize(), "cache.data");
 }
 
@@ -68,25 +52,8 @@ bool PipelineCache::prepare(vkb::Platform &platform)
 		return false;
 	}
 
-	/* Try to read pipeline cache file if exists */
-	std::vector<uint8_t> pipeline_data;
-
-	try
-	{
-		pipeline_data = vkb::fs::read_temp("pipeline_cache.data");
-	}
-	catch (std::runtime_error &ex)
-	{
-		LOGW("No pipeline cache found. {}", ex.what());
-	}
-
-	/* Add initial pipeline cache data from the cached file */
-	VkPipelineCacheCreateInfo create_info{VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
-	create_info.initialDataSize = pipeline_data.size();
-	create_info.pInitialData    = pipeline_data.data();
-
-	/* Create Vulkan pipeline cache */
-	VK_CHECK(vkCreatePipelineCache(device->get_handle(), &create_info, nullptr, &pipeline_cache));
+	/* The device loads the pipeline cache file if it exists and is valid */
+	pipeline_cache = device->get_pipeline_cache_manager().get_handle();
 
 	vkb::ResourceCache &resource_cache = device->get_resource_cache();
 
@@ -122,10 +89,11 @@ bool PipelineCache::prepare(vkb::Platform &platform)
 
 	vkb::ShaderSource vert_shader(vkb::fs::read_shader("base.vert"));
 	vkb::ShaderSource frag_shader(vkb::fs::read_shader("base.frag"));
-	auto              scene_subpass = std::make_unique<vkb::SceneSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader), *scene, *camera);
+	auto              subpass = std::make_unique<vkb::SceneSubpass>(get_render_context(), std::move(vert_shader), std::move(frag_shader), *scene, *camera);
+	scene_subpass             = subpass.get();
 
 	auto render_pipeline = vkb::RenderPipeline();
-	render_pipeline.add_subpass(std::move(scene_subpass));
+	render_pipeline.add_subpass(std::move(subpass));
 
 	set_render_pipeline(std::move(render_pipeline));
 
@@ -161,6 +129,29 @@ void PipelineCache::draw_gui()
 			    record_frame_time_next_frame = true;
 		    }
 
+		    if (ImGui::Checkbox("Specialization constants", &enable_specialization_constants))
+		    {
+			    // Pipelines of the previous mode are not used anymore, rebuild them to compare the costs
+			    device->wait_idle();
+			    scene_subpass->set_specialization_constants_enabled(enable_specialization_constants);
+			    enable_specialization_constants = scene_subpass->is_specialization_constants_enabled();
+			    device->get_resource_cache().clear_pipelines();
+			    record_frame_time_next_frame = true;
+		    }
+
+		    ImGui::SameLine();
+
+		    if (ImGui::Checkbox("Bindless textures", &enable_bindless_textures))
+		    {
+			    device->wait_idle();
+			    scene_subpass->set_bindless_textures_enabled(enable_bindless_textures);
+			    enable_bindless_textures = scene_subpass->is_bindless_textures_enabled();
+			    device->get_resource_cache().clear_pipelines();
+			    record_frame_time_next_frame = true;
+		    }
+
+		    ImGui::Text("Shader compile time: %.1f ms", scene_subpass->get_shader_compile_time());
+
 		    if (rebuild_pipelines_frame_time_ms > 0.0f)
 		    {
 			    ImGui::Text("Pipeline rebuild frame time: %.1f ms", rebuild_pipelines_frame_time_ms);
@@ -170,7 +161,7 @@ void PipelineCache::draw_gui()
 			    ImGui::Text("Pipeline rebuild frame time: N/A");
 		    }
 	    },
-	    /* lines = */ 2);
+	    /* lines = */ 4);
 }
 
 void PipelineCache::update(float delta_time)
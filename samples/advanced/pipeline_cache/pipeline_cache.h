@@ -23,6 +23,7 @@
 #include "common/utils.h"
 #include "common/vk_common.h"
 #include "rendering/render_pipeline.h"
+#include "rendering/subpasses/scene_subpass.h"
 #include "scene_graph/components/camera.h"
 #include "vulkan_sample.h"
 
@@ -43,12 +44,20 @@ class PipelineCache : public vkb::VulkanSample
   private:
 	vkb::sg::Camera *camera{nullptr};
 
+	/// Owned by the render pipeline
+	vkb::SceneSubpass *scene_subpass{nullptr};
+
+	/// Owned by the device
 	VkPipelineCache pipeline_cache{VK_NULL_HANDLE};
 
 	ImVec2 button_size{150, 30};
 
 	bool enable_pipeline_cache{true};
 
+	bool enable_specialization_constants{false};
+
+	bool enable_bindless_textures{false};
+
 	bool record_frame_time_next_frame{false};
 
 	float rebuild_pipelines_frame_time_ms{0.0f};
@@ -50,11 +50,13 @@ void RenderPassesSample::reset_stats_view()
 	if (load.value == VK_ATTACHMENT_LOAD_OP_LOAD)
 	{
 		gui->get_stats_view().reset_max_value(vkb::StatIndex::l2_ext_read_bytes);
+		gui->get_stats_view().reset_max_value(vkb::StatIndex::attachment_load_bytes);
 	}
 
 	if (store.value == VK_ATTACHMENT_STORE_OP_STORE)
 	{
 		gui->get_stats_view().reset_max_value(vkb::StatIndex::l2_ext_write_bytes);
+		gui->get_stats_view().reset_max_value(vkb::StatIndex::attachment_store_bytes);
 	}
 }
 
@@ -114,7 +116,9 @@ bool RenderPassesSample::prepare(vkb::Platform &platform)
 
 	auto enabled_stats = {vkb::StatIndex::fragment_cycles,
 	                      vkb::StatIndex::l2_ext_read_bytes,
-	                      vkb::StatIndex::l2_ext_write_bytes};
+	                      vkb::StatIndex::l2_ext_write_bytes,
+	                      vkb::StatIndex::attachment_load_bytes,
+	                      vkb::StatIndex::attachment_store_bytes};
 
 	stats = std::make_unique<vkb::Stats>(enabled_stats);
 
@@ -131,7 +131,9 @@ bool RenderSubpasses::prepare(vkb::Platform &platform)
 	auto enabled_stats = {vkb::StatIndex::fragment_jobs,
 	                      vkb::StatIndex::tiles,
 	                      vkb::StatIndex::l2_ext_read_bytes,
-	                      vkb::StatIndex::l2_ext_write_bytes};
+	                      vkb::StatIndex::l2_ext_write_bytes,
+	                      vkb::StatIndex::attachment_load_bytes,
+	                      vkb::StatIndex::attachment_store_bytes};
 	stats              = std::make_unique<vkb::Stats>(enabled_stats);
 
 	return true;
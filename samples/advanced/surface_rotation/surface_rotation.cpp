@@ -80,6 +80,9 @@ bool SurfaceRotation::prepare(vkb::Platform &platform)
 
 void SurfaceRotation::update(float delta_time)
 {
+	// The swapchain may be recreated, the render thread must not be using it
+	wait_render_job();
+
 	handle_no_resize_rotations();
 
 	// Process GUI input
@@ -72,6 +72,9 @@ bool SwapchainImages::prepare(vkb::Platform &platform)
 
 void SwapchainImages::update(float delta_time)
 {
+	// The swapchain may be recreated, the render thread must not be using it
+	wait_render_job();
+
 	// Process GUI input
 	if (swapchain_image_count != last_swapchain_image_count)
 	{
@@ -21,8 +21,29 @@
 
 precision highp float;
 
-#ifdef HAS_BASE_COLOR_TEXTURE
-layout (set=0, binding=0) uniform sampler2D base_color_texture;
+#ifdef SPECIALIZATION_CONSTANTS
+// Textures are enabled per material when the pipeline is created
+layout (constant_id = 0) const bool has_base_color_texture = false;
+#elif defined(HAS_BASE_COLOR_TEXTURE)
+const bool has_base_color_texture = true;
+#else
+const bool has_base_color_texture = false;
+#endif
+
+#ifdef TEXTURE_ARRAYS
+// Textures of the same format and size are layers of a single image, materials select theirs by layer
+#define MATERIAL_SAMPLER sampler2DArray
+#define BASE_COLOR_UV vec3(in_uv, float(pbr_material_uniform.base_color_texture_layer))
+#else
+#define MATERIAL_SAMPLER sampler2D
+#define BASE_COLOR_UV in_uv
+#endif
+
+#if defined(BINDLESS_TEXTURES)
+// Every texture of the scene, materials select theirs by index
+layout (set=1, binding=0) uniform MATERIAL_SAMPLER bindless_textures[BINDLESS_TEXTURE_COUNT];
+#elif defined(HAS_BASE_COLOR_TEXTURE) || defined(SPECIALIZATION_CONSTANTS)
+layout (set=0, binding=0) uniform MATERIAL_SAMPLER base_color_texture;
 #endif
 
 layout (location = 0) in vec4 in_pos;
@@ -45,6 +66,8 @@ layout(push_constant, std430) uniform PBRMaterialUniform {
     vec4 base_color_factor;
     float metallic_factor;
     float roughness_factor;
+    int base_color_texture_index;
+    int base_color_texture_layer;
 } pbr_material_uniform;
 
 void main(void)
@@ -63,11 +86,22 @@ void main(void)
 
     vec4 base_color = vec4(1.0, 0.0, 0.0, 1.0);
 
-#ifdef HAS_BASE_COLOR_TEXTURE
-    base_color = texture(base_color_texture, in_uv);
-#else
-    base_color = pbr_material_uniform.base_color_factor;    
+#if defined(BINDLESS_TEXTURES)
+    if (pbr_material_uniform.base_color_texture_index >= 0)
+    {
+        base_color = texture(bindless_textures[pbr_material_uniform.base_color_texture_index], BASE_COLOR_UV);
+    }
+    else
+#elif defined(HAS_BASE_COLOR_TEXTURE) || defined(SPECIALIZATION_CONSTANTS)
+    if (has_base_color_texture)
+    {
+        base_color = texture(base_color_texture, BASE_COLOR_UV);
+    }
+    else
 #endif
+    {
+        base_color = pbr_material_uniform.base_color_factor;
+    }
 
     vec4 ambient_color = vec4(0.2, 0.2, 0.2, 1.0) * base_color;
 
@@ -23,6 +23,18 @@ layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 texcoord_0;
 layout(location = 2) in vec3 normal;
 
+// Skinned vertices are deformed here, unless the compute skinning already did it
+#if defined(HAS_JOINTS_0) && defined(HAS_WEIGHTS_0) && !defined(COMPUTE_SKINNING)
+#define VERTEX_SKINNING
+
+layout(location = 3) in uvec4 joints_0;
+layout(location = 4) in vec4 weights_0;
+
+layout(set = 0, binding = 2) readonly buffer JointMatrices {
+    mat4 joint_matrices[];
+};
+#endif
+
 layout(set = 0, binding = 1) uniform GlobalUniform {
     mat4 model;
     mat4 view_proj;
@@ -36,11 +48,20 @@ layout (location = 2) out vec3 o_normal;
 
 void main(void)
 {
-    o_pos = global_uniform.model * vec4(position, 1.0);
+    mat4 model = global_uniform.model;
+
+#ifdef VERTEX_SKINNING
+    model = model * (weights_0.x * joint_matrices[joints_0.x] +
+                     weights_0.y * joint_matrices[joints_0.y] +
+                     weights_0.z * joint_matrices[joints_0.z] +
+                     weights_0.w * joint_matrices[joints_0.w]);
+#endif
+
+    o_pos = model * vec4(position, 1.0);
 
     o_uv = texcoord_0;
 
-    o_normal = mat3(global_uniform.model) * normal;
+    o_normal = mat3(model) * normal;
 
     gl_Position = global_uniform.view_proj * o_pos;
 }
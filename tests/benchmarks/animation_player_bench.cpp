@@ -0,0 +1,140 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/error.h"
+
+VKBP_DISABLE_WARNINGS()
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+VKBP_ENABLE_WARNINGS()
+
+#include "common/logging.h"
+#include "scene_graph/components/animation.h"
+#include "scene_graph/node.h"
+#include "scene_graph/scripts/animation_player.h"
+#include "timer.h"
+
+namespace
+{
+constexpr size_t FRAME_COUNT = 1000;
+
+constexpr size_t KEY_COUNT = 16;
+
+constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+// Below and above AnimationPlayer::PARALLEL_CHANNEL_COUNT, each node has three channels
+const std::array<size_t, 4> NODE_COUNTS = {100, 1000, 5000, 20000};
+
+/**
+ * @brief Adds a sampler with keys spread over two seconds, offset per node so that channels do not share values
+ */
+uint32_t add_sampler(vkb::sg::Animation &animation, vkb::sg::AnimationTarget target, size_t node_index)
+{
+	std::vector<float>     times(KEY_COUNT);
+	std::vector<glm::vec4> values(KEY_COUNT);
+
+	for (size_t key = 0; key < KEY_COUNT; ++key)
+	{
+		times[key] = 2.0f * static_cast<float>(key) / static_cast<float>(KEY_COUNT - 1);
+
+		float phase = static_cast<float>(key + node_index);
+
+		switch (target)
+		{
+			case vkb::sg::AnimationTarget::Rotation:
+			{
+				auto rotation = glm::angleAxis(phase * 0.1f, glm::vec3(0.0f, 1.0f, 0.0f));
+				values[key]   = glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w);
+				break;
+			}
+			case vkb::sg::AnimationTarget::Scale:
+				values[key] = glm::vec4(1.0f + 0.01f * phase, 1.0f, 1.0f, 0.0f);
+				break;
+			default:
+				values[key] = glm::vec4(phase, 0.0f, -phase, 0.0f);
+				break;
+		}
+	}
+
+	return animation.add_sampler(vkb::sg::AnimationInterpolation::Linear, times, values);
+}
+
+void run(size_t node_count)
+{
+	std::vector<std::unique_ptr<vkb::sg::Node>> nodes;
+
+	vkb::sg::Animation animation{"animation"};
+
+	for (size_t i = 0; i < node_count; ++i)
+	{
+		nodes.push_back(std::make_unique<vkb::sg::Node>("node_" + std::to_string(i)));
+
+		auto &transform = nodes.back()->get_transform();
+
+		for (auto target : {vkb::sg::AnimationTarget::Translation, vkb::sg::AnimationTarget::Rotation, vkb::sg::AnimationTarget::Scale})
+		{
+			animation.add_channel(transform, target, add_sampler(animation, target, i));
+		}
+	}
+
+	vkb::sg::Node            player_node{"animation_player"};
+	vkb::sg::AnimationPlayer player{player_node};
+
+	player.play(animation);
+
+	// The first update sizes the buffers of the player and warms up its threads
+	player.update(FRAME_TIME);
+
+	double total_time = 0.0;
+
+	for (size_t frame = 0; frame < FRAME_COUNT; ++frame)
+	{
+		player.update(FRAME_TIME);
+		total_time += player.get_update_time();
+	}
+
+	double average_time = total_time / static_cast<double>(FRAME_COUNT);
+
+	LOGI("{:>6} nodes, {:>6} channels: {:.3f} ms per update, {:.1f} ns per channel",
+	     node_count, player.get_channel_count(), average_time, average_time * 1.0e6 / static_cast<double>(player.get_channel_count()));
+}
+}        // namespace
+
+/**
+ * @brief Plays one clip animating the translation, rotation and scale of thousands of nodes,
+ *        and logs the average cost of AnimationPlayer::update for each node count.
+ *        Counts below AnimationPlayer::PARALLEL_CHANNEL_COUNT channels run on the calling thread.
+ */
+int main()
+{
+	LOGI("{} frames of {:.1f} ms, {} linear keys per channel", FRAME_COUNT, FRAME_TIME * 1000.0f, KEY_COUNT);
+
+	for (auto node_count : NODE_COUNTS)
+	{
+		run(node_count);
+	}
+
+	return 0;
+}
@@ -0,0 +1,235 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <array>
+#include <map>
+#include <vector>
+
+#include "buffer_pool.h"
+#include "buffer_ring.h"
+#include "common/logging.h"
+#include "core/device.h"
+#include "core/instance.h"
+#include "rendering/render_frame.h"
+#include "timer.h"
+
+namespace
+{
+constexpr size_t FRAME_COUNT = 2000;
+
+constexpr size_t FRAMES_IN_FLIGHT = 3;
+
+constexpr size_t THREAD_COUNT = 4;
+
+struct Workload
+{
+	VkBufferUsageFlags usage;
+
+	VkDeviceSize size;
+
+	/// Number of allocations per thread and frame
+	size_t count;
+};
+
+// Per-draw uniforms, GUI geometry and a few storage buffers, roughly what a scene subpass and the GUI record
+const std::vector<Workload> WORKLOADS = {
+    {VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 192, 400},
+    {VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, 4096, 16},
+    {VK_BUFFER_USAGE_INDEX_BUFFER_BIT, 1024, 16},
+    {VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, 8192, 4}};
+
+struct Result
+{
+	double milliseconds{0.0};
+
+	VkDeviceSize memory_size{0};
+};
+
+template <typename AllocateFunc>
+void record_frame(AllocateFunc allocate, const std::vector<uint8_t> &data)
+{
+	for (size_t thread_index = 0; thread_index < THREAD_COUNT; ++thread_index)
+	{
+		for (auto &workload : WORKLOADS)
+		{
+			for (size_t i = 0; i < workload.count; ++i)
+			{
+				auto allocation = allocate(workload.usage, workload.size, thread_index);
+				allocation.update(std::vector<uint8_t>{data.begin(), data.begin() + workload.size});
+			}
+		}
+	}
+}
+
+Result run_buffer_pools(vkb::Device &device, const std::vector<uint8_t> &data)
+{
+	using ThreadPools = std::vector<std::pair<vkb::BufferPool, vkb::BufferBlock *>>;
+
+	std::array<std::map<VkBufferUsageFlags, ThreadPools>, FRAMES_IN_FLIGHT> frames;
+
+	for (auto &frame : frames)
+	{
+		for (auto &workload : WORKLOADS)
+		{
+			auto &pools = frame[workload.usage];
+			for (size_t i = 0; i < THREAD_COUNT; ++i)
+			{
+				pools.push_back(std::make_pair(vkb::BufferPool{device, vkb::RenderFrame::BUFFER_POOL_BLOCK_SIZE * 1024, workload.usage}, nullptr));
+			}
+		}
+	}
+
+	vkb::Timer timer;
+	timer.start();
+
+	for (size_t frame_index = 0; frame_index < FRAME_COUNT; ++frame_index)
+	{
+		auto &frame = frames[frame_index % FRAMES_IN_FLIGHT];
+
+		for (auto &pools : frame)
+		{
+			for (auto &pool : pools.second)
+			{
+				pool.first.reset();
+				pool.second = nullptr;
+			}
+		}
+
+		record_frame([&frame](VkBufferUsageFlags usage, VkDeviceSize size, size_t thread_index) {
+			auto &pool  = frame[usage][thread_index].first;
+			auto &block = frame[usage][thread_index].second;
+
+			if (!block)
+			{
+				block = &pool.request_buffer_block(size);
+			}
+
+			auto allocation = block->allocate(vkb::to_u32(size));
+			if (allocation.empty())
+			{
+				block      = &pool.request_buffer_block(size);
+				allocation = block->allocate(vkb::to_u32(size));
+			}
+
+			return allocation;
+		},
+		             data);
+	}
+
+	Result result;
+	result.milliseconds = timer.stop<vkb::Timer::Milliseconds>();
+
+	for (auto &frame : frames)
+	{
+		for (auto &pools : frame)
+		{
+			for (auto &pool : pools.second)
+			{
+				result.memory_size += pool.first.get_memory_size();
+			}
+		}
+	}
+
+	return result;
+}
+
+Result run_buffer_ring(vkb::Device &device, const std::vector<uint8_t> &data)
+{
+	// Sized for the frames in flight plus one partially used chunk per thread and frame
+	VkDeviceSize frame_size = 0;
+	for (auto &workload : WORKLOADS)
+	{
+		frame_size += workload.size * workload.count * THREAD_COUNT;
+	}
+
+	VkDeviceSize ring_size = FRAMES_IN_FLIGHT * (frame_size + THREAD_COUNT * vkb::BufferRing::CHUNK_SIZE * 1024);
+
+	vkb::BufferRing ring{device, ring_size, THREAD_COUNT};
+
+	std::array<VkDeviceSize, FRAMES_IN_FLIGHT> markers{};
+
+	size_t failed_allocations = 0;
+
+	vkb::Timer timer;
+	timer.start();
+
+	for (size_t frame_index = 0; frame_index < FRAME_COUNT; ++frame_index)
+	{
+		auto &marker = markers[frame_index % FRAMES_IN_FLIGHT];
+
+		ring.retire(marker);
+
+		record_frame([&ring, &failed_allocations](VkBufferUsageFlags usage, VkDeviceSize size, size_t thread_index) {
+			auto allocation = ring.allocate(usage, size, thread_index);
+			if (allocation.empty())
+			{
+				++failed_allocations;
+			}
+			return allocation;
+		},
+		             data);
+
+		marker = ring.end_frame();
+	}
+
+	Result result;
+	result.milliseconds = timer.stop<vkb::Timer::Milliseconds>();
+	result.memory_size  = ring.get_size();
+
+	if (failed_allocations > 0)
+	{
+		LOGE("The buffer ring was full for {} allocations", failed_allocations);
+	}
+
+	LOGI("Buffer ring peak usage: {} KB", ring.get_peak_used_size() / 1024);
+
+	return result;
+}
+}        // namespace
+
+/**
+ * @brief Compares the per-frame buffer pools of RenderFrame with a BufferRing shared by all frames,
+ *        recording the same transient allocations and writes for a fixed number of frames.
+ *        Both allocators are driven the way RenderFrame drives them, with every frame slot
+ *        retired when it is reused, as if its fence had been signaled.
+ */
+int main()
+{
+	vkb::Instance instance{"buffer_ring_bench", {}, {}, true};
+	vkb::Device   device{instance.get_gpu(), VK_NULL_HANDLE};
+
+	std::vector<uint8_t> data(8192, 0xAB);
+
+	auto pools = run_buffer_pools(device, data);
+	auto ring  = run_buffer_ring(device, data);
+
+	size_t allocation_count = 0;
+	for (auto &workload : WORKLOADS)
+	{
+		allocation_count += workload.count * THREAD_COUNT * FRAME_COUNT;
+	}
+
+	LOGI("{} frames, {} frames in flight, {} threads, {} allocations", FRAME_COUNT, FRAMES_IN_FLIGHT, THREAD_COUNT, allocation_count);
+	LOGI("Buffer pools: {} KB, {:.2f} ms, {:.1f} M allocations/s", pools.memory_size / 1024, pools.milliseconds, static_cast<double>(allocation_count) / pools.milliseconds / 1000.0);
+	LOGI("Buffer ring:  {} KB, {:.2f} ms, {:.1f} M allocations/s", ring.memory_size / 1024, ring.milliseconds, static_cast<double>(allocation_count) / ring.milliseconds / 1000.0);
+	LOGI("Memory ratio: {:.2f}x", static_cast<double>(pools.memory_size) / static_cast<double>(ring.memory_size));
+
+	return 0;
+}
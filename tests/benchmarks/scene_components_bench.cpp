@@ -0,0 +1,99 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/logging.h"
+#include "scene_graph/components/mesh.h"
+#include "scene_graph/scene.h"
+#include "timer.h"
+
+namespace
+{
+constexpr size_t COMPONENT_COUNT = 100000;
+
+constexpr size_t ITERATION_COUNT = 100;
+
+/**
+ * @brief What get_components<T>() did before the typed views: a new vector filled with dynamic_casts
+ */
+std::vector<vkb::sg::Mesh *> copy_components(const vkb::sg::Scene &scene)
+{
+	auto &scene_components = scene.get_components(typeid(vkb::sg::Mesh));
+
+	std::vector<vkb::sg::Mesh *> result(scene_components.size());
+	std::transform(scene_components.begin(), scene_components.end(), result.begin(),
+	               [](const std::unique_ptr<vkb::sg::Component> &component) -> vkb::sg::Mesh * {
+		               return dynamic_cast<vkb::sg::Mesh *>(component.get());
+	               });
+	return result;
+}
+
+template <typename GetComponentsFunc>
+double run(const vkb::sg::Scene &scene, GetComponentsFunc get_components, size_t &checksum)
+{
+	vkb::Timer timer;
+	timer.start();
+
+	for (size_t i = 0; i < ITERATION_COUNT; ++i)
+	{
+		for (auto mesh : get_components(scene))
+		{
+			checksum += mesh->get_submeshes().size() + 1;
+		}
+	}
+
+	return timer.stop<vkb::Timer::Milliseconds>() / static_cast<double>(ITERATION_COUNT);
+}
+}        // namespace
+
+/**
+ * @brief Iterates over the meshes of a scene holding 100k of them, once through the typed view
+ *        returned by Scene::get_components<T>() and once through a copy cast per call
+ */
+int main()
+{
+	vkb::sg::Scene scene{"scene_components_bench"};
+
+	vkb::Timer timer;
+	timer.start();
+
+	for (size_t i = 0; i < COMPONENT_COUNT; ++i)
+	{
+		scene.add_component(std::make_unique<vkb::sg::Mesh>("mesh_" + std::to_string(i)));
+	}
+
+	auto add_time = timer.stop<vkb::Timer::Milliseconds>();
+
+	// Keeps the loops from being optimized out
+	size_t checksum = 0;
+
+	auto view_time = run(scene, [](const vkb::sg::Scene &source) -> const std::vector<vkb::sg::Mesh *> & { return source.get_components<vkb::sg::Mesh>(); }, checksum);
+	auto copy_time = run(scene, copy_components, checksum);
+
+	LOGI("{} components added in {:.2f} ms, {} iterations (checksum {})", COMPONENT_COUNT, add_time, ITERATION_COUNT, checksum);
+	LOGI("Typed view:    {:.3f} ms per iteration", view_time);
+	LOGI("Copy and cast: {:.3f} ms per iteration", copy_time);
+
+	return 0;
+}
@@ -20,11 +20,19 @@
 
 #include "vulkan_test.h"
 
+#include <algorithm>
+#include <fstream>
+
+#include <json.hpp>
+
+#include "core/null_driver.h"
 #include "gltf_loader.h"
 #include "gui.h"
+#include "platform/filesystem.h"
 #include "platform/platform.h"
 #include "rendering/subpasses/scene_subpass.h"
 #include "stats.h"
+#include "timer.h"
 #if defined(VK_USE_PLATFORM_ANDROID_KHR)
 #	include "platform/android/android_platform.h"
 #endif
@@ -45,16 +53,81 @@ bool VulkanTest::prepare(vkb::Platform &platform)
 
 void VulkanTest::update(float delta_time)
 {
+	vkb::Timer timer;
+	timer.start();
+
 	VulkanSample::update(delta_time);
 
-	screenshot(get_render_context(), get_name());
+	frame_times.push_back(static_cast<float>(timer.stop<vkb::Timer::Milliseconds>()));
 
-	end();
+	if (frame_times.size() == 1 && uses_null_driver())
+	{
+		first_frame_call_count = vkb::null_driver::get_total_call_count();
+	}
+
+	// In benchmark mode the platform stops the test after the requested number of frames
+	if (!is_benchmark_mode())
+	{
+		end();
+	}
+}
+
+void VulkanTest::finish()
+{
+	VulkanSample::finish();
+
+	write_report();
+
+	screenshot(get_render_context(), get_name());
 }
 
 void VulkanTest::end()
 {
+	finish();
+
 	platform->close();
 	exit(0);
 }
+
+void VulkanTest::write_report()
+{
+	if (frame_times.empty())
+	{
+		return;
+	}
+
+	// The first frame loads the pipelines, the median ignores it
+	auto sorted_frame_times = frame_times;
+	std::sort(sorted_frame_times.begin(), sorted_frame_times.end());
+
+	auto &cache_state = get_device().get_resource_cache().get_internal_state();
+
+	nlohmann::json report;
+
+	report["frame_count"] = frame_times.size();
+
+	report["frame_time_ms"] = {
+	    {"median", sorted_frame_times[sorted_frame_times.size() / 2]},
+	    {"p95", sorted_frame_times[sorted_frame_times.size() * 95 / 100]},
+	    {"max", sorted_frame_times.back()}};
+
+	report["counters"] = {
+	    {"shader_modules", cache_state.shader_modules.size()},
+	    {"graphics_pipelines", cache_state.graphics_pipelines.size()},
+	    {"buffer_memory_kb", get_render_context().get_buffer_memory_size() / 1024}};
+
+	const auto &bandwidth = get_render_context().get_last_rendered_frame().get_attachment_bandwidth();
+
+	report["counters"]["attachment_load_kb"]  = bandwidth.load_bytes / 1024;
+	report["counters"]["attachment_store_kb"] = bandwidth.store_bytes / 1024;
+
+	if (uses_null_driver() && frame_times.size() > 1)
+	{
+		report["counters"]["vulkan_calls_per_frame"] = (vkb::null_driver::get_total_call_count() - first_frame_call_count) / (frame_times.size() - 1);
+	}
+
+	std::ofstream report_file{vkb::fs::path::get(vkb::fs::path::Type::Screenshots) + get_name() + ".json"};
+
+	report_file << report.dump(4);
+}
 }        // namespace vkbtest
@@ -37,9 +37,27 @@ class VulkanTest : public vkb::VulkanSample
 
 	virtual void update(float delta_time) override;
 
+	/**
+	 * @brief Takes the screenshot of the test and writes its report
+	 */
+	virtual void finish() override;
+
 	virtual void end();
 
+  protected:
+	/**
+	 * @brief Writes the frame times and counters of the test next to its screenshot,
+	 *        so that the test runner can compare them with a baseline
+	 */
+	virtual void write_report();
+
   private:
 	vkb::Platform *platform;
+
+	/// CPU time of every frame in milliseconds
+	std::vector<float> frame_times;
+
+	/// Number of Vulkan calls made until the end of the first frame, when the null driver is used
+	uint64_t first_frame_call_count{0};
 };
 }        // namespace vkbtest
@@ -0,0 +1,161 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "image_compare.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define VKB_IMAGE_COMPARE_SSE2
+#	include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define VKB_IMAGE_COMPARE_NEON
+#	include <arm_neon.h>
+#endif
+
+namespace vkbtest
+{
+double ImageError::get_color_error() const
+{
+	return (mean[0] + mean[1] + mean[2]) / 3.0;
+}
+
+ImageError compare_images(const uint8_t *a, const uint8_t *b, size_t pixel_count, uint8_t *diff)
+{
+	std::array<uint64_t, 4> sums{};
+
+	ImageError error;
+
+	size_t i = 0;
+
+#if defined(VKB_IMAGE_COMPARE_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+
+	// Each mask keeps one channel of the four pixels of a vector
+	const __m128i masks[4] = {_mm_set1_epi32(0x000000FF), _mm_set1_epi32(0x0000FF00), _mm_set1_epi32(0x00FF0000), _mm_set1_epi32(static_cast<int>(0xFF000000))};
+
+	__m128i channel_sums[4] = {zero, zero, zero, zero};
+	__m128i max_diff        = zero;
+
+	for (; i + 4 <= pixel_count; i += 4)
+	{
+		__m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i * 4));
+		__m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i * 4));
+
+		// Unsigned saturation makes one of the differences zero
+		__m128i abs_diff = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+
+		if (diff)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(diff + i * 4), abs_diff);
+		}
+
+		max_diff = _mm_max_epu8(max_diff, abs_diff);
+
+		// The sum of absolute differences with zero adds up the bytes of each half into a 64-bit lane
+		for (size_t c = 0; c < 4; ++c)
+		{
+			channel_sums[c] = _mm_add_epi64(channel_sums[c], _mm_sad_epu8(_mm_and_si128(abs_diff, masks[c]), zero));
+		}
+	}
+
+	for (size_t c = 0; c < 4; ++c)
+	{
+		uint64_t lanes[2];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), channel_sums[c]);
+
+		sums[c] = lanes[0] + lanes[1];
+	}
+
+	uint8_t max_bytes[16];
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(max_bytes), max_diff);
+
+	for (size_t j = 0; j < 16; ++j)
+	{
+		error.max[j % 4] = std::max(error.max[j % 4], max_bytes[j]);
+	}
+#elif defined(VKB_IMAGE_COMPARE_NEON)
+	uint64x2_t channel_sums[4] = {vdupq_n_u64(0), vdupq_n_u64(0), vdupq_n_u64(0), vdupq_n_u64(0)};
+	uint8x16_t max_diff[4]     = {vdupq_n_u8(0), vdupq_n_u8(0), vdupq_n_u8(0), vdupq_n_u8(0)};
+
+	for (; i + 16 <= pixel_count; i += 16)
+	{
+		// Loads sixteen pixels with their channels deinterleaved
+		uint8x16x4_t va = vld4q_u8(a + i * 4);
+		uint8x16x4_t vb = vld4q_u8(b + i * 4);
+
+		uint8x16x4_t abs_diff;
+
+		for (size_t c = 0; c < 4; ++c)
+		{
+			abs_diff.val[c] = vabdq_u8(va.val[c], vb.val[c]);
+
+			max_diff[c] = vmaxq_u8(max_diff[c], abs_diff.val[c]);
+
+			channel_sums[c] = vpadalq_u32(channel_sums[c], vpaddlq_u16(vpaddlq_u8(abs_diff.val[c])));
+		}
+
+		if (diff)
+		{
+			vst4q_u8(diff + i * 4, abs_diff);
+		}
+	}
+
+	for (size_t c = 0; c < 4; ++c)
+	{
+		sums[c] = vgetq_lane_u64(channel_sums[c], 0) + vgetq_lane_u64(channel_sums[c], 1);
+
+		uint8_t max_bytes[16];
+		vst1q_u8(max_bytes, max_diff[c]);
+
+		error.max[c] = *std::max_element(max_bytes, max_bytes + 16);
+	}
+#endif
+
+	// Remaining pixels, or all of them without SIMD support
+	for (; i < pixel_count; ++i)
+	{
+		for (size_t c = 0; c < 4; ++c)
+		{
+			uint8_t x        = a[i * 4 + c];
+			uint8_t y        = b[i * 4 + c];
+			uint8_t abs_diff = x > y ? x - y : y - x;
+
+			if (diff)
+			{
+				diff[i * 4 + c] = abs_diff;
+			}
+
+			sums[c] += abs_diff;
+			error.max[c] = std::max(error.max[c], abs_diff);
+		}
+	}
+
+	if (pixel_count > 0)
+	{
+		for (size_t c = 0; c < 4; ++c)
+		{
+			error.mean[c] = static_cast<double>(sums[c]) / (255.0 * pixel_count);
+		}
+	}
+
+	return error;
+}
+}        // namespace vkbtest
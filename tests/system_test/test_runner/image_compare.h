@@ -0,0 +1,55 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace vkbtest
+{
+/**
+ * @brief Per-channel error between two RGBA8 images
+ */
+struct ImageError
+{
+	/// Mean absolute error of each channel, between 0 and 1
+	std::array<double, 4> mean{};
+
+	/// Largest absolute difference of each channel
+	std::array<uint8_t, 4> max{};
+
+	/**
+	 * @return The mean absolute error of the color channels, between 0 and 1
+	 */
+	double get_color_error() const;
+};
+
+/**
+ * @brief Compares two RGBA8 images of the same size, using SSE2 or NEON when available
+ * @param a Pixels of the first image
+ * @param b Pixels of the second image
+ * @param pixel_count Number of pixels of each image
+ * @param diff Optional destination of the absolute difference of every channel, of the same size as the images
+ * @return The error between the images
+ */
+ImageError compare_images(const uint8_t *a, const uint8_t *b, size_t pixel_count, uint8_t *diff = nullptr);
+}        // namespace vkbtest
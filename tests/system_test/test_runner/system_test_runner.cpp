@@ -0,0 +1,249 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <docopt.h>
+#include <json.hpp>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include "image_compare.h"
+
+namespace
+{
+const char USAGE[] =
+    R"(System test runner.
+	Usage:
+		system_test_runner --app <path> --test <arg> --gold <dir> --baselines <dir> [--icd <path>] [--frames <count>] [--threshold <value>] [--tolerance <value>] [--record-baseline]
+		system_test_runner --help
+
+	Options:
+		--help                    Show this screen.
+		--app PATH                Path of the vulkan_best_practice executable.
+		--test TEST_ID            The test to run.
+		--gold DIR                Directory of the gold images.
+		--baselines DIR           Directory of the performance baselines.
+		--icd PATH                Vulkan ICD manifest to run the test with, such as the one of a software implementation.
+		--frames COUNT            Number of frames rendered before the screenshot is taken [default: 60].
+		--threshold VALUE         Minimum similarity of the screenshot with the gold image [default: 0.999].
+		--tolerance VALUE         Allowed increase of the median frame time over the baseline [default: 0.25].
+		--record-baseline         Records the results of this run as the baseline, replacing any existing one.
+	)";
+
+// Relative to the working directory, the root of the project
+const std::string OUTPUT_PATH = "output/images/";
+
+using StbImage = std::unique_ptr<stbi_uc, decltype(&stbi_image_free)>;
+
+void set_environment_variable(const std::string &name, const std::string &value)
+{
+#if defined(_WIN32)
+	_putenv_s(name.c_str(), value.c_str());
+#else
+	setenv(name.c_str(), value.c_str(), 1);
+#endif
+}
+
+/**
+ * @brief Compares the screenshot of a test with the gold image of its resolution,
+ *        writing the difference next to the screenshot if they are not similar enough
+ */
+bool check_screenshot(const std::string &test_id, const std::string &gold_dir, double threshold)
+{
+	auto screenshot_path = OUTPUT_PATH + test_id + ".png";
+
+	int width{0}, height{0}, components{0};
+
+	StbImage screenshot{stbi_load(screenshot_path.c_str(), &width, &height, &components, 4), stbi_image_free};
+	if (!screenshot)
+	{
+		std::cerr << "Couldn't find screenshot (" << screenshot_path << "), perhaps the test crashed" << std::endl;
+		return false;
+	}
+
+	auto gold_path = gold_dir + "/" + test_id + "/" + std::to_string(width) + "x" + std::to_string(height) + ".png";
+
+	int gold_width{0}, gold_height{0};
+
+	StbImage gold{stbi_load(gold_path.c_str(), &gold_width, &gold_height, &components, 4), stbi_image_free};
+	if (!gold || gold_width != width || gold_height != height)
+	{
+		std::cerr << "Resolution not supported, gold image not found (" << gold_path << ")" << std::endl;
+		return false;
+	}
+
+	size_t pixel_count = static_cast<size_t>(width) * height;
+
+	std::vector<uint8_t> diff(pixel_count * 4);
+
+	auto error = vkbtest::compare_images(screenshot.get(), gold.get(), pixel_count, diff.data());
+
+	auto similarity = 1.0 - error.get_color_error();
+
+	std::cout << "Similarity with " << gold_path << ": " << similarity * 100.0 << "%" << std::endl;
+	std::cout << "Mean error per channel (RGBA): " << error.mean[0] << " " << error.mean[1] << " " << error.mean[2] << " " << error.mean[3] << std::endl;
+	std::cout << "Max error per channel (RGBA): " << +error.max[0] << " " << +error.max[1] << " " << +error.max[2] << " " << +error.max[3] << std::endl;
+
+	if (similarity >= threshold)
+	{
+		return true;
+	}
+
+	// Opaque alpha, so that the difference of the color channels is visible
+	for (size_t i = 0; i < pixel_count; ++i)
+	{
+		diff[i * 4 + 3] = 255;
+	}
+
+	auto diff_path = OUTPUT_PATH + test_id + "-diff.png";
+	stbi_write_png(diff_path.c_str(), width, height, 4, diff.data(), width * 4);
+
+	std::cerr << "Screenshot differs from the gold image, difference written to " << diff_path << std::endl;
+
+	return false;
+}
+
+/**
+ * @brief Compares the report of a test with its baseline, a missing baseline is a failure unless it is recorded
+ */
+bool check_performance(const std::string &test_id, const std::string &baselines_dir, double tolerance, bool record_baseline)
+{
+	auto report_path = OUTPUT_PATH + test_id + ".json";
+
+	std::ifstream report_file{report_path};
+	if (!report_file)
+	{
+		std::cerr << "Couldn't find report (" << report_path << "), perhaps the test crashed" << std::endl;
+		return false;
+	}
+
+	auto report = nlohmann::json::parse(report_file);
+
+	auto baseline_path = baselines_dir + "/" + test_id + ".json";
+
+	if (record_baseline)
+	{
+		std::ofstream new_baseline_file{baseline_path};
+		if (!new_baseline_file)
+		{
+			std::cerr << "Couldn't write baseline (" << baseline_path << ")" << std::endl;
+			return false;
+		}
+
+		new_baseline_file << report.dump(4);
+
+		std::cout << "Baseline recorded (" << baseline_path << ")" << std::endl;
+		return true;
+	}
+
+	std::ifstream baseline_file{baseline_path};
+	if (!baseline_file)
+	{
+		std::cerr << "Couldn't find baseline (" << baseline_path << "), run with --record-baseline to record it" << std::endl;
+		return false;
+	}
+
+	auto baseline = nlohmann::json::parse(baseline_file);
+
+	bool passed = true;
+
+	double frame_time          = report["frame_time_ms"]["median"];
+	double baseline_frame_time = baseline["frame_time_ms"]["median"];
+
+	std::cout << "Median frame time: " << frame_time << " ms (baseline " << baseline_frame_time << " ms)" << std::endl;
+
+	if (frame_time > baseline_frame_time * (1.0 + tolerance))
+	{
+		std::cerr << "Frame time regression: " << frame_time << " ms exceeds the baseline by more than " << tolerance * 100.0 << "%" << std::endl;
+		passed = false;
+	}
+
+	// Counters are deterministic, any increase is a regression
+	auto &counters = report["counters"];
+
+	for (auto it = baseline["counters"].begin(); it != baseline["counters"].end(); ++it)
+	{
+		if (counters.find(it.key()) == counters.end())
+		{
+			continue;
+		}
+
+		double value          = counters[it.key()];
+		double baseline_value = it.value();
+
+		if (value > baseline_value)
+		{
+			std::cerr << "Counter regression: " << it.key() << " is " << value << " (baseline " << baseline_value << ")" << std::endl;
+			passed = false;
+		}
+		else if (value < baseline_value)
+		{
+			std::cout << "Counter improvement: " << it.key() << " is " << value << " (baseline " << baseline_value << "), consider updating the baseline" << std::endl;
+		}
+	}
+
+	return passed;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	auto args = docopt::docopt(USAGE, {argv + 1, argv + argc}, true);
+
+	auto test_id = args["--test"].asString();
+
+	// Results of a previous run must not be mistaken for the ones of this run
+	std::remove((OUTPUT_PATH + test_id + ".png").c_str());
+	std::remove((OUTPUT_PATH + test_id + ".json").c_str());
+	std::remove((OUTPUT_PATH + test_id + "-diff.png").c_str());
+
+	if (args["--icd"])
+	{
+		set_environment_variable("VK_ICD_FILENAMES", args["--icd"].asString());
+	}
+
+	auto command = "\"" + args["--app"].asString() + "\" --test " + test_id + " --headless --benchmark " + args["--frames"].asString();
+
+	std::cout << "Running " << command << std::endl;
+
+	if (std::system(command.c_str()) != 0)
+	{
+		std::cerr << "Test " << test_id << " failed to run" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	bool passed = check_screenshot(test_id, args["--gold"].asString(), std::stod(args["--threshold"].asString()));
+
+	passed = check_performance(test_id, args["--baselines"].asString(), std::stod(args["--tolerance"].asString()), args["--record-baseline"].asBool()) && passed;
+
+	std::cout << "Test " << test_id << (passed ? " passed" : " failed") << std::endl;
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
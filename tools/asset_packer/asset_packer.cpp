@@ -0,0 +1,311 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#	include <Windows.h>
+#else
+#	include <dirent.h>
+#	include <sys/stat.h>
+#endif
+
+#include <docopt.h>
+
+#include "asset_pack_format.h"
+
+namespace
+{
+const char USAGE[] =
+    R"(Asset packer.
+	Usage:
+		asset_packer <pack> <directory>... [--no-compression]
+		asset_packer --help
+
+	Options:
+		--help                    Show this screen.
+		--no-compression          Store every file uncompressed.
+
+	Files are named after the directory they are found in, "assets/fonts/Roboto-Regular.ttf"
+	for the font found in the assets directory, so that the pack can replace the directories.
+	)";
+
+using namespace vkb::pack;
+
+/**
+ * @brief A file to be added to the pack
+ */
+struct File
+{
+	std::string name;
+
+	std::string path;
+
+	PackEntry entry;
+
+	std::vector<uint8_t> data;
+};
+
+/**
+ * @brief An entry of a directory
+ */
+struct DirectoryEntry
+{
+	std::string name;
+
+	bool is_directory{false};
+};
+
+std::vector<DirectoryEntry> read_directory(const std::string &directory)
+{
+	std::vector<DirectoryEntry> entries;
+
+#if defined(_WIN32)
+	WIN32_FIND_DATAA find_data;
+
+	auto find_handle = FindFirstFileA((directory + "/*").c_str(), &find_data);
+	if (find_handle == INVALID_HANDLE_VALUE)
+	{
+		return entries;
+	}
+
+	do
+	{
+		entries.push_back({find_data.cFileName, (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0});
+	} while (FindNextFileA(find_handle, &find_data));
+
+	FindClose(find_handle);
+#else
+	auto dir = opendir(directory.c_str());
+	if (!dir)
+	{
+		return entries;
+	}
+
+	while (auto dir_entry = readdir(dir))
+	{
+		// Symbolic links are followed, as the assets directory of a build is often one
+		struct stat info;
+		if (stat((directory + "/" + dir_entry->d_name).c_str(), &info) == 0)
+		{
+			entries.push_back({dir_entry->d_name, S_ISDIR(info.st_mode)});
+		}
+	}
+
+	closedir(dir);
+#endif
+
+	return entries;
+}
+
+/**
+ * @brief Appends the files found in a directory and its subdirectories
+ */
+void list_files(const std::string &directory, const std::string &name_prefix, std::vector<File> &files)
+{
+	for (auto &entry : read_directory(directory))
+	{
+		if (entry.name == "." || entry.name == "..")
+		{
+			continue;
+		}
+
+		if (entry.is_directory)
+		{
+			list_files(directory + "/" + entry.name, name_prefix + entry.name + "/", files);
+		}
+		else
+		{
+			File file;
+			file.name = name_prefix + entry.name;
+			file.path = directory + "/" + entry.name;
+			files.push_back(std::move(file));
+		}
+	}
+}
+
+bool read_file(File &file)
+{
+	std::ifstream input{file.path, std::ios::binary};
+	if (!input)
+	{
+		return false;
+	}
+
+	file.data.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+
+	return true;
+}
+
+/**
+ * @brief Compresses the data of a file, when it saves enough space to be worth decoding it
+ */
+void compress_file(File &file)
+{
+	file.entry.size        = file.data.size();
+	file.entry.stored_size = file.data.size();
+	file.entry.compression = None;
+
+	auto compressed = lz::compress(file.data.data(), file.data.size());
+
+	// Uncompressed files are copied straight from the mapping, keep them unless an eighth is saved
+	if (compressed.size() < file.data.size() - file.data.size() / 8)
+	{
+		file.entry.stored_size = compressed.size();
+		file.entry.compression = LZ;
+		file.data              = std::move(compressed);
+	}
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	auto args = docopt::docopt(USAGE, {argv + 1, argv + argc}, true);
+
+	auto pack_path   = args["<pack>"].asString();
+	auto compression = !args["--no-compression"].asBool();
+
+	std::vector<File> files;
+
+	for (auto directory : args["<directory>"].asStringList())
+	{
+		while (directory.size() > 1 && (directory.back() == '/' || directory.back() == '\\'))
+		{
+			directory.pop_back();
+		}
+
+		auto separator = directory.find_last_of("/\\");
+		auto name      = separator == std::string::npos ? directory : directory.substr(separator + 1);
+
+		auto file_count = files.size();
+
+		list_files(directory, name + "/", files);
+
+		if (files.size() == file_count)
+		{
+			std::cerr << "No files found in " << directory << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	for (auto &file : files)
+	{
+		file.entry.hash = hash_name(file.name);
+	}
+
+	std::sort(files.begin(), files.end(), [](const File &a, const File &b) { return a.entry.hash < b.entry.hash; });
+
+	// Names are not compared when the hashes differ, so two files cannot share a hash
+	for (size_t i = 1; i < files.size(); ++i)
+	{
+		if (files[i - 1].entry.hash == files[i].entry.hash)
+		{
+			std::cerr << "Files " << files[i - 1].name << " and " << files[i].name << " have the same hash" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	PackHeader header;
+	header.entry_count = static_cast<uint32_t>(files.size());
+
+	for (auto &file : files)
+	{
+		file.entry.name_offset = header.names_size;
+		file.entry.name_size   = static_cast<uint32_t>(file.name.size());
+		header.names_size += file.entry.name_size;
+	}
+
+	std::ofstream pack{pack_path, std::ios::binary | std::ios::trunc};
+	if (!pack)
+	{
+		std::cerr << "Couldn't open " << pack_path << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Entries are written once their data is, when their offset and stored size are known
+	uint64_t offset = sizeof(PackHeader) + files.size() * sizeof(PackEntry) + header.names_size;
+
+	pack.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	pack.seekp(offset);
+
+	uint64_t total_size  = 0;
+	uint64_t stored_size = 0;
+
+	for (auto &file : files)
+	{
+		if (!read_file(file))
+		{
+			std::cerr << "Couldn't read " << file.path << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		if (compression)
+		{
+			compress_file(file);
+		}
+		else
+		{
+			file.entry.size        = file.data.size();
+			file.entry.stored_size = file.data.size();
+		}
+
+		// Each file starts at a page boundary, so that reading it maps no page of another file
+		auto aligned_offset = align_offset(offset);
+		std::fill_n(std::ostreambuf_iterator<char>(pack), aligned_offset - offset, '\0');
+
+		file.entry.offset = aligned_offset;
+		pack.write(reinterpret_cast<const char *>(file.data.data()), file.data.size());
+		offset = aligned_offset + file.data.size();
+
+		total_size += file.entry.size;
+		stored_size += file.entry.stored_size;
+
+		// Only the entry is kept, files are written one at a time
+		file.data = {};
+	}
+
+	pack.seekp(sizeof(PackHeader));
+
+	for (auto &file : files)
+	{
+		pack.write(reinterpret_cast<const char *>(&file.entry), sizeof(file.entry));
+	}
+
+	for (auto &file : files)
+	{
+		pack.write(file.name.data(), file.name.size());
+	}
+
+	if (!pack.flush())
+	{
+		std::cerr << "Couldn't write " << pack_path << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cerr << "Packed " << files.size() << " files, " << total_size << " bytes stored in " << stored_size << " bytes" << std::endl;
+
+	return EXIT_SUCCESS;
+}
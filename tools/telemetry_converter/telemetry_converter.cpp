@@ -0,0 +1,224 @@
+/* Copyright (c) 2019, Arm Limited and Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge,
+ * to any person obtaining a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <docopt.h>
+
+#include "telemetry_format.h"
+
+namespace
+{
+const char USAGE[] =
+    R"(Telemetry converter.
+	Usage:
+		telemetry_converter <log> [--output <path>] [--format <format>]
+		telemetry_converter --help
+
+	Options:
+		--help                    Show this screen.
+		--output PATH             File to write, the standard output if not specified.
+		--format FORMAT           Output format, csv or json [default: csv].
+	)";
+
+using namespace vkb::telemetry;
+
+/**
+ * @brief Content of a record, read from the log one at a time
+ */
+struct Row
+{
+	TelemetryRecord record;
+
+	std::vector<float> values;
+};
+
+bool read_record(std::istream &log, Row &row)
+{
+	if (!log.read(reinterpret_cast<char *>(&row.record), sizeof(row.record)))
+	{
+		return false;
+	}
+
+	return static_cast<bool>(log.read(reinterpret_cast<char *>(row.values.data()), row.values.size() * sizeof(float)));
+}
+
+void write_value(std::ostream &output, float value, bool json)
+{
+	// JSON has no representation of infinities and NaNs
+	if (json && !std::isfinite(value))
+	{
+		output << "null";
+	}
+	else
+	{
+		output << value;
+	}
+}
+
+/**
+ * @brief Writes the records left in the log, returns the number of records written
+ */
+uint64_t convert(std::istream &log, const std::vector<std::string> &names, std::ostream &output, bool json)
+{
+	Row row;
+	row.values.resize(names.size());
+
+	uint64_t record_count = 0;
+
+	if (json)
+	{
+		output << "{\"stats\":[";
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			output << (i > 0 ? "," : "") << "\"" << names[i] << "\"";
+		}
+		output << "],\"records\":[";
+	}
+	else
+	{
+		output << "frame_index,timestamp_us,delta_time";
+		for (auto &name : names)
+		{
+			output << "," << name;
+		}
+		output << "\n";
+	}
+
+	while (read_record(log, row))
+	{
+		if (json)
+		{
+			output << (record_count > 0 ? ",\n" : "\n") << "{\"frame_index\":" << row.record.frame_index
+			       << ",\"timestamp_us\":" << row.record.timestamp << ",\"delta_time\":";
+			write_value(output, row.record.delta_time, json);
+			output << ",\"values\":[";
+			for (size_t i = 0; i < row.values.size(); ++i)
+			{
+				output << (i > 0 ? "," : "");
+				write_value(output, row.values[i], json);
+			}
+			output << "]}";
+		}
+		else
+		{
+			output << row.record.frame_index << "," << row.record.timestamp << ",";
+			write_value(output, row.record.delta_time, json);
+			for (auto value : row.values)
+			{
+				output << ",";
+				write_value(output, value, json);
+			}
+			output << "\n";
+		}
+
+		++record_count;
+	}
+
+	if (json)
+	{
+		output << "\n]}\n";
+	}
+
+	// A log cut short by a crash ends with a partial record
+	if (log.gcount() != 0)
+	{
+		std::cerr << "Ignoring a truncated record at the end of the log" << std::endl;
+	}
+
+	return record_count;
+}
+}        // namespace
+
+int main(int argc, char *argv[])
+{
+	auto args = docopt::docopt(USAGE, {argv + 1, argv + argc}, true);
+
+	auto log_path = args["<log>"].asString();
+	auto format   = args["--format"].asString();
+
+	if (format != "csv" && format != "json")
+	{
+		std::cerr << "Unknown format " << format << ", expected csv or json" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream log{log_path, std::ios::binary};
+	if (!log)
+	{
+		std::cerr << "Couldn't open " << log_path << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	TelemetryHeader header;
+	if (!log.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.magic != MAGIC)
+	{
+		std::cerr << log_path << " is not a telemetry log" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (header.version != VERSION || header.record_size != get_record_size(header.stat_count))
+	{
+		std::cerr << "Unsupported telemetry log version " << header.version << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::string> names;
+	for (uint32_t i = 0; i < header.stat_count; ++i)
+	{
+		TelemetryStat stat;
+		if (!log.read(reinterpret_cast<char *>(&stat), sizeof(stat)))
+		{
+			std::cerr << "Truncated telemetry log header" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		names.emplace_back(stat.name, strnlen(stat.name, STAT_NAME_SIZE));
+	}
+
+	std::ofstream output_file;
+	if (args["--output"])
+	{
+		output_file.open(args["--output"].asString());
+		if (!output_file)
+		{
+			std::cerr << "Couldn't open " << args["--output"].asString() << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	auto &output = output_file.is_open() ? static_cast<std::ostream &>(output_file) : std::cout;
+
+	// Enough digits to read the floats back exactly
+	output.precision(std::numeric_limits<float>::max_digits10);
+
+	auto record_count = convert(log, names, output, format == "json");
+
+	std::cerr << "Converted " << record_count << " records of " << names.size() << " stats" << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -20,6 +20,9 @@
 
 #include "vulkan_best_practice.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "common/logging.h"
 #include "platform/platform.h"
 
@@ -85,6 +88,52 @@ inline std::vector<SampleInfo>::const_iterator get_sample_info(const std::string
 	                    [&sample_id](const SampleInfo &sample) { return sample.id == sample_id; });
 }
 
+/**
+ * @brief Reads the settings of the encoding of images to ASTC from the --astc and --astc-preset options
+ * @return False if the options are not valid
+ */
+inline bool parse_astc_settings(const Options &options, sg::AstcEncodeSettings &settings)
+{
+	static const std::unordered_map<std::string, sg::AstcPreset> presets = {{"veryfast", sg::AstcPreset::VeryFast},
+	                                                                        {"fast", sg::AstcPreset::Fast},
+	                                                                        {"medium", sg::AstcPreset::Medium},
+	                                                                        {"thorough", sg::AstcPreset::Thorough},
+	                                                                        {"exhaustive", sg::AstcPreset::Exhaustive}};
+
+	auto block = options.get_string("--astc");
+	auto x     = block.find('x');
+
+	unsigned int block_x = 0;
+	unsigned int block_y = 0;
+	if (x != std::string::npos)
+	{
+		block_x = static_cast<unsigned int>(std::strtoul(block.substr(0, x).c_str(), nullptr, 10));
+		block_y = static_cast<unsigned int>(std::strtoul(block.substr(x + 1).c_str(), nullptr, 10));
+	}
+
+	settings.blockdim = {static_cast<uint8_t>(block_x), static_cast<uint8_t>(block_y), 1};
+
+	if (block_x > 12 || block_y > 12 || sg::to_astc_format(settings.blockdim) == VK_FORMAT_UNDEFINED)
+	{
+		LOGE("Invalid ASTC block size {}, expected one such as 4x4, 6x6 or 8x8", block);
+		return false;
+	}
+
+	if (options.contains("--astc-preset"))
+	{
+		auto preset = presets.find(options.get_string("--astc-preset"));
+		if (preset == presets.end())
+		{
+			LOGE("Invalid ASTC preset {}, expected veryfast, fast, medium, thorough or exhaustive", options.get_string("--astc-preset"));
+			return false;
+		}
+
+		settings.preset = preset->second;
+	}
+
+	return true;
+}
+
 inline const CreateAppFunc &get_create_func(const std::string &id)
 {
 	// Try to find the sample entry point
@@ -113,7 +162,7 @@ VulkanBestPractice::VulkanBestPractice()
 	    R"(Vulkan Best Practice.
 	Usage:
 		vulkan_best_practice <sample>
-		vulkan_best_practice (--sample <arg> | --test <arg> | --batch <arg>) [--benchmark <frames>] [--width <arg>] [--height <arg>] [--headless] 
+		vulkan_best_practice (--sample <arg> | --test <arg> | --batch <arg>) [--benchmark <frames>] [--width <arg>] [--height <arg>] [--headless] [--null-driver] [--pipelined] [--instrumentation] [--telemetry <file>] [--pack <file>] [--astc <block> [--astc-preset <preset>]] [--texture-arrays] [--gpu-mipmaps] [--buffer-ring <kb>]
 		vulkan_best_practice --help
 
 	Options:
@@ -125,6 +174,16 @@ VulkanBestPractice::VulkanBestPractice()
 		--width WIDTH             The width of the screen if visible [default: 1280].
 		--height HEIGHT           The height of the screen if visible [default: 720].
 		--headless                Renders directly to display, skipping window creation.
+		--null-driver             Runs without a GPU, with --headless, to measure the CPU overhead of the framework.
+		--pipelined               Updates the scene of the next frame while recording the current one.
+		--instrumentation         Queries pipeline statistics of each subpass and shows the overdraw histogram.
+		--telemetry FILE          Records the stats of every frame to a binary log in output/logs, see tools/telemetry_converter.
+		--pack FILE               Reads assets and shaders from a pack built by tools/asset_packer, vkb.pack if it exists otherwise.
+		--astc BLOCK              Encodes PNG and JPG textures to ASTC with blocks of this size, such as 6x6, caching them in temporary storage.
+		--astc-preset PRESET      Trade-off between quality and encoding time: veryfast, fast, medium, thorough or exhaustive [default: fast].
+		--texture-arrays          Packs textures with the same format and size into texture arrays.
+		--gpu-mipmaps             Generates the mipmaps of textures without any with compute shaders.
+		--buffer-ring KB          Allocates transient buffers from a single ring of this size in kilobytes instead of per-frame pools.
 	)");
 }
 
@@ -241,6 +300,35 @@ bool VulkanBestPractice::prepare_active_app(CreateAppFunc create_app_func, const
 		if (auto *active_app = dynamic_cast<vkb::VulkanSample *>(app))
 		{
 			active_app->get_configuration().reset();
+
+			active_app->set_frame_pipelining(options.contains("--pipelined"));
+
+			active_app->set_instrumentation(options.contains("--instrumentation"));
+
+			if (options.contains("--telemetry"))
+			{
+				active_app->set_telemetry(options.get_string("--telemetry"));
+			}
+
+			if (options.contains("--astc"))
+			{
+				sg::AstcEncodeSettings astc_settings;
+				if (!parse_astc_settings(options, astc_settings))
+				{
+					return false;
+				}
+
+				active_app->set_astc_encoding(true, astc_settings);
+			}
+
+			active_app->set_texture_arrays(options.contains("--texture-arrays"));
+
+			active_app->set_gpu_mipmaps(options.contains("--gpu-mipmaps"));
+
+			if (options.contains("--buffer-ring"))
+			{
+				active_app->set_buffer_ring_size(static_cast<VkDeviceSize>(std::max(options.get_int("--buffer-ring"), 0)) * 1024);
+			}
 		}
 	}
 
@@ -254,6 +342,7 @@ bool VulkanBestPractice::prepare_active_app(CreateAppFunc create_app_func, const
 	}
 
 	active_app->set_headless(is_headless());
+	active_app->set_null_driver(uses_null_driver());
 
 	auto result = active_app->prepare(*platform);
 